@@ -0,0 +1,116 @@
+#ifndef CASCADE_H
+#define CASCADE_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "cogging.h"
+#include "filter.h"
+#include "foc.h"
+#include "mtpa.h"
+#include "pi.h"
+#include "traj.h"
+#include <stdint.h>
+
+/* 可注册的串级控制实例个数（静态对象池容量） */
+#ifndef CASCADE_INSTANCE_MAX
+#define CASCADE_INSTANCE_MAX 1
+#endif
+
+/* 1：用 DWT CYCCNT（主机构建时为 ns 计时，见 bsp_profile.h）统计各环执行时间；0：不统计 */
+#ifndef CASCADE_PROFILE
+#define CASCADE_PROFILE 1
+#endif
+
+/* 串级控制模式 */
+typedef enum {
+  CASCADE_CURRENT,  // 电流环（给定 Id、Iq）
+  CASCADE_SPEED,    // 速度环 + 电流环
+  CASCADE_POSITION, // 位置环 + 速度环 + 电流环
+} Cascade_Mode;
+
+/* 单个控制环的执行频率与耗时 */
+typedef struct {
+  uint16_t div;         // 相对 PWM 频率的分频系数
+  uint16_t phase;       // 在分频周期内执行的时刻（PWM 周期数），[0, div)
+  uint16_t count;       // 分频计数，[0, div)
+  uint32_t cycles_last; // 上次执行耗时（CPU 周期）
+  uint32_t cycles_max;  // 最大执行耗时（CPU 周期）
+} Cascade_Rate;
+
+/* 执行预算报告 */
+typedef struct {
+  float rate_current;       // 电流环频率（Hz）
+  float rate_speed;         // 速度环频率（Hz）
+  float rate_position;      // 位置环频率（Hz）
+  uint32_t cycles_period;   // 一个 PWM 周期的 CPU 周期数
+  uint32_t cycles_current;  // 电流环最大耗时（CPU 周期）
+  uint32_t cycles_speed;    // 速度环最大耗时（CPU 周期）
+  uint32_t cycles_position; // 位置环最大耗时（CPU 周期）
+  float load_worst; // 最坏情况下单个 PWM 周期的 CPU 占用率（外环互不重叠）
+} Cascade_Report;
+
+typedef struct {
+  FOC_Instance *foc;
+
+  uint16_t speed_div;   // 速度环分频系数，≥ 1
+  uint16_t speed_phase; // 速度环相位偏移，[0, speed_div)
+  uint16_t pos_div;     // 位置环分频系数，≥ 1
+  uint16_t pos_phase;   // 位置环相位偏移，[0, pos_div)
+
+  float speed_kp;    // 速度环比例增益（A / (rad/s)）
+  float speed_ki;    // 速度环积分增益（A / rad）
+  float iq_max;      // 速度环输出限幅（A）
+  float speed_alpha; // 速度测量一阶低通滤波系数，(0, 1]
+  float speed_range; // 测速满量程（rad/s），FMAC 空闲时 ±speed_range 映射到 q1.15，
+                     // 0 为只用 CPU 滤波
+  float pos_kp;      // 位置环比例增益（1/s）
+  float speed_max;   // 位置环输出限幅（rad/s）
+  float acc_gain;    // 加速度前馈增益（A / (rad/s^2)），转动惯量 / 转矩常数，0 不前馈
+} Cascade_Init_Config_s;
+
+typedef struct {
+  FOC_Instance *foc;
+  Cogging_Instance *cogging; // 齿槽转矩补偿，为 NULL 时不补偿
+  Traj_Instance *traj;       // 位置模式的轨迹规划，为 NULL 时位置目标直接阶跃
+  MTPA_Instance *mtpa;       // 速度、位置模式的转矩分配，为 NULL 时 Id 不变
+  Cascade_Mode mode;
+
+  Cascade_Rate loop_current;
+  Cascade_Rate loop_speed;
+  Cascade_Rate loop_position;
+
+  PI_Instance pi_speed;
+  Filter_Instance *speed_filter; // 测速低通滤波器
+  float pos_kp;
+  float speed_max;
+  float acc_gain;
+
+  float pos_ref;   // 位置目标（rad，机械角，多圈）
+  float speed_ref; // 速度目标（rad/s，机械角速度）
+  float id_ref;    // d 轴电流目标（A）
+  float iq_ref;    // q 轴电流目标（A）
+  float iq_ff;     // 由轨迹加速度得到的 Iq 前馈（A）
+
+  float angle_last; // 上一次的机械角度（rad）
+  float pos;        // 多圈机械角度（rad）
+  float pos_speed;  // 上次速度环执行时的多圈机械角度（rad）
+  float speed;      // 机械角速度（rad/s）
+  uint8_t angle_valid;
+} Cascade_Instance;
+
+Cascade_Instance *Cascade_Register(Cascade_Init_Config_s *config);
+void Cascade_SetMode(Cascade_Instance *instance, Cascade_Mode mode);
+void Cascade_SetCurrent(Cascade_Instance *instance, float id, float iq);
+void Cascade_SetSpeed(Cascade_Instance *instance, float speed);
+void Cascade_SetPosition(Cascade_Instance *instance, float pos);
+void Cascade_Update(Cascade_Instance *instance, float angle_mechanical,
+                    float angle_electrical);
+void Cascade_SetCogging(Cascade_Instance *instance, Cogging_Instance *cogging);
+void Cascade_SetTrajectory(Cascade_Instance *instance, Traj_Instance *traj);
+void Cascade_SetMTPA(Cascade_Instance *instance, MTPA_Instance *mtpa);
+void Cascade_GetReport(Cascade_Instance *instance, Cascade_Report *report);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,63 @@
+#ifndef COGGING_H
+#define COGGING_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <stdint.h>
+
+/* 可注册的齿槽转矩补偿实例个数（静态对象池容量） */
+#ifndef COGGING_INSTANCE_MAX
+#define COGGING_INSTANCE_MAX 1
+#endif
+
+/* 1：补偿表以 q15 定点存储（2 KB）；0：以 float 存储（4 KB） */
+#ifndef COGGING_Q15
+#define COGGING_Q15 1
+#endif
+
+/* 每圈机械角度的分段数，每个齿槽周期（2PI / lcm(槽数, 极数)）至少 8 段 */
+#ifndef COGGING_TABLE_SIZE
+#define COGGING_TABLE_SIZE 1024
+#endif
+
+typedef enum {
+  COGGING_IDLE,  // 未学习，按已有表前馈
+  COGGING_LEARN, // 迭代学习中
+  COGGING_DONE,  // 学习完成
+} Cogging_State;
+
+typedef struct {
+  float iq_max;     // 补偿表幅值上限（A），q15 存储时决定量化步长
+  float gain;       // 学习增益，(0, 1]，每次把速度环输出的波动分量按此比例计入表
+  float mean_alpha; // 速度环输出均值的一阶低通系数，(0, 1]
+} Cogging_Init_Config_s;
+
+/* 齿槽转矩补偿：按机械角度查表得到 Iq 前馈 */
+typedef struct {
+  Cogging_State state;
+  float iq_max;
+  float gain;
+  float mean_alpha;
+  float iq_mean;      // 速度环输出均值（A），摩擦等与位置无关的分量
+  float travel;       // 学习累计的机械角度（rad）
+  float travel_max;   // 学习总行程（rad）
+  float angle_last;   // 上次的机械角度（rad）
+#if COGGING_Q15
+  float scale;        // iq_max / 32767（A / LSB）
+  int16_t table[COGGING_TABLE_SIZE];
+#else
+  float table[COGGING_TABLE_SIZE];
+#endif
+} Cogging_Instance;
+
+Cogging_Instance *Cogging_Register(Cogging_Init_Config_s *config);
+void Cogging_StartLearn(Cogging_Instance *instance, uint16_t revolutions,
+                        float angle_mechanical);
+void Cogging_Learn(Cogging_Instance *instance, float angle_mechanical,
+                   float iq);
+float Cogging_Feedforward(Cogging_Instance *instance, float angle_mechanical);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
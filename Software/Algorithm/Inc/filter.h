@@ -0,0 +1,62 @@
+#ifndef FILTER_H
+#define FILTER_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <stdint.h>
+
+/* 可注册的滤波器实例个数（静态对象池容量） */
+#ifndef FILTER_INSTANCE_MAX
+#define FILTER_INSTANCE_MAX 4
+#endif
+
+#define FILTER_MAX_TAPS 16 // FIR 最大阶数 + 1
+
+/* 滤波器类型 */
+typedef enum {
+  FILTER_FIR,    // FIR，系数 b[0] ~ b[taps-1]
+  FILTER_BIQUAD, // 二阶 IIR，y = b0*x + b1*x1 + b2*x2 - a1*y1 - a2*y2
+} Filter_Type;
+
+/* 运算后端 */
+typedef enum {
+  FILTER_BACKEND_CPU,  // 浮点，CPU 计算
+  FILTER_BACKEND_FMAC, // q1.15，FMAC 计算（同一时间只能有一个滤波器占用）
+} Filter_Backend;
+
+/* 滤波器初始化配置 */
+typedef struct {
+  Filter_Type type;
+  uint8_t taps;               // FIR 系数个数（BIQUAD 忽略）
+  float b[FILTER_MAX_TAPS];   // 前馈系数
+  float a[2];                 // 反馈系数 a1、a2（a0 = 1）
+  float full_scale;           // 输入输出满量程，FMAC 下 ±full_scale 映射到 q1.15
+  uint8_t use_fmac;           // 1：优先使用 FMAC，被占用时自动退回 CPU
+} Filter_Init_Config_s;
+
+/* 滤波器实例 */
+typedef struct {
+  Filter_Backend backend;
+  Filter_Type type;
+  uint8_t taps;
+  float b[FILTER_MAX_TAPS];
+  float a[2];
+  float x[FILTER_MAX_TAPS]; // 输入历史（CPU）
+  float y[2];               // 输出历史（CPU）
+  float full_scale;
+  float full_scale_inv;
+  float out;
+} Filter_Instance;
+
+void Filter_LowpassConfig(Filter_Init_Config_s *config, float alpha);
+Filter_Instance *Filter_Register(Filter_Init_Config_s *config);
+void Filter_Reset(Filter_Instance *instance);
+void Filter_Preset(Filter_Instance *instance, float input);
+void Filter_Start(Filter_Instance *instance, float input);
+float Filter_Finish(Filter_Instance *instance);
+float Filter_Update(Filter_Instance *instance, float input);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
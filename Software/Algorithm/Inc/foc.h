@@ -3,8 +3,17 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+#include "pi.h"
+#include "filter.h"
+#include "hfi.h"
+#include "smo.h"
 #include "stm32g4xx_hal.h"
 
+/* 可注册的 FOC 实例个数（静态对象池容量） */
+#ifndef FOC_INSTANCE_MAX
+#define FOC_INSTANCE_MAX 1
+#endif
+
 /* FOC 转换类型 */
 typedef struct {
   float a;
@@ -24,47 +33,305 @@ typedef struct {
 typedef enum {
   FOC_OpenLoopMode,
   FOC_EncoderOpenLoopMode,
+  FOC_CurrentLoopMode,
 } FOC_ControlState;
 
+/* 电流环角度来源 */
+typedef enum {
+  FOC_ANGLE_EXTERNAL, // 由 FOC_CurrentLoop 的 angle 参数给出（编码器）
+  FOC_ANGLE_OBSERVER, // 由观测器给出，忽略 angle 参数
+  FOC_ANGLE_HFI,      // 低速由高频注入给出，高速平滑交接给观测器，忽略 angle 参数
+} FOC_AngleSource;
+
+/* PWM 调制方式 */
+typedef enum {
+  FOC_SPWM,   // 正弦 PWM，不注入零序分量
+  FOC_SVPWM,  // 空间矢量 PWM（min-max 零序注入）
+  FOC_THIPWM, // 三次谐波注入（1/6 幅值）
+  FOC_DPWM0,  // 不连续 PWM，钳位区间超前相电压峰值 30°
+  FOC_DPWM1,  // 不连续 PWM，钳位区间以相电压峰值为中心
+  FOC_DPWM2,  // 不连续 PWM，钳位区间滞后相电压峰值 30°
+  FOC_DPWM3,  // 不连续 PWM，钳位方向与 DPWM1 相反
+} FOC_Modulation;
+
 /* 电机基本参数 */
 typedef struct {
   float powerVol;
   float powerVol_half;
+  float powerVol_inv; // 1 / powerVol
 
   dq_Typedef Udq;
   abc_Typedef Uabc;
   AlphaBeta_Typedef UAlphaBeta;
 
+  dq_Typedef Idq;
+  abc_Typedef Iabc;
+  AlphaBeta_Typedef IAlphaBeta;
+
   uint8_t pole_pairs;            // 极对数
   float angle_mechanical;        // 机械角度
   float angle_electrical;        // 电角度
   float angle_electrical_offset; // 电角度零偏
+  int8_t direction; // 编码器方向，1：机械角度随电角度增大；-1：相反
+
+  /* 以下由参数辨识得到，未辨识时为 0 */
+  float Rs;   // 相电阻（Ω）
+  float Ld;   // d 轴电感（H）
+  float Lq;   // q 轴电感（H）
+  float flux; // 永磁体磁链（Wb）
 } FOC_MotorParam;
 
+/* 调制比 mi = 基波相电压幅值 / 六步运行基波幅值（2 * Vdc / PI） */
+#define FOC_MI_SPWM 0.7853982f   // SPWM 线性区上限 PI / 4
+#define FOC_MI_LINEAR 0.9068997f // 注入零序分量时的线性区上限 PI / (2√3)
+#define FOC_MI_OM1 0.9566129f    // 过调制 I 区上限，放大后的参考轨迹到达六边形顶点
+#define FOC_MI_HEXAGON 1.0471976f // 六边形顶点方向的瞬时幅值 PI / 3（2 * Vdc / 3）
+
+/* 电压矢量限幅形状 */
+typedef enum {
+  FOC_VLIMIT_CIRCLE,  // 圆形：幅值不超过 mi_max，mi_max 超过线性区时进入过调制
+  FOC_VLIMIT_HEXAGON, // 六边形：零序注入调制的线性区边界，不过调制；SPWM、THIPWM 时按圆形
+} FOC_VLimitShape;
+
+/* 电压矢量超限时的分配方式 */
+typedef enum {
+  FOC_VLIMIT_PROPORTIONAL, // 等比例缩小，保持 d/q 比例
+  FOC_VLIMIT_D_PRIORITY,   // 优先满足 Ud，Uq 取剩余幅值
+  FOC_VLIMIT_Q_PRIORITY,   // 优先满足 Uq，Ud 取剩余幅值
+} FOC_VLimitPriority;
+
 /* PWM 参数 */
 typedef struct {
   TIM_HandleTypeDef *tim;
   uint32_t period;
+  float Ts; // PWM 周期（s），即电流环控制周期
+  FOC_Modulation modulation;
+
+  float mi_max;  // 允许的最大调制比，FOC_MI_LINEAR 时不进入过调制
+  float mi_demand; // 限幅前的调制比需求
+  float mi;        // 当前输出的调制比
+  float om_gain; // 过调制增益，线性区为 1
+
+  FOC_VLimitShape limit_shape;
+  FOC_VLimitPriority limit_priority;
+  dq_Typedef excess; // 限幅后 - 限幅前的 Udq（V），用于反算抗饱和
 } FOC_PWM;
 
+/* 电流采样参数（ADC1 注入通道，TIM1 CC4 触发） */
+#define FOC_CURRENT_OFFSET_SAMPLES 1024 // 零偏校准采样次数
+
+typedef struct {
+  ADC_HandleTypeDef *adc;
+  float gain;           // 电流增益（A / LSB）
+  float offset_a;       // A 相零偏（LSB）
+  float offset_c;       // C 相零偏（LSB）
+  uint16_t offset_cnt;  // 零偏校准已累计的采样次数
+} FOC_CurrentSense;
+
+/* 母线电压采样参数（ADC2 规则通道，TIM1 TRGO 触发，DMA 循环搬运） */
+#define FOC_VBUS_CONV_MAX 4 // ADC2 规则序列最大转换数，即 DMA 缓冲区长度
+#define FOC_VBUS_MIN 1.0f   // 计算 1 / Vbus 时的电压下限，避免除零
+#define FOC_VBUS_ADC_FULL_SCALE 4096.0f // 12 位 ADC 满量程（LSB）
+
+typedef enum {
+  FOC_VBUS_NORMAL,
+  FOC_VBUS_UNDER, // 欠压
+  FOC_VBUS_OVER,  // 过压
+} FOC_VBusStatus;
+
+typedef struct {
+  ADC_HandleTypeDef *adc;
+  volatile uint16_t buf[FOC_VBUS_CONV_MAX]; // DMA 缓冲区，每个 PWM 周期更新一次
+  uint8_t rank;         // Vbus 在规则序列中的位置（从 0 开始）
+  float gain;           // 电压增益（V / LSB），含分压比
+  Filter_Instance *filter; // 一阶低通滤波器，FMAC 空闲时由 FMAC 计算
+  uint8_t pending;      // 本周期的采样已写入滤波器，尚未取回结果
+  float uv;             // 欠压阈值（V）
+  float ov;             // 过压阈值（V）
+  FOC_VBusStatus status;
+} FOC_VBusSense;
+
+/* 死区补偿参数：按相电流方向补偿死区和开关延迟损失的伏秒 */
+typedef struct {
+  uint8_t enable;
+  float time;     // 等效误差时间 Td + ton - toff（s），Td 由 TIM BDTR 寄存器读出
+  float duty;     // time / Ts，即需要补偿的占空比
+  float band_inv; // 1 / 过零平滑区间（1 / A）
+  int16_t duty_q15; // duty 的 Q15 表示，定点电压合成使用
+} FOC_DeadTimeComp;
+
+/* 电压反馈弱磁：调制比需求超过阈值时积分出负的 Id 给定 */
+typedef struct {
+  uint8_t enable;
+  float ki;     // 积分增益（A / s，每单位调制比误差）
+  float mi_ref; // 弱磁阈值，相对 mi_max 的比例，(0, 1]
+  float id_max; // 弱磁电流上限（A，取正值）
+  float id;     // 弱磁 d 轴电流给定（A），[-id_max, 0]
+} FOC_FieldWeakening;
+
+/* dq 轴解耦前馈：Ud += -ω·Lq·Iq，Uq += ω·(Ld·Id + ψ)，
+ * 在 Park 逆变换前叠加到电流环输出，PI 只需处理剩余误差 */
+#ifndef FOC_DECOUPLE_ALPHA
+#define FOC_DECOUPLE_ALPHA 0.1f // 外部角度差分测速的一阶低通系数，(0, 1]
+#endif
+/* 电压从采样时刻到作用中点的延迟（PWM 周期数）：计算 1 个周期（CCR 预装载）+ 半个周期，
+ * 解耦时 Udq 按 ω·delay·Ts 超前旋转，补偿转子在此期间转过的角度 */
+#ifndef FOC_DECOUPLE_DELAY
+#define FOC_DECOUPLE_DELAY 1.5f
+#endif
+
+typedef struct {
+  uint8_t enable;
+  uint8_t valid;    // angle_last 有效
+  float angle_last; // 上一周期电角度（rad）
+  float omega;      // 电角速度（rad/s），观测器、高频注入时取其估计值
+  float ud;         // d 轴前馈电压（V）
+  float uq;         // q 轴前馈电压（V）
+} FOC_Decouple;
+
+/* 电机参数辨识 */
+#define FOC_IDENT_SETTLE 0.1f  // 每一步的稳定时间（s）
+#define FOC_IDENT_AVERAGE 0.1f // 每一步的平均时间（s）
+#define FOC_IDENT_HALF 8       // 电感辨识方波半周期（PWM 周期数）
+#define FOC_IDENT_SKIP 2       // 方波翻转后跳过的采样数，覆盖 CCR 预装载延迟
+
+typedef enum {
+  FOC_IDENT_IDLE,
+  FOC_IDENT_RESISTANCE,  // 锁定转子，两级直流电流，由电压差/电流差得到 Rs
+  FOC_IDENT_INDUCTANCE_D, // 直流偏置上叠加 d 轴方波电压，由电流斜率得到 Ld
+  FOC_IDENT_INDUCTANCE_Q, // 直流偏置上叠加 q 轴方波电压，由电流斜率得到 Lq
+  FOC_IDENT_FLUX, // 电流开环拖动旋转，由反电动势得到磁链，由编码器行程得到极对数
+  FOC_IDENT_DONE,
+  FOC_IDENT_ERROR,
+} FOC_IdentState;
+
+typedef struct {
+  float current; // 辨识电流（A），须不超过 current_max
+  float voltage; // 电感辨识方波电压幅值（V）
+  float speed;   // 磁链辨识时的开环电角速度（rad/s）
+  float accel;   // 开环电角加速度（rad/s^2）
+} FOC_IdentTypedef;
+
+typedef struct {
+  FOC_IdentState state;
+  FOC_IdentTypedef config;
+  uint32_t count; // 当前步已运行的 PWM 周期数
+  uint8_t step;   // 电阻辨识：0 半电流，1 全电流
+  float sum_ud, sum_uq, sum_id, sum_iq;
+  float u1, i1;      // 半电流时的平均电压、电流；电感辨识时 i1 为上次采样的电流
+  float ud, uq;      // 锁定转子的直流电压
+  float id, iq;      // 锁定转子的直流电流
+  float i_start;     // 方波半周期起点电流
+  uint32_t n;        // 电感辨识累计的半周期数
+  float theta;       // 开环电角度（rad），[0, 2PI)
+  float omega;       // 开环电角速度（rad/s）
+  float travel_elec; // 开环累计电角度（rad）
+  float travel_mech; // 编码器累计机械角度（rad）
+  float mech_last;   // 上次的机械角度（rad）
+} FOC_Ident;
+
+/* 电角度零偏校准：d 轴电压依次锁定转子于若干电角度，正反各扫一遍 */
+#define FOC_CALIB_STEPS 6      // 每个方向的锁定点数，覆盖一个电周期
+#ifndef FOC_CALIB_DWELL
+#define FOC_CALIB_DWELL 0.035f // 每个锁定点的停留时间（s），后 1/4 用于平均，须大于转子稳定时间
+#endif
+
+typedef enum {
+  FOC_CALIB_IDLE,
+  FOC_CALIB_RUNNING,
+  FOC_CALIB_DONE,
+  FOC_CALIB_ERROR, // 转子未跟随或编码器行程与极对数不符
+} FOC_CalibState;
+
+typedef struct {
+  FOC_CalibState state;
+  float voltage;   // 锁定电压（V）
+  uint32_t count;  // 当前锁定点已运行的 PWM 周期数
+  uint8_t step;    // 当前锁定点序号，[0, 2 * FOC_CALIB_STEPS]
+  float mech_ref;  // 当前锁定点的首个平均采样（rad）
+  float mech_sum;  // 相对 mech_ref 的偏差累加（rad）
+  uint32_t n;      // 平均采样数
+  float mech[2 * FOC_CALIB_STEPS]; // 各锁定点的机械角度（rad），正扫在前
+} FOC_Calib;
+
 typedef struct {
   TIM_HandleTypeDef *tim;
-  float powerVol;
+  float powerVol; // 额定电压，启用母线电压采样时作为滤波初值
   uint8_t pole_pairs;
+  FOC_Modulation modulation; // 调制方式，默认 FOC_SPWM
+
+  ADC_HandleTypeDef *adc; // 电流采样 ADC，为 NULL 时不启用电流环
+  float current_gain;     // 电流增益（A / LSB）
+  float current_kp;       // 电流环比例增益（V / A）
+  float current_ki;       // 电流环积分增益（V / (A * s)）
+  float current_kb;       // 电流环反算抗饱和增益（1/s），为 0 时取 current_ki / current_kp
+  FOC_VLimitShape limit_shape;       // 电压矢量限幅形状，默认圆形
+  FOC_VLimitPriority limit_priority; // 电压矢量超限时的分配方式，默认等比例
+
+  ADC_HandleTypeDef *vbus_adc; // 母线电压采样 ADC，为 NULL 时使用固定的 powerVol
+  uint8_t vbus_rank;           // Vbus 在规则序列中的位置（从 0 开始）
+  float vbus_gain;             // 电压增益（V / LSB），含分压比
+  float vbus_alpha;            // 一阶低通滤波系数，(0, 1]，超出范围时不滤波
+  float vbus_uv;               // 欠压阈值（V）
+  float vbus_ov;               // 过压阈值（V）
+
+  float dt_ton;  // 开关管开通延迟（s）
+  float dt_toff; // 开关管关断延迟（s）
+  float dt_band; // 死区补偿过零平滑区间（A），为 0 时不启用死区补偿
+
+  float current_max; // 电流矢量幅值上限（A），弱磁 Id 优先，为 0 时不限制
+  float fw_ki;       // 弱磁积分增益（A / s）
+  float fw_mi_ref;   // 弱磁阈值，相对 mi_max 的比例，超出 (0, 1] 时取 0.95
+  float fw_id_max;   // 弱磁电流上限（A），为 0 时不启用弱磁
+
+  float Ld;   // d 轴电感（H），解耦前馈用，为 0 时由参数辨识得到
+  float Lq;   // q 轴电感（H）
+  float flux; // 永磁体磁链（Wb）
 } FOC_InitTypedef;
 
 typedef struct {
   FOC_ControlState state;
   FOC_MotorParam param;
   FOC_PWM pwm;
+
+  FOC_CurrentSense isense;
+  FOC_VBusSense vbus;
+  FOC_DeadTimeComp dtc;
+  FOC_FieldWeakening fw;
+  FOC_Decouple decouple;
+  SMO_Instance *observer; // 无传感器观测器，为 NULL 时不运行
+  HFI_Instance *hfi;      // 高频注入，仅在角度来源为 FOC_ANGLE_HFI 时运行
+  FOC_AngleSource angle_source;
+  FOC_Ident ident;
+  FOC_Calib calib;
+  float current_max; // 电流矢量幅值上限（A），为 0 时不限制
+  PI_Instance pi_d; // d 轴电流环
+  PI_Instance pi_q; // q 轴电流环
 } FOC_Instance;
 
 FOC_Instance *FOC_Register(FOC_InitTypedef *init);
 void FOC_Init(FOC_Instance *instance,float angle_electrical_offset);
+void FOC_SetMode(FOC_Instance *instance, FOC_ControlState mode);
+void FOC_SetModulation(FOC_Instance *instance, FOC_Modulation modulation);
+void FOC_SetOvermodulation(FOC_Instance *instance, float mi_max);
+void FOC_SetVoltageLimit(FOC_Instance *instance, FOC_VLimitShape shape,
+                         FOC_VLimitPriority priority);
+float FOC_GetModulationIndex(FOC_Instance *instance);
+float FOC_GetVoltageHeadroom(FOC_Instance *instance);
 void FOC_OpenLoop(FOC_Instance *instance, float Ud, float Uq,
                   float delta_theta);
 void FOC_EncoderOpenLoop(FOC_Instance *instance, float Ud, float Uq,
                          float angle);
+void FOC_SetObserver(FOC_Instance *instance, SMO_Instance *observer);
+void FOC_SetHFI(FOC_Instance *instance, HFI_Instance *hfi);
+void FOC_SetAngleSource(FOC_Instance *instance, FOC_AngleSource source);
+void FOC_CurrentLoop(FOC_Instance *instance, float Id, float Iq, float angle);
+void FOC_SetDecoupling(FOC_Instance *instance, uint8_t enable);
+void FOC_StartIdentify(FOC_Instance *instance, FOC_IdentTypedef *config);
+uint8_t FOC_Identify(FOC_Instance *instance, float angle_mechanical);
+void FOC_StartCalibrate(FOC_Instance *instance, float voltage);
+uint8_t FOC_CalibrateOffset(FOC_Instance *instance, float angle_mechanical);
+float FOC_ElectricalAngle(FOC_Instance *instance, float angle_mechanical);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,82 @@
+#ifndef HFI_H
+#define HFI_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "smo.h"
+#include <stdint.h>
+
+/* 可注册的 HFI 实例个数（静态对象池容量） */
+#ifndef HFI_INSTANCE_MAX
+#define HFI_INSTANCE_MAX 1
+#endif
+
+/* 高频注入状态 */
+typedef enum {
+  HFI_CONVERGE,     // 注入并等待角度收敛
+  HFI_POLARITY_POS, // 极性辨识：施加正 d 轴电流
+  HFI_POLARITY_NEG, // 极性辨识：施加负 d 轴电流
+  HFI_RUN,          // 正常跟踪
+} HFI_State;
+
+/* 高频注入初始化配置 */
+typedef struct {
+  float Ts;                  // 更新周期（s），即 PWM 周期
+  float Ld;                  // d 轴电感（H）
+  float Lq;                  // q 轴电感（H），须大于 Ld
+  float voltage;             // 注入电压幅值（V）
+  float pll_bandwidth;       // 角度跟踪带宽（rad/s），阻尼比 1
+  float speed_low;           // 开始切换到反电动势观测器的电角速度（rad/s）
+  float speed_high;          // 完全切换到反电动势观测器的电角速度（rad/s）
+  float polarity_current;    // 极性辨识 d 轴电流（A），为 0 时不辨识
+  uint16_t converge_cycles;  // 收敛等待周期数
+  uint16_t polarity_cycles;  // 每个极性辨识阶段的周期数
+  uint8_t demod_delay;       // 注入电压生效延迟（半个 PWM 周期数），0 ~ 2
+} HFI_Init_Config_s;
+
+/* 脉振方波高频注入 + 凸极跟踪观测器 */
+typedef struct {
+  HFI_State state;
+  uint16_t cycles; // 当前状态已持续的周期数
+
+  float Ts;
+  float voltage;
+  float saliency_inv; // Lq / (Lq - Ld)
+  float pll_kp;
+  float pll_ki;
+  float speed_low;
+  float speed_high_inv_span; // 1 / (speed_high - speed_low)
+  float polarity_current;
+  uint16_t converge_cycles;
+  uint16_t polarity_cycles;
+  uint8_t demod_delay;
+  uint8_t hold; // 每个注入电平保持的周期数：延迟为半个周期时取 2，否则取 1
+
+  int8_t sign[2];   // 注入方向历史，sign[0] 为最近一次输出的方向
+  uint8_t phase;    // 当前注入电平已保持的周期数
+  float id_last;    // 上一周期采样的估计 d 轴电流（A）
+  float iq_last;    // 上一周期采样的估计 q 轴电流（A）
+  float did_hf;     // 最近一个有效注入区间的 d 轴电流增量（A）
+  float diq_hf;     // 最近一个有效注入区间的 q 轴电流增量（A）
+  float did_abs;    // d 轴高频电流幅值（A），低通滤波
+  float polarity_pos;
+  float polarity_neg;
+
+  float pll_integral;
+  float theta;    // 估计电角度（rad），已外推到下一采样时刻
+  float speed;    // 估计电角速度（rad/s）
+  float weight;   // 反电动势观测器的权重，[0, 1]
+  float angle;    // 与反电动势观测器融合后的电角度（rad）
+  float u_inject; // 下一周期叠加在 d 轴的注入电压（V）
+  float id_bias;  // 极性辨识期间叠加的 d 轴电流给定（A）
+} HFI_Instance;
+
+HFI_Instance *HFI_Register(HFI_Init_Config_s *config);
+void HFI_Reset(HFI_Instance *instance, float theta);
+float HFI_Angle(HFI_Instance *instance, SMO_Instance *observer);
+void HFI_Update(HFI_Instance *instance, float *id, float *iq);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
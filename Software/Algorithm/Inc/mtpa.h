@@ -0,0 +1,41 @@
+#ifndef MTPA_H
+#define MTPA_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <stdint.h>
+
+/* 可注册的 MTPA 实例个数（静态对象池容量） */
+#ifndef MTPA_INSTANCE_MAX
+#define MTPA_INSTANCE_MAX 1
+#endif
+
+#define MTPA_TABLE_SIZE 33 // 查表点数，转矩 [0, torque_max] 等间隔
+
+/* 电机参数 */
+typedef struct {
+  uint8_t pole_pairs; // 极对数
+  float Ld;           // d 轴电感（H）
+  float Lq;           // q 轴电感（H）
+  float flux;         // 永磁体磁链（Wb）
+  float current_max;  // 电流矢量幅值上限（A），决定最大转矩
+} MTPA_Init_Config_s;
+
+/* MTPA 实例：转矩到 (Id, Iq) 的查找表 */
+typedef struct {
+  float torque_const;    // Id = 0 时的转矩常数 1.5 * p * ψ（N·m / A）
+  float torque_max;      // 表覆盖的最大转矩（N·m）
+  float torque_step_inv; // (MTPA_TABLE_SIZE - 1) / torque_max
+  float id[MTPA_TABLE_SIZE];
+  float iq[MTPA_TABLE_SIZE];
+} MTPA_Instance;
+
+MTPA_Instance *MTPA_Register(MTPA_Init_Config_s *config);
+void MTPA_Generate(MTPA_Init_Config_s *config, MTPA_Instance *table);
+void MTPA_Calculate(MTPA_Instance *instance, float torque, float *id,
+                    float *iq);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,28 @@
+#ifndef PI_H
+#define PI_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <stdint.h>
+
+/* PI 控制器 */
+typedef struct {
+  float kp;       // 比例增益
+  float ki;       // 积分增益（连续域，1/s）
+  float Ts;       // 控制周期（s）
+  float out_max;  // 输出限幅（对称，±out_max）
+  float kb;       // 反算抗饱和增益（1/s），为 0 时只做积分限幅
+  float integral; // 积分项
+  float out;      // 输出
+} PI_Instance;
+
+void PI_Init(PI_Instance *pi, float kp, float ki, float Ts, float out_max);
+void PI_Reset(PI_Instance *pi);
+float PI_Calculate(PI_Instance *pi, float measure, float ref);
+void PI_SetBackCalculation(PI_Instance *pi, float kb);
+void PI_BackCalculate(PI_Instance *pi, float excess);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,59 @@
+#ifndef SMO_H
+#define SMO_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <stdint.h>
+
+/* 可注册的 SMO 实例个数（静态对象池容量） */
+#ifndef SMO_INSTANCE_MAX
+#define SMO_INSTANCE_MAX 1
+#endif
+
+/* 滑模观测器初始化配置 */
+typedef struct {
+  float Rs;            // 相电阻（Ω）
+  float Ls;            // 相电感（H），凸极电机取 Lq
+  float Ts;            // 更新周期（s），即 PWM 周期
+  float k_slide;       // 滑模增益（V），须大于最大反电动势幅值
+  float boundary;      // 边界层宽度（A），sat 函数代替 sign 以削弱抖振，
+                       // 不小于 k_slide * Ts / Ls
+  float lpf_cutoff;    // 反电动势低通截止频率（rad/s）
+  float pll_bandwidth; // PLL 带宽（rad/s），阻尼比 1
+  float speed_min;     // 估计值有效的最低电角速度（rad/s）
+} SMO_Init_Config_s;
+
+/* 滑模观测器 + PLL */
+typedef struct {
+  float Rs;
+  float Ls_inv;
+  float Ts;
+  float k_slide;
+  float boundary_inv;
+  float lpf_alpha;  // 低通系数 ωc * Ts / (1 + ωc * Ts)
+  float lpf_cutoff_inv;
+  float pll_kp;
+  float pll_ki;
+  float speed_min;
+
+  float i_alpha; // 估计电流（A）
+  float i_beta;
+  float e_alpha; // 滤波后的反电动势（V）
+  float e_beta;
+
+  float pll_integral;
+  float theta; // PLL 跟踪的反电动势矢量角（rad），已外推到下一采样时刻
+  float speed; // 电角速度估计（rad/s）
+  float angle; // 补偿低通滞后后的电角度（rad），[0, 2PI)
+} SMO_Instance;
+
+SMO_Instance *SMO_Register(SMO_Init_Config_s *config);
+void SMO_Reset(SMO_Instance *instance);
+void SMO_Update(SMO_Instance *instance, float i_alpha, float i_beta,
+                float u_alpha, float u_beta);
+uint8_t SMO_IsValid(SMO_Instance *instance);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
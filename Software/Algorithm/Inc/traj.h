@@ -0,0 +1,57 @@
+#ifndef TRAJ_H
+#define TRAJ_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <stdint.h>
+
+/* 可注册的轨迹规划实例个数（静态对象池容量） */
+#ifndef TRAJ_INSTANCE_MAX
+#define TRAJ_INSTANCE_MAX 1
+#endif
+
+/* 每次更新时求解下一步加速度的二分次数，决定单次更新的固定耗时 */
+#ifndef TRAJ_ITERATIONS
+#define TRAJ_ITERATIONS 16
+#endif
+
+/* 速度曲线类型 */
+typedef enum {
+  TRAJ_TRAPEZOID, // 梯形速度曲线：加速度阶跃，受速度、加速度限制
+  TRAJ_SCURVE,    // S 形速度曲线：另受加加速度（jerk）限制，加速度连续
+} Traj_Profile;
+
+typedef struct {
+  Traj_Profile profile;
+  float Ts;       // 更新周期（s），即 Traj_Update 的调用周期
+  float vel_max;  // 速度上限（rad/s）
+  float acc_max;  // 加速度上限（rad/s^2）
+  float jerk_max; // 加加速度上限（rad/s^3），仅 S 形曲线使用
+} Traj_Init_Config_s;
+
+/* 在线轨迹规划：每个周期由当前设定点状态向目标推进一步，目标可随时修改 */
+typedef struct {
+  Traj_Profile profile;
+  float Ts;
+  float vel_max;
+  float acc_max;
+  float jerk_max;
+
+  float target; // 目标位置（rad）
+  float pos;    // 位置设定点（rad）
+  float vel;    // 速度设定点（rad/s）
+  float acc;    // 加速度设定点（rad/s^2）
+  uint8_t done; // 1：已停在目标位置
+} Traj_Instance;
+
+Traj_Instance *Traj_Register(Traj_Init_Config_s *config);
+void Traj_Reset(Traj_Instance *instance, float pos, float vel);
+void Traj_SetTarget(Traj_Instance *instance, float target);
+void Traj_SetLimits(Traj_Instance *instance, float vel_max, float acc_max,
+                    float jerk_max);
+void Traj_Update(Traj_Instance *instance);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,342 @@
+#include "cascade.h"
+#include "bsp_pool.h"
+#include "bsp_profile.h"
+#include "arm_math.h"
+#include "string.h"
+
+POOL_DEFINE(cascade_pool, Cascade_Instance, CASCADE_INSTANCE_MAX);
+
+/* ---------------- 驱动函数 Begin ---------------- */
+/**
+ * @brief 读取 CPU 周期计数（主机构建时为 ns）
+ */
+static uint32_t CycleCount(void) {
+#if CASCADE_PROFILE
+  return Profile_Now();
+#else
+  return 0;
+#endif
+}
+
+/**
+ * @brief 记录一次执行耗时
+ */
+static void RateRecord(Cascade_Rate *rate, uint32_t start) {
+  rate->cycles_last = CycleCount() - start;
+  if (rate->cycles_last > rate->cycles_max)
+    rate->cycles_max = rate->cycles_last;
+}
+
+/**
+ * @brief 分频计数，返回本 PWM 周期是否执行该环
+ */
+static uint8_t RateTick(Cascade_Rate *rate) {
+  uint8_t run = (rate->count == rate->phase);
+  if (++rate->count >= rate->div)
+    rate->count = 0;
+  return run;
+}
+
+/**
+ * @brief 最大公约数
+ */
+static uint16_t Gcd(uint16_t a, uint16_t b) {
+  while (b != 0) {
+    uint16_t t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+/**
+ * @brief 由单圈机械角度累计多圈位置
+ */
+static void PositionUpdate(Cascade_Instance *instance, float angle) {
+  if (!instance->angle_valid) {
+    instance->angle_last = angle;
+    instance->pos = angle;
+    instance->pos_speed = angle;
+    instance->angle_valid = 1;
+    return;
+  }
+
+  float delta = angle - instance->angle_last;
+  if (delta > PI)
+    delta -= 2.0f * PI;
+  else if (delta < -PI)
+    delta += 2.0f * PI;
+  instance->pos += delta;
+  instance->angle_last = angle;
+}
+
+/**
+ * @brief 测速：按两次执行间的位置差测速，写入低通滤波器，
+ *        FMAC 滤波与本周期的电流环并行；
+ *        电流环角度来自观测器或高频注入时，改用其电角速度估计换算为机械角速度
+ */
+static void SpeedMeasure(Cascade_Instance *instance) {
+  FOC_Instance *foc = instance->foc;
+  float speed = (instance->pos - instance->pos_speed) / instance->pi_speed.Ts;
+  instance->pos_speed = instance->pos;
+
+  if (foc->angle_source == FOC_ANGLE_OBSERVER)
+    speed = foc->observer->speed * foc->param.direction / foc->param.pole_pairs;
+  else if (foc->angle_source == FOC_ANGLE_HFI)
+    speed = foc->hfi->speed * foc->param.direction / foc->param.pole_pairs;
+  Filter_Start(instance->speed_filter, speed);
+}
+
+/**
+ * @brief 速度环：取回滤波后的速度，PI 输出 Iq 目标
+ */
+static void SpeedLoop(Cascade_Instance *instance) {
+  instance->speed = Filter_Finish(instance->speed_filter);
+
+  if (instance->mode != CASCADE_CURRENT) {
+    instance->iq_ref = PI_Calculate(&instance->pi_speed, instance->speed,
+                                    instance->speed_ref);
+    if (instance->cogging != NULL)
+      Cogging_Learn(instance->cogging, instance->angle_last, instance->iq_ref);
+    if (instance->mode == CASCADE_POSITION)
+      instance->iq_ref += instance->iq_ff;
+  }
+}
+
+/**
+ * @brief 位置环：比例控制，输出速度目标；有轨迹规划时由其给出位置目标，
+ *        并把速度、加速度设定点前馈到速度环和电流环
+ */
+static void PositionLoop(Cascade_Instance *instance) {
+  float speed_ff = 0.0f;
+  if (instance->traj != NULL) {
+    Traj_Update(instance->traj);
+    instance->pos_ref = instance->traj->pos;
+    speed_ff = instance->traj->vel;
+    instance->iq_ff = instance->acc_gain * instance->traj->acc;
+  }
+
+  float speed =
+      instance->pos_kp * (instance->pos_ref - instance->pos) + speed_ff;
+  if (speed > instance->speed_max)
+    speed = instance->speed_max;
+  else if (speed < -instance->speed_max)
+    speed = -instance->speed_max;
+  instance->speed_ref = speed;
+}
+/* ---------------- 驱动函数  End  ---------------- */
+
+/* ---------------- 用户函数 Begin ---------------- */
+/**
+ * @brief 注册串级控制实例
+ * @note 速度环与位置环的分频和相位须保证二者永不在同一 PWM 周期执行，
+ *       即 speed_phase 与 pos_phase 对 gcd(speed_div, pos_div) 不同余，否则返回 NULL
+ * @param config 初始化配置
+ * @return 串级控制实例
+ */
+Cascade_Instance *Cascade_Register(Cascade_Init_Config_s *config) {
+  if (config->foc == NULL || config->speed_div == 0 || config->pos_div == 0 ||
+      config->speed_phase >= config->speed_div ||
+      config->pos_phase >= config->pos_div)
+    return NULL;
+  uint16_t g = Gcd(config->speed_div, config->pos_div);
+  if (config->speed_phase % g == config->pos_phase % g)
+    return NULL;
+
+  Cascade_Instance *instance =
+      (Cascade_Instance *)Pool_Alloc(&cascade_pool);
+  if (instance == NULL)
+    return NULL;
+
+  float Ts = config->foc->pwm.Ts;
+  instance->foc = config->foc;
+  instance->mode = CASCADE_CURRENT;
+  instance->loop_current.div = 1;
+  instance->loop_speed.div = config->speed_div;
+  instance->loop_speed.phase = config->speed_phase;
+  instance->loop_position.div = config->pos_div;
+  instance->loop_position.phase = config->pos_phase;
+
+  PI_Init(&instance->pi_speed, config->speed_kp, config->speed_ki,
+          Ts * config->speed_div, config->iq_max);
+
+  Filter_Init_Config_s filter;
+  Filter_LowpassConfig(&filter, (config->speed_alpha > 0.0f &&
+                                 config->speed_alpha <= 1.0f)
+                                    ? config->speed_alpha
+                                    : 1.0f);
+  if (config->speed_range > 0.0f) {
+    filter.full_scale = config->speed_range;
+    filter.use_fmac = 1;
+  }
+  instance->speed_filter = Filter_Register(&filter);
+  if (instance->speed_filter == NULL) {
+    Pool_Free(&cascade_pool, instance);
+    return NULL;
+  }
+  instance->pos_kp = config->pos_kp;
+  instance->speed_max = config->speed_max;
+  instance->acc_gain = config->acc_gain;
+
+#if CASCADE_PROFILE
+  Profile_Init();
+#endif
+  return instance;
+}
+
+/**
+ * @brief 设置控制模式，切换时清除速度环积分并以当前状态作为外环目标
+ */
+void Cascade_SetMode(Cascade_Instance *instance, Cascade_Mode mode) {
+  if (mode == instance->mode)
+    return;
+  PI_Reset(&instance->pi_speed);
+  instance->pi_speed.integral = instance->iq_ref;
+  instance->speed_ref = instance->speed;
+  instance->pos_ref = instance->pos;
+  instance->iq_ff = 0.0f;
+  if (instance->traj != NULL)
+    Traj_Reset(instance->traj, instance->pos, instance->speed);
+  instance->mode = mode;
+}
+
+/**
+ * @brief 设置电流目标（电流模式），速度模式和位置模式下 Iq 由速度环给出
+ */
+void Cascade_SetCurrent(Cascade_Instance *instance, float id, float iq) {
+  instance->id_ref = id;
+  if (instance->mode == CASCADE_CURRENT)
+    instance->iq_ref = iq;
+}
+
+/**
+ * @brief 设置速度目标（rad/s，机械角速度），仅速度模式有效
+ */
+void Cascade_SetSpeed(Cascade_Instance *instance, float speed) {
+  if (instance->mode == CASCADE_SPEED)
+    instance->speed_ref = speed;
+}
+
+/**
+ * @brief 设置位置目标（rad，多圈机械角度），仅位置模式有效；
+ *        有轨迹规划时按速度、加速度限制平滑运动到目标，运动中可随时修改
+ */
+void Cascade_SetPosition(Cascade_Instance *instance, float pos) {
+  if (instance->mode != CASCADE_POSITION)
+    return;
+  if (instance->traj != NULL)
+    Traj_SetTarget(instance->traj, pos);
+  else
+    instance->pos_ref = pos;
+}
+
+/**
+ * @brief 串级控制更新，须在 ADC 注入转换完成回调中每个 PWM 周期调用一次
+ *        电流环每周期执行；速度环、位置环按分频和相位错开执行，
+ *        单次中断最多执行电流环和一个外环
+ * @note 速度环在电流环之前写入测速样本、之后取回滤波结果并计算 Iq 目标，
+ *       新的 Iq 目标从下一个 PWM 周期起生效
+ * @param instance 串级控制实例
+ * @param angle_mechanical 机械角度（rad，[0, 2PI)）
+ * @param angle_electrical 电角度（rad）
+ */
+void Cascade_Update(Cascade_Instance *instance, float angle_mechanical,
+                    float angle_electrical) {
+  uint32_t start;
+  PositionUpdate(instance, angle_mechanical);
+
+  if (RateTick(&instance->loop_position) &&
+      instance->mode == CASCADE_POSITION) {
+    start = CycleCount();
+    PositionLoop(instance);
+    RateRecord(&instance->loop_position, start);
+  }
+
+  uint8_t speed_run = RateTick(&instance->loop_speed);
+  uint32_t speed_cycles = 0;
+  if (speed_run) {
+    start = CycleCount();
+    SpeedMeasure(instance);
+    speed_cycles = CycleCount() - start;
+  }
+
+  start = CycleCount();
+  float id = instance->id_ref;
+  float iq = instance->iq_ref;
+  if (instance->cogging != NULL)
+    iq += Cogging_Feedforward(instance->cogging, angle_mechanical);
+  /* 外环输出按 Id = 0 的等效 Iq 计算，经 MTPA 换算为转矩后重新分配到 d、q 轴 */
+  if (instance->mtpa != NULL && instance->mode != CASCADE_CURRENT) {
+    float mtpa_id;
+    MTPA_Calculate(instance->mtpa, iq * instance->mtpa->torque_const, &mtpa_id,
+                   &iq);
+    id += mtpa_id;
+  }
+  FOC_CurrentLoop(instance->foc, id, iq, angle_electrical);
+  RateRecord(&instance->loop_current, start);
+
+  /* 速度环耗时为测速和 PI 两段之和 */
+  if (speed_run) {
+    start = CycleCount() - speed_cycles;
+    SpeedLoop(instance);
+    RateRecord(&instance->loop_speed, start);
+  }
+}
+
+/**
+ * @brief 设置齿槽转矩补偿，Iq 前馈在每个电流环周期按机械角度查表叠加，
+ *        学习时由速度环输出驱动
+ * @param instance 串级控制实例
+ * @param cogging 齿槽转矩补偿实例，为 NULL 时不补偿
+ */
+void Cascade_SetCogging(Cascade_Instance *instance, Cogging_Instance *cogging) {
+  instance->cogging = cogging;
+}
+
+/**
+ * @brief 设置位置模式的轨迹规划，轨迹每个位置环周期推进一步
+ * @note 轨迹的 Ts 须等于位置环周期（PWM 周期 * pos_div），位置单位为多圈机械角度
+ * @param instance 串级控制实例
+ * @param traj 轨迹规划实例，为 NULL 时位置目标直接阶跃
+ */
+void Cascade_SetTrajectory(Cascade_Instance *instance, Traj_Instance *traj) {
+  instance->traj = traj;
+  instance->iq_ff = 0.0f;
+  if (traj != NULL)
+    Traj_Reset(traj, instance->pos, instance->speed);
+}
+
+/**
+ * @brief 设置 MTPA 转矩分配：速度、位置模式下，速度环输出（含齿槽、加速度前馈）
+ *        视为 Id = 0 时的等效 Iq，乘以转矩常数得到转矩指令，
+ *        再由 MTPA 表得到 (Id, Iq)，Id 叠加在 Cascade_SetCurrent 给定的 Id 上
+ * @note 速度环增益和 iq_max 仍按等效 Iq 整定；电流模式不经过 MTPA
+ * @param instance 串级控制实例
+ * @param mtpa MTPA 实例，为 NULL 时不分配
+ */
+void Cascade_SetMTPA(Cascade_Instance *instance, MTPA_Instance *mtpa) {
+  instance->mtpa = mtpa;
+}
+
+/**
+ * @brief 获取各控制环的执行预算报告
+ * @param instance 串级控制实例
+ * @param report 报告（输出）
+ */
+void Cascade_GetReport(Cascade_Instance *instance, Cascade_Report *report) {
+  float f_pwm = 1.0f / instance->foc->pwm.Ts;
+  uint32_t speed = instance->loop_speed.cycles_max;
+  uint32_t position = instance->loop_position.cycles_max;
+  uint32_t outer = (speed > position) ? speed : position;
+
+  report->rate_current = f_pwm;
+  report->rate_speed = f_pwm / instance->loop_speed.div;
+  report->rate_position = f_pwm / instance->loop_position.div;
+  report->cycles_period = (uint32_t)(Profile_ClockHz() * instance->foc->pwm.Ts);
+  report->cycles_current = instance->loop_current.cycles_max;
+  report->cycles_speed = instance->loop_speed.cycles_max;
+  report->cycles_position = instance->loop_position.cycles_max;
+  report->load_worst = (float)(instance->loop_current.cycles_max + outer) /
+                       (float)report->cycles_period;
+}
+/* ---------------- 用户函数  End  ---------------- */
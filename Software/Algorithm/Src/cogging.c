@@ -0,0 +1,159 @@
+#include "cogging.h"
+#include "bsp_pool.h"
+#include "arm_math.h"
+#include "string.h"
+
+POOL_DEFINE(cogging_pool, Cogging_Instance, COGGING_INSTANCE_MAX);
+
+/* ---------------- 驱动函数 Begin ---------------- */
+/**
+ * @brief 机械角度对应的表格位置，整数部分为分段序号，[0, COGGING_TABLE_SIZE)
+ */
+static float TablePosition(float angle) {
+  float x = angle * (COGGING_TABLE_SIZE / (2.0f * PI));
+  while (x >= COGGING_TABLE_SIZE)
+    x -= COGGING_TABLE_SIZE;
+  while (x < 0.0f)
+    x += COGGING_TABLE_SIZE;
+  /* 绝对值极小的负角度加上表长后舍入为 COGGING_TABLE_SIZE 本身 */
+  if (x >= COGGING_TABLE_SIZE)
+    x = 0.0f;
+  return x;
+}
+
+/**
+ * @brief 读取分段 i 的补偿量（A）
+ */
+static float TableGet(Cogging_Instance *instance, uint16_t i) {
+#if COGGING_Q15
+  return instance->table[i] * instance->scale;
+#else
+  return instance->table[i];
+#endif
+}
+
+/**
+ * @brief 写入分段 i 的补偿量（A），限幅到 ±iq_max
+ */
+static void TableSet(Cogging_Instance *instance, uint16_t i, float iq) {
+  iq = (iq > instance->iq_max) ? instance->iq_max : iq;
+  iq = (iq < -instance->iq_max) ? -instance->iq_max : iq;
+#if COGGING_Q15
+  float lsb = iq / instance->scale;
+  instance->table[i] = (int16_t)((lsb >= 0.0f) ? lsb + 0.5f : lsb - 0.5f);
+#else
+  instance->table[i] = iq;
+#endif
+}
+
+/**
+ * @brief 学习结束：去除表的均值，与位置无关的负载仍由速度环承担
+ */
+static void TableRemoveMean(Cogging_Instance *instance) {
+  float mean = 0.0f;
+  for (uint16_t i = 0; i < COGGING_TABLE_SIZE; i++)
+    mean += TableGet(instance, i);
+  mean /= COGGING_TABLE_SIZE;
+  for (uint16_t i = 0; i < COGGING_TABLE_SIZE; i++)
+    TableSet(instance, i, TableGet(instance, i) - mean);
+}
+/* ---------------- 驱动函数  End  ---------------- */
+
+/* ---------------- 用户函数 Begin ---------------- */
+/**
+ * @brief 注册齿槽转矩补偿实例，补偿表初始为 0
+ * @param config 初始化配置
+ * @return 齿槽转矩补偿实例
+ */
+Cogging_Instance *Cogging_Register(Cogging_Init_Config_s *config) {
+  if (config->iq_max <= 0.0f || config->gain <= 0.0f || config->gain > 1.0f)
+    return NULL;
+
+  Cogging_Instance *instance =
+      (Cogging_Instance *)Pool_Alloc(&cogging_pool);
+  if (instance == NULL)
+    return NULL;
+
+  instance->state = COGGING_IDLE;
+  instance->iq_max = config->iq_max;
+  instance->gain = config->gain;
+  instance->mean_alpha =
+      (config->mean_alpha > 0.0f && config->mean_alpha <= 1.0f)
+          ? config->mean_alpha
+          : 0.001f;
+#if COGGING_Q15
+  instance->scale = config->iq_max / 32767.0f;
+#endif
+  return instance;
+}
+
+/**
+ * @brief 开始迭代学习，须在速度环以低速匀速运行时调用，已有表时在其基础上继续修正
+ * @note 齿槽频率（转速 × 每圈齿槽周期数 / 2PI）须低于速度环带宽，
+ *       否则速度环输出相对齿槽转矩滞后过多，学习不收敛
+ * @param instance 齿槽转矩补偿实例
+ * @param revolutions 学习圈数
+ * @param angle_mechanical 当前机械角度（rad）
+ */
+void Cogging_StartLearn(Cogging_Instance *instance, uint16_t revolutions,
+                        float angle_mechanical) {
+  instance->travel = 0.0f;
+  instance->travel_max = 2.0f * PI * ((revolutions > 0) ? revolutions : 1);
+  instance->angle_last = angle_mechanical;
+  instance->iq_mean = 0.0f;
+  instance->state = COGGING_LEARN;
+}
+
+/**
+ * @brief 迭代学习：速度环输出中随位置变化的分量即尚未补偿的齿槽转矩，
+ *        每次按 gain 计入当前分段；前馈随之增大，速度环输出的波动逐圈收敛到 0
+ * @note 在速度环中调用，iq 为速度环输出（不含前馈）；
+ *       q15 存储时更新量小于 0.5 LSB 会被舍去，残差约为 0.5 * scale / gain
+ * @param instance 齿槽转矩补偿实例
+ * @param angle_mechanical 机械角度（rad）
+ * @param iq 速度环输出的 Iq 给定（A）
+ */
+void Cogging_Learn(Cogging_Instance *instance, float angle_mechanical,
+                   float iq) {
+  if (instance->state != COGGING_LEARN)
+    return;
+
+  float delta = angle_mechanical - instance->angle_last;
+  if (delta > PI)
+    delta -= 2.0f * PI;
+  else if (delta < -PI)
+    delta += 2.0f * PI;
+  instance->angle_last = angle_mechanical;
+  instance->travel += (delta > 0.0f) ? delta : -delta;
+
+  /* 首圈只跟踪均值，避免均值未收敛时把摩擦写入表 */
+  instance->iq_mean += instance->mean_alpha * (iq - instance->iq_mean);
+  if (instance->travel < 2.0f * PI)
+    return;
+
+  /* 计入最近的表项，与查表时的线性插值对应 */
+  uint16_t i =
+      (uint16_t)(TablePosition(angle_mechanical) + 0.5f) % COGGING_TABLE_SIZE;
+  TableSet(instance, i,
+           TableGet(instance, i) + instance->gain * (iq - instance->iq_mean));
+
+  if (instance->travel >= instance->travel_max + 2.0f * PI) {
+    TableRemoveMean(instance);
+    instance->state = COGGING_DONE;
+  }
+}
+
+/**
+ * @brief 齿槽转矩前馈，每个电流环周期查表一次，相邻表项间线性插值
+ * @param instance 齿槽转矩补偿实例
+ * @param angle_mechanical 机械角度（rad）
+ * @return Iq 前馈（A）
+ */
+float Cogging_Feedforward(Cogging_Instance *instance, float angle_mechanical) {
+  float x = TablePosition(angle_mechanical);
+  uint16_t i = (uint16_t)x;
+  float a = TableGet(instance, i);
+  float b = TableGet(instance, (i + 1) % COGGING_TABLE_SIZE);
+  return a + (x - (float)i) * (b - a);
+}
+/* ---------------- 用户函数  End  ---------------- */
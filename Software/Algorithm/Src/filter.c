@@ -0,0 +1,195 @@
+#include "filter.h"
+#include "bsp_pool.h"
+#include "bsp_fmac.h"
+#include "string.h"
+
+POOL_DEFINE(filter_pool, Filter_Instance, FILTER_INSTANCE_MAX);
+
+static Filter_Instance *fmac_owner = NULL; // 占用 FMAC 的滤波器
+
+static float Abs(float x) { return (x >= 0.0f) ? x : -x; }
+
+/**
+ * @brief 浮点数转 q1.15（四舍五入、饱和）
+ */
+static int16_t FloatToQ15(float x) {
+  float v = x * 32768.0f;
+  v += (v >= 0.0f) ? 0.5f : -0.5f;
+  if (v >= 32767.0f)
+    return INT16_MAX;
+  if (v <= -32768.0f)
+    return INT16_MIN;
+  return (int16_t)v;
+}
+
+/**
+ * @brief 将滤波器映射到 FMAC：系数统一除以 2^r 使其落入 q1.15，输出再乘以 2^r
+ * @param x_init 历史输入的初始值
+ * @param y_init 历史输出的初始值
+ * @retval HAL_OK：成功；其他：系数无法映射
+ */
+static HAL_StatusTypeDef Filter_FMACStart(Filter_Instance *instance,
+                                          float x_init, float y_init) {
+  FMAC_Filter_Config_s fmac;
+  memset(&fmac, 0, sizeof(fmac));
+
+  uint8_t nb = (instance->type == FILTER_FIR) ? instance->taps : 3;
+  uint8_t na = (instance->type == FILTER_FIR) ? 0 : 2;
+
+  float max = 0.0f;
+  for (uint8_t i = 0; i < nb; i++)
+    if (Abs(instance->b[i]) > max)
+      max = Abs(instance->b[i]);
+  for (uint8_t i = 0; i < na; i++)
+    if (Abs(instance->a[i]) > max)
+      max = Abs(instance->a[i]);
+
+  float scale = 1.0f;
+  while (max * scale >= 1.0f && fmac.r < 7) {
+    scale *= 0.5f;
+    fmac.r++;
+  }
+
+  fmac.func = (instance->type == FILTER_FIR) ? FMAC_FUNC_FIR : FMAC_FUNC_IIR;
+  fmac.p = nb;
+  fmac.q = na;
+  for (uint8_t i = 0; i < nb; i++)
+    fmac.coeff_b[i] = FloatToQ15(instance->b[i] * scale);
+  for (uint8_t i = 0; i < na; i++)
+    fmac.coeff_a[i] = FloatToQ15(-instance->a[i] * scale); // FMAC 反馈取正号
+  fmac.x_init = FloatToQ15(x_init * instance->full_scale_inv);
+  fmac.y_init = FloatToQ15(y_init * instance->full_scale_inv);
+
+  return FMAC_Filter_Start(&fmac);
+}
+
+/**
+ * @brief 一阶低通（与 AS5047P_Lowpass 相同）：y = y1 + alpha * (x - y1)
+ * @param config 待填写的配置
+ * @param alpha 滤波系数 (0, 1]
+ */
+void Filter_LowpassConfig(Filter_Init_Config_s *config, float alpha) {
+  memset(config, 0, sizeof(Filter_Init_Config_s));
+  config->type = FILTER_BIQUAD;
+  config->b[0] = alpha;
+  config->a[0] = alpha - 1.0f;
+  config->full_scale = 1.0f;
+}
+
+/**
+ * @brief 注册滤波器实例
+ * @param config 初始化配置
+ * @retval 滤波器实例指针
+ */
+Filter_Instance *Filter_Register(Filter_Init_Config_s *config) {
+  if (config == NULL || config->full_scale <= 0.0f)
+    return NULL;
+  if (config->type == FILTER_FIR &&
+      (config->taps == 0 || config->taps > FILTER_MAX_TAPS))
+    return NULL;
+
+  Filter_Instance *instance = (Filter_Instance *)Pool_Alloc(&filter_pool);
+  if (instance == NULL)
+    return NULL;
+
+  instance->type = config->type;
+  instance->taps = (config->type == FILTER_FIR) ? config->taps : 3;
+  memcpy(instance->b, config->b, sizeof(instance->b));
+  memcpy(instance->a, config->a, sizeof(instance->a));
+  instance->full_scale = config->full_scale;
+  instance->full_scale_inv = 1.0f / config->full_scale;
+  instance->backend = FILTER_BACKEND_CPU;
+
+  /* FMAC 空闲且系数可映射时使用 FMAC，否则使用 CPU */
+  if (config->use_fmac && fmac_owner == NULL &&
+      Filter_FMACStart(instance, 0.0f, 0.0f) == HAL_OK) {
+    instance->backend = FILTER_BACKEND_FMAC;
+    fmac_owner = instance;
+  }
+
+  return instance;
+}
+
+/**
+ * @brief 清除滤波器状态
+ */
+void Filter_Reset(Filter_Instance *instance) {
+  memset(instance->x, 0, sizeof(instance->x));
+  memset(instance->y, 0, sizeof(instance->y));
+  instance->out = 0.0f;
+  if (instance->backend == FILTER_BACKEND_FMAC)
+    Filter_FMACStart(instance, 0.0f, 0.0f);
+}
+
+/**
+ * @brief 按输入恒为 input 的稳态预置滤波器状态，输出为 input 乘以直流增益
+ * @note 用于从已知初值（如额定母线电压）开始滤波，避免输出从 0 爬升
+ */
+void Filter_Preset(Filter_Instance *instance, float input) {
+  float gain = 0.0f;
+  for (uint8_t i = 0; i < instance->taps; i++)
+    gain += instance->b[i];
+  if (instance->type == FILTER_BIQUAD)
+    gain /= 1.0f + instance->a[0] + instance->a[1];
+
+  float output = input * gain;
+  for (uint8_t i = 0; i < FILTER_MAX_TAPS; i++)
+    instance->x[i] = input;
+  instance->y[0] = output;
+  instance->y[1] = output;
+  instance->out = output;
+  if (instance->backend == FILTER_BACKEND_FMAC)
+    Filter_FMACStart(instance, input, output);
+}
+
+/**
+ * @brief 写入一个输入样本：FMAC 后端只启动计算，可与其他运算并行，
+ *        由 Filter_Finish 取回结果；CPU 后端直接完成计算
+ * @param instance 滤波器实例
+ * @param input 输入
+ */
+void Filter_Start(Filter_Instance *instance, float input) {
+  if (instance->backend == FILTER_BACKEND_FMAC) {
+    FMAC_Filter_Write(FloatToQ15(input * instance->full_scale_inv));
+    return;
+  }
+
+  /* 输入历史右移 */
+  for (uint8_t i = instance->taps - 1; i > 0; i--)
+    instance->x[i] = instance->x[i - 1];
+  instance->x[0] = input;
+
+  float acc = 0.0f;
+  for (uint8_t i = 0; i < instance->taps; i++)
+    acc += instance->b[i] * instance->x[i];
+
+  if (instance->type == FILTER_BIQUAD) {
+    acc -= instance->a[0] * instance->y[0] + instance->a[1] * instance->y[1];
+    instance->y[1] = instance->y[0];
+    instance->y[0] = acc;
+  }
+  instance->out = acc;
+}
+
+/**
+ * @brief 取回 Filter_Start 写入样本的输出，FMAC 未完成时等待
+ * @param instance 滤波器实例
+ * @return 输出
+ */
+float Filter_Finish(Filter_Instance *instance) {
+  if (instance->backend == FILTER_BACKEND_FMAC)
+    instance->out =
+        (float)FMAC_Filter_Read() * (instance->full_scale / 32768.0f);
+  return instance->out;
+}
+
+/**
+ * @brief 滤波器更新一次（Filter_Start + Filter_Finish）
+ * @param instance 滤波器实例
+ * @param input 输入
+ * @return 输出
+ */
+float Filter_Update(Filter_Instance *instance, float input) {
+  Filter_Start(instance, input);
+  return Filter_Finish(instance);
+}
@@ -1,25 +1,95 @@
 #include "foc.h"
+#include "bsp_pool.h"
+#include "bsp_profile.h"
 #include "arm_math.h"
+#include "bsp_cordic.h"
 // #include "math.h"
-#include "stdlib.h"
 #include "stm32g4xx_hal_tim.h"
 #include "stm32g4xx_hal_tim_ex.h"
 #include "string.h"
 #include <stdint.h>
 
+POOL_DEFINE(foc_pool, FOC_Instance, FOC_INSTANCE_MAX);
+
 #define SQRT3 1.732050807568877f      // √3
 #define SQRT3_DIV2 0.866025403784438f // √3 / 2
 #define _2PI 6.283185307179586f       // 2 * PI
+#define _2PI_HI 6.28125f              // 2 * PI 的高位，8 位有效数字
+#define _2PI_LO 1.935307179586477e-3f // 2 * PI - _2PI_HI
+#define INV_2PI 0.159154943091895f    // 1 / (2 * PI)
+#define INV_SQRT3 0.577350269189626f  // 1 / √3
+
+/* 0：浮点运算；1：电压合成（Park 逆变换、Clarke 逆变换、PWM 调制、死区补偿）使用
+ * Q15 定点，电流采样、Clarke/Park 变换、PI 和角度处理仍为浮点，中断仍使用 FPU */
+#ifndef FOC_FIXED_POINT
+#define FOC_FIXED_POINT 0
+#endif
+
+/* sin/cos 计算方式：0：arm_sin_f32/arm_cos_f32；1：CORDIC 协处理器 */
+#ifndef FOC_SINCOS_CORDIC
+#define FOC_SINCOS_CORDIC 0
+#endif
+
+typedef struct {
+  float sin;
+  float cos;
+} SinCos_Typedef;
+
+/* ---------------- sin/cos 后端 Begin ---------------- */
+#if FOC_SINCOS_CORDIC
+#define Q31_TO_FLOAT 4.656612873077393e-10f // 1 / 2^31
+
+/**
+ * @brief 弧度 [0, 2PI) 转 CORDIC 角度格式（q1.31，[-1, 1) 对应 [-PI, PI)）
+ */
+static int32_t RadToQ31(float theta) {
+  float z = theta * (1.0f / PI);
+  if (z >= 1.0f)
+    z -= 2.0f;
+  return (int32_t)(z * 2147483648.0f);
+}
+#endif
+
+/**
+ * @brief 启动 sin/cos 计算，CORDIC 计算期间 CPU 可继续执行其他运算
+ * @param theta 电角度，[0, 2PI)
+ */
+static void SinCosStart(float theta) {
+#if FOC_SINCOS_CORDIC
+  CORDIC_SinCosStart(RadToQ31(theta));
+#else
+  (void)theta;
+#endif
+}
+
+/**
+ * @brief 获取 sin/cos 结果（须先调用 SinCosStart）
+ * @param theta 电角度，与 SinCosStart 传入的相同
+ */
+static void SinCosGet(float theta, SinCos_Typedef *sc) {
+#if FOC_SINCOS_CORDIC
+  int32_t sin_q31, cos_q31;
+  (void)theta;
+  CORDIC_SinCosRead(&sin_q31, &cos_q31);
+  sc->sin = (float)sin_q31 * Q31_TO_FLOAT;
+  sc->cos = (float)cos_q31 * Q31_TO_FLOAT;
+#else
+  sc->cos = arm_cos_f32(theta);
+  sc->sin = arm_sin_f32(theta);
+#endif
+}
+/* ---------------- sin/cos 后端  End  ---------------- */
 
 /* ---------------- 驱动函数 Begin ---------------- */
 /**
  * @brief Park逆变换
  * @param instance FOC实例
- * @param theta 电角度
+ * @param sc 电角度的 sin/cos
  */
-static void InPark(dq_Typedef *dq, AlphaBeta_Typedef *AlphaBeta, float theta) {
-  float cos_theta = arm_cos_f32(theta);
-  float sin_theta = arm_sin_f32(theta);
+static void InPark(dq_Typedef *dq, AlphaBeta_Typedef *AlphaBeta,
+                   const SinCos_Typedef *sc) {
+  float cos_theta = sc->cos;
+  float sin_theta = sc->sin;
 
   AlphaBeta->Alpha =
       dq->d * cos_theta - dq->q * sin_theta; // α = d  *cosθ - q * sinθ
@@ -40,168 +110,958 @@ static void InClarke(AlphaBeta_Typedef *AlphaBeta, abc_Typedef *abc) {
 }
 
 /**
- * @brief 角度限制，限制在 [-PI, PI) 内
- * @param theta 角度
+ * @brief Clarke变换（等幅值）
+ * @param abc 三相电流
+ * @param AlphaBeta AlphaBeta轴上的电流
+ */
+static void Clarke(abc_Typedef *abc, AlphaBeta_Typedef *AlphaBeta) {
+  AlphaBeta->Alpha = abc->a; // α = a
+  AlphaBeta->Beta =
+      (abc->a + 2.0f * abc->b) * INV_SQRT3; // β = (a + 2 * b) / √3
+}
+
+/**
+ * @brief Park变换
+ * @param AlphaBeta AlphaBeta轴上的电流
+ * @param dq dq轴上的电流
+ * @param sc 电角度的 sin/cos
+ */
+static void Park(AlphaBeta_Typedef *AlphaBeta, dq_Typedef *dq,
+                 const SinCos_Typedef *sc) {
+  float cos_theta = sc->cos;
+  float sin_theta = sc->sin;
+
+  dq->d = AlphaBeta->Alpha * cos_theta +
+          AlphaBeta->Beta * sin_theta; // d = α * cosθ + β * sinθ
+  dq->q = -AlphaBeta->Alpha * sin_theta +
+          AlphaBeta->Beta * cos_theta; // q = -α * sinθ + β * cosθ
+}
+
+/**
+ * @brief 角度限制，限制在 [0, 2PI) 内
+ * @param theta 角度，|theta| < 2^31 * 2PI
+ * @note 先求圈数 k 再一次减去 k * 2PI，2PI 拆成高低两部分（Cody-Waite），
+ *       k * _2PI_HI 和减法没有舍入，误差不随圈数累积
  */
 static void AngleLimit(float *theta) {
-  while (*theta >= 2 * PI) {
-    *theta -= 2 * PI;
-  }
-  while (*theta < 0) {
-    *theta += 2 * PI;
-  }
-}
-
-static void FOC_SetSPWM(FOC_Instance *instance) {
-  /* 计算 CCR */
-  uint32_t aCCR =
-      (uint32_t)((instance->param.Uabc.a + instance->param.powerVol_half) /
-                 instance->param.powerVol * instance->pwm.period);
-  uint32_t bCCR =
-      (uint32_t)((instance->param.Uabc.b + instance->param.powerVol_half) /
-                 instance->param.powerVol * instance->pwm.period);
-  uint32_t cCCR =
-      (uint32_t)((instance->param.Uabc.c + instance->param.powerVol_half) /
-                 instance->param.powerVol * instance->pwm.period);
-
-  /* 设置 CCR */
-  instance->pwm.tim->Instance->CCR1 = aCCR;
-  instance->pwm.tim->Instance->CCR2 = bCCR;
-  instance->pwm.tim->Instance->CCR3 = cCCR;
-}
-/* -------- SVPWM Begin -------- */
-/**
- * @brief 扇区判断
- * @param AlphaBeta AlphaBeta轴上的电压
- * @return 所在的扇区（1 ~ 6）
- */
-static uint8_t SecJud(AlphaBeta_Typedef AlphaBeta) {
-  float A = AlphaBeta.Beta;
-  float B = SQRT3 * AlphaBeta.Alpha - AlphaBeta.Beta;
-  float C = -SQRT3 * AlphaBeta.Alpha - AlphaBeta.Beta;
-
-  uint8_t sum = 0;
-  uint8_t sector = 0;
-
-  if (A > 0)
-    sum += 1;
-  if (B > 0)
-    sum += 2;
-  if (C > 0)
-    sum += 4;
-
-  switch (sum) {
-  case 3:
-    sector = 1;
-    break;
-  case 1:
-    sector = 2;
-    break;
-  case 5:
-    sector = 3;
-    break;
-  case 4:
-    sector = 4;
-    break;
-  case 6:
-    sector = 5;
-    break;
-  case 2:
-    sector = 6;
-    break;
+  float x = *theta;
+  if (x >= 0.0f && x < _2PI)
+    return;
+
+  float k = (float)(int32_t)(x * INV_2PI);
+  if (x < 0.0f)
+    k -= 1.0f;
+  x = (x - k * _2PI_HI) - k * _2PI_LO;
+
+  /* x * INV_2PI 的舍入可能使 k 差一圈 */
+  if (x >= _2PI)
+    x -= _2PI;
+  if (x < 0.0f)
+    x += _2PI;
+  /* 绝对值极小的负数加 2PI 后舍入为 2PI 本身 */
+  if (x >= _2PI)
+    x = 0.0f;
+  *theta = x;
+}
+
+/**
+ * @brief 读取三相电流（需在 ADC 注入转换完成回调中调用）
+ * @param instance FOC实例
+ * @return 0：电流有效；1：零偏校准中
+ */
+static uint8_t CurrentSample(FOC_Instance *instance) {
+  FOC_CurrentSense *isense = &instance->isense;
+  float raw_a =
+      (float)HAL_ADCEx_InjectedGetValue(isense->adc, ADC_INJECTED_RANK_1);
+  float raw_c =
+      (float)HAL_ADCEx_InjectedGetValue(isense->adc, ADC_INJECTED_RANK_2);
+
+  /* 上电后先累计零电流时的采样值作为零偏 */
+  if (isense->offset_cnt < FOC_CURRENT_OFFSET_SAMPLES) {
+    isense->offset_a += raw_a;
+    isense->offset_c += raw_c;
+    if (++isense->offset_cnt == FOC_CURRENT_OFFSET_SAMPLES) {
+      isense->offset_a /= FOC_CURRENT_OFFSET_SAMPLES;
+      isense->offset_c /= FOC_CURRENT_OFFSET_SAMPLES;
+    }
+    return 1;
   }
 
-  return sector;
+  /* INA240 采样 A、C 两相，B 相由基尔霍夫电流定律得到 */
+  instance->param.Iabc.a = (raw_a - isense->offset_a) * isense->gain;
+  instance->param.Iabc.c = (raw_c - isense->offset_c) * isense->gain;
+  instance->param.Iabc.b = -instance->param.Iabc.a - instance->param.Iabc.c;
+  return 0;
 }
 
-static void SetSVPWM(FOC_Instance *instance) {
-  uint8_t sector = SecJud(instance->param.UAlphaBeta);
+/**
+ * @brief 当前调制方式允许的最大调制比
+ */
+static float ModulationMax(FOC_Instance *instance) {
+  return (instance->pwm.modulation == FOC_SPWM) ? FOC_MI_SPWM
+                                                : instance->pwm.mi_max;
+}
 
-  float tmp = (float)instance->pwm.period * SQRT3 / instance->param.powerVol;
-  float X = tmp * (instance->param.UAlphaBeta.Beta);
-  float Y = tmp * (instance->param.UAlphaBeta.Alpha * SQRT3_DIV2 +
-                   instance->param.UAlphaBeta.Beta * 0.5f);
-  float Z = tmp * (-instance->param.UAlphaBeta.Alpha * SQRT3_DIV2 +
-                   instance->param.UAlphaBeta.Beta * 0.5f);
+/**
+ * @brief 是否按六边形限幅（仅零序注入到 min-max 的调制方式有完整的六边形线性区）
+ */
+static uint8_t HexagonLimited(FOC_Instance *instance) {
+  return instance->pwm.limit_shape == FOC_VLIMIT_HEXAGON &&
+         instance->pwm.modulation != FOC_SPWM &&
+         instance->pwm.modulation != FOC_THIPWM;
+}
 
-  float T1, T2, T0;
-  switch (sector) {
-  case 1:
-    T1 = -Z;
-    T2 = X;
-    break;
-  case 2:
-    T1 = Z;
-    T2 = Y;
-    break;
-  case 3:
-    T1 = X;
-    T2 = -Y;
-    break;
-  case 4:
-    T1 = -X;
-    T2 = Z;
-    break;
-  case 5:
-    T1 = -Y;
-    T2 = -Z;
-    break;
-  case 6:
-    T1 = Y;
-    T2 = -X;
-    break;
+/**
+ * @brief 允许输出的最大电压矢量幅值（V），六边形限幅时为顶点方向的幅值
+ */
+static float VoltageMax(FOC_Instance *instance) {
+  float mi = HexagonLimited(instance) ? FOC_MI_HEXAGON : ModulationMax(instance);
+  return mi * (2.0f / PI) * instance->param.powerVol;
+}
+
+/**
+ * @brief 将本周期的 Vbus 采样写入低通滤波器，FMAC 计算与之后的
+ *        Clarke/Park 变换、PI 调节并行，结果在 VBusUpdate 中取回
+ * @param instance FOC实例
+ */
+static void VBusStart(FOC_Instance *instance) {
+  FOC_VBusSense *vbus = &instance->vbus;
+  if (vbus->adc == NULL || vbus->pending)
+    return;
+  Filter_Start(vbus->filter, (float)vbus->buf[vbus->rank] * vbus->gain);
+  vbus->pending = 1;
+}
+
+/**
+ * @brief 更新母线电压（每个 PWM 周期调用一次）
+ *        滤波后的 Vbus 写回 powerVol，1 / Vbus 只在此处计算一次，
+ *        之后的电压到占空比转换均使用 powerVol_inv
+ * @param instance FOC实例
+ */
+static void VBusUpdate(FOC_Instance *instance) {
+  FOC_VBusSense *vbus = &instance->vbus;
+  if (vbus->adc == NULL)
+    return;
+
+  /* 电流环以外的调用路径（开环、校准、辨识）未提前写入采样 */
+  VBusStart(instance);
+  vbus->pending = 0;
+  float vdc = Filter_Finish(vbus->filter);
+  instance->param.powerVol = vdc;
+
+  if (vdc < vbus->uv)
+    vbus->status = FOC_VBUS_UNDER;
+  else if (vdc > vbus->ov)
+    vbus->status = FOC_VBUS_OVER;
+  else
+    vbus->status = FOC_VBUS_NORMAL;
+
+  if (vdc < FOC_VBUS_MIN)
+    vdc = FOC_VBUS_MIN;
+  instance->param.powerVol_half = 0.5f * vdc;
+  instance->param.powerVol_inv = 1.0f / vdc;
+
+  /* 电流环输出上限随母线电压变化 */
+  instance->pi_d.out_max = VoltageMax(instance);
+  instance->pi_q.out_max = instance->pi_d.out_max;
+}
+
+/**
+ * @brief 电压反馈弱磁：调制比需求超过 mi_ref * mi_max 时，积分出负的 Id 给定；
+ *        需求回落后积分回零。积分限制在 [-id_max, 0] 内，不会饱和
+ * @note 使用上一 PWM 周期的调制比需求
+ * @param instance FOC实例
+ */
+static void FieldWeakening(FOC_Instance *instance) {
+  FOC_FieldWeakening *fw = &instance->fw;
+  float err = fw->mi_ref * ModulationMax(instance) - instance->pwm.mi_demand;
+
+  fw->id += fw->ki * instance->pwm.Ts * err;
+  fw->id = (fw->id > 0.0f) ? 0.0f : fw->id;
+  fw->id = (fw->id < -fw->id_max) ? -fw->id_max : fw->id;
+}
+
+/**
+ * @brief dq 轴解耦前馈：由电角速度和电机参数计算交叉耦合项和反电动势，
+ *        用实测 Idq 计算，与电流环输出相加后 PI 只需处理剩余误差
+ * @param instance FOC实例
+ */
+static void Decouple(FOC_Instance *instance) {
+  FOC_Decouple *dc = &instance->decouple;
+  float angle = instance->param.angle_electrical;
+
+  if (instance->angle_source == FOC_ANGLE_OBSERVER) {
+    dc->omega = instance->observer->speed;
+  } else if (instance->angle_source == FOC_ANGLE_HFI) {
+    dc->omega = instance->hfi->speed;
+  } else if (dc->valid) {
+    float delta = angle - dc->angle_last;
+    if (delta > PI)
+      delta -= 2.0f * PI;
+    else if (delta < -PI)
+      delta += 2.0f * PI;
+    dc->omega += FOC_DECOUPLE_ALPHA * (delta / instance->pwm.Ts - dc->omega);
   }
-  if (T1 + T2 > instance->pwm.period) { // 防止 T1，T2 超过周期
-    T1 = instance->pwm.period * T1 / (T1 + T2);
-    T2 = instance->pwm.period * T2 / (T1 + T2);
+  dc->angle_last = angle;
+  dc->valid = 1;
+
+  FOC_MotorParam *p = &instance->param;
+  dc->ud = -dc->omega * p->Lq * p->Idq.q;
+  dc->uq = dc->omega * (p->Ld * p->Idq.d + p->flux);
+}
+
+/**
+ * @brief 电压延迟补偿：Udq 超前旋转 δ = ω * FOC_DECOUPLE_DELAY * Ts，
+ *        δ 很小，sin、cos 取二阶近似，与 Park 变换共用的 sin/cos 不变
+ * @param instance FOC实例
+ */
+static void DelayCompensate(FOC_Instance *instance) {
+  float delta = instance->decouple.omega * FOC_DECOUPLE_DELAY * instance->pwm.Ts;
+  float c = 1.0f - 0.5f * delta * delta;
+  float d = instance->param.Udq.d;
+  float q = instance->param.Udq.q;
+  instance->param.Udq.d = c * d - delta * q;
+  instance->param.Udq.q = delta * d + c * q;
+}
+
+/**
+ * @brief 电流矢量限幅，Id 优先，Iq 取剩余幅值
+ * @param instance FOC实例
+ * @param Id d 轴电流给定
+ * @param Iq q 轴电流给定
+ */
+static void CurrentLimit(FOC_Instance *instance, float *Id, float *Iq) {
+  float max = instance->current_max;
+  if (max <= 0.0f)
+    return;
+
+  *Id = (*Id > max) ? max : *Id;
+  *Id = (*Id < -max) ? -max : *Id;
+  float iq_max;
+  arm_sqrt_f32(max * max - *Id * *Id, &iq_max);
+  *Iq = (*Iq > iq_max) ? iq_max : *Iq;
+  *Iq = (*Iq < -iq_max) ? -iq_max : *Iq;
+}
+
+/* -------- PWM 调制 Begin -------- */
+/* 所有调制方式统一为相电压叠加零序分量 u0 后按 SPWM 输出：
+ * CCR = (U + u0 + Vdc / 2) / Vdc * period
+ * 零序分量只用 max/min 的条件选择计算，与电压矢量所在扇区无关，
+ * 给定调制方式时每次调用的运算量固定。 */
+static float Max3(float a, float b, float c) {
+  float m = (a > b) ? a : b;
+  return (m > c) ? m : c;
+}
+
+static float Min3(float a, float b, float c) {
+  float m = (a < b) ? a : b;
+  return (m < c) ? m : c;
+}
+
+/**
+ * @brief 计算零序分量
+ * @param instance FOC实例
+ * @param U 三相电压
+ * @return 零序分量 u0
+ */
+static float ZeroSequence(FOC_Instance *instance, abc_Typedef *U) {
+  float max = Max3(U->a, U->b, U->c);
+  float min = Min3(U->a, U->b, U->c);
+  float top = instance->param.powerVol_half - max;     // 最大相钳位到 +Vdc/2
+  float bottom = -instance->param.powerVol_half - min; // 最小相钳位到 -Vdc/2
+
+  /* 过调制区统一使用 min-max 零序分量 */
+  if (instance->pwm.mi > FOC_MI_LINEAR)
+    return -0.5f * (max + min);
+
+  switch (instance->pwm.modulation) {
+  case FOC_SVPWM:
+    return -0.5f * (max + min);
+  case FOC_THIPWM: {
+    /* u0 = -(V / 6) * cos3θ，由 ua * ub * uc = V^3 * cos3θ / 4、
+     * ua^2 + ub^2 + uc^2 = 3 * V^2 / 2 得 u0 = -ua * ub * uc / Σu^2 */
+    float sq = U->a * U->a + U->b * U->b + U->c * U->c;
+    return -U->a * U->b * U->c / (sq + 1e-9f);
+  }
+  case FOC_DPWM0: {
+    /* 线电压 ua - ub 等超前相电压 30°，用其判断钳位方向 */
+    float lmax = Max3(U->a - U->b, U->b - U->c, U->c - U->a);
+    float lmin = Min3(U->a - U->b, U->b - U->c, U->c - U->a);
+    return (lmax + lmin >= 0.0f) ? top : bottom;
+  }
+  case FOC_DPWM1:
+    return (max + min >= 0.0f) ? top : bottom;
+  case FOC_DPWM2: {
+    /* 线电压 ua - uc 等滞后相电压 30° */
+    float lmax = Max3(U->a - U->c, U->b - U->a, U->c - U->b);
+    float lmin = Min3(U->a - U->c, U->b - U->a, U->c - U->b);
+    return (lmax + lmin >= 0.0f) ? top : bottom;
   }
-  T0 = (float)instance->pwm.period - T1 - T2;
+  case FOC_DPWM3:
+    return (max + min >= 0.0f) ? bottom : top;
+  case FOC_SPWM:
+  default:
+    return 0.0f;
+  }
+}
 
-  abc_Typedef Tabc;
-  Tabc.a = T0 / 4.0f;
-  Tabc.b = Tabc.a + T1 / 2.0f;
-  Tabc.c = Tabc.b + T2 / 2.0f;
+/* 过调制：参考电压放大 om_gain 倍后按 min-max 零序注入，超出 ±Vdc / 2 的相电压被钳位。
+ * 放大后的轨迹先沿六边形边运行（I 区，mi ≤ FOC_MI_OM1），再逐渐停留在顶点（II 区），
+ * om_gain → ∞ 时即为六步运行，基波幅值随 mi 连续变化。
+ * 表中为 1 / om_gain，按 mi 在 [FOC_MI_LINEAR, 1] 上等间隔离线数值求得，
+ * 线性插值后基波误差小于 0.15%。 */
+#define OVERMOD_TABLE_SIZE 17
+#define OVERMOD_GAIN_MAX 1000.0f // mi = 1 时的增益，已等效为六步运行
 
-  uint32_t aCCR, bCCR, cCCR;
-  switch (sector) {
-  case 1:
-    aCCR = (uint32_t)Tabc.a;
-    bCCR = (uint32_t)Tabc.b;
-    cCCR = (uint32_t)Tabc.c;
-    break;
-  case 2:
-    aCCR = (uint32_t)Tabc.b;
-    bCCR = (uint32_t)Tabc.a;
-    cCCR = (uint32_t)Tabc.c;
-    break;
-  case 3:
-    aCCR = (uint32_t)Tabc.c;
-    bCCR = (uint32_t)Tabc.a;
-    cCCR = (uint32_t)Tabc.b;
-    break;
-  case 4:
-    aCCR = (uint32_t)Tabc.c;
-    bCCR = (uint32_t)Tabc.b;
-    cCCR = (uint32_t)Tabc.a;
-    break;
-  case 5:
-    aCCR = (uint32_t)Tabc.b;
-    bCCR = (uint32_t)Tabc.c;
-    cCCR = (uint32_t)Tabc.a;
+static const float overmod_gain_inv[OVERMOD_TABLE_SIZE] = {
+    1.000000f, 0.998821f, 0.996230f, 0.992282f, 0.986788f, 0.979386f,
+    0.969423f, 0.955541f, 0.934022f, 0.888691f, 0.830075f, 0.764411f,
+    0.689699f, 0.602496f, 0.496192f, 0.353885f, 0.000000f,
+};
 
-    break;
-  case 6:
-    aCCR = (uint32_t)Tabc.a;
-    bCCR = (uint32_t)Tabc.c;
-    cCCR = (uint32_t)Tabc.b;
-    break;
+/**
+ * @brief 查表得到过调制增益
+ * @param mi 调制比，(FOC_MI_LINEAR, 1]
+ */
+static float OvermodulationGain(float mi) {
+  float x = (mi - FOC_MI_LINEAR) *
+            ((OVERMOD_TABLE_SIZE - 1) / (1.0f - FOC_MI_LINEAR));
+  int32_t i = (int32_t)x;
+  if (i >= OVERMOD_TABLE_SIZE - 1)
+    return OVERMOD_GAIN_MAX;
+  float g = overmod_gain_inv[i] +
+            (overmod_gain_inv[i + 1] - overmod_gain_inv[i]) * (x - (float)i);
+  return (g * OVERMOD_GAIN_MAX > 1.0f) ? 1.0f / g : OVERMOD_GAIN_MAX;
+}
+
+/**
+ * @brief 沿 Udq 方向到六边形线性区边界的调制比
+ * @note 线电压最大差值等于 Vdc 时到达边界，边中点为 FOC_MI_LINEAR，顶点为 FOC_MI_HEXAGON
+ * @param Udq 电压矢量
+ * @param mag 电压矢量幅值
+ * @param sc 电角度的 sin/cos
+ */
+static float HexagonLimit(const dq_Typedef *Udq, float mag,
+                          const SinCos_Typedef *sc) {
+  float alpha = Udq->d * sc->cos - Udq->q * sc->sin;
+  float beta = SQRT3_DIV2 * (Udq->d * sc->sin + Udq->q * sc->cos);
+  float ua = alpha, ub = beta - 0.5f * alpha, uc = -beta - 0.5f * alpha;
+  float spread = Max3(ua, ub, uc) - Min3(ua, ub, uc);
+  if (spread <= 1e-6f * mag || mag <= 0.0f)
+    return FOC_MI_LINEAR;
+  return (PI / 2.0f) * mag / spread;
+}
+
+/**
+ * @brief 电压矢量幅值限制在 max 以内，按 priority 在 d、q 轴之间分配
+ * @param Udq 电压矢量
+ * @param mag 电压矢量幅值
+ * @param max 幅值上限（V）
+ * @param priority 分配方式
+ */
+static void VectorLimit(dq_Typedef *Udq, float mag, float max,
+                        FOC_VLimitPriority priority) {
+  if (mag <= max)
+    return;
+  if (priority == FOC_VLIMIT_PROPORTIONAL) {
+    Udq->d *= max / mag;
+    Udq->q *= max / mag;
+    return;
+  }
+
+  float *first = (priority == FOC_VLIMIT_D_PRIORITY) ? &Udq->d : &Udq->q;
+  float *second = (priority == FOC_VLIMIT_D_PRIORITY) ? &Udq->q : &Udq->d;
+  *first = (*first > max) ? max : *first;
+  *first = (*first < -max) ? -max : *first;
+  float rest;
+  arm_sqrt_f32(max * max - *first * *first, &rest);
+  *second = (*second > rest) ? rest : *second;
+  *second = (*second < -rest) ? -rest : *second;
+}
+
+/**
+ * @brief 电压矢量限幅：计算调制比，超出圆形（mi_max）或六边形边界时按
+ *        limit_priority 缩小 Udq，记录削去的电压供反算抗饱和，并确定过调制增益
+ * @param instance FOC实例
+ * @param sc 电角度的 sin/cos，六边形限幅时使用，为 NULL 时按圆形
+ */
+static void ModulationLimit(FOC_Instance *instance, const SinCos_Typedef *sc) {
+  dq_Typedef *Udq = &instance->param.Udq;
+  dq_Typedef demand = *Udq;
+  float mi_max = ModulationMax(instance);
+  float k = instance->param.powerVol_inv * (PI / 2.0f); // V 转调制比
+  uint8_t hexagon = HexagonLimited(instance) && sc != NULL;
+  float mag;
+  arm_sqrt_f32(Udq->d * Udq->d + Udq->q * Udq->q, &mag);
+  float mi = mag * k;
+  float limit = hexagon ? HexagonLimit(Udq, mag, sc) : mi_max;
+
+  /* 按到达边界的比例折算，弱磁阈值与限幅形状无关 */
+  instance->pwm.mi_demand = mi * (mi_max / limit);
+  if (mi > limit) {
+    VectorLimit(Udq, mag, limit / k, instance->pwm.limit_priority);
+    arm_sqrt_f32(Udq->d * Udq->d + Udq->q * Udq->q, &mag);
+    /* 优先级分配改变了矢量方向，按新方向的六边形边界再等比例缩小一次 */
+    if (hexagon && instance->pwm.limit_priority != FOC_VLIMIT_PROPORTIONAL) {
+      limit = HexagonLimit(Udq, mag, sc);
+      if (mag * k > limit) {
+        VectorLimit(Udq, mag, limit / k, FOC_VLIMIT_PROPORTIONAL);
+        mag = limit / k;
+      }
+    }
+    mi = mag * k;
+  }
+  instance->pwm.excess.d = Udq->d - demand.d;
+  instance->pwm.excess.q = Udq->q - demand.q;
+  instance->pwm.mi = mi;
+  instance->pwm.om_gain =
+      (!hexagon && mi > FOC_MI_LINEAR) ? OvermodulationGain(mi) : 1.0f;
+}
+
+/**
+ * @brief 相电流方向的平滑符号函数，电流在 ±band 内线性过渡，避免过零时补偿量跳变
+ */
+static float DeadTimeSign(float current, float band_inv) {
+  float s = current * band_inv;
+  s = (s > 1.0f) ? 1.0f : s;
+  s = (s < -1.0f) ? -1.0f : s;
+  return s;
+}
+
+/**
+ * @brief 死区补偿：按相电流方向补偿死区和开关延迟损失的占空比
+ * @param instance FOC实例
+ * @param duty 三相补偿占空比（输出）
+ */
+static void DeadTimeComp(FOC_Instance *instance, abc_Typedef *duty) {
+  FOC_DeadTimeComp *dtc = &instance->dtc;
+  abc_Typedef *I = &instance->param.Iabc;
+
+  duty->a = dtc->duty * DeadTimeSign(I->a, dtc->band_inv);
+  duty->b = dtc->duty * DeadTimeSign(I->b, dtc->band_inv);
+  duty->c = dtc->duty * DeadTimeSign(I->c, dtc->band_inv);
+}
+
+/**
+ * @brief 由 TIM BDTR 寄存器的 DTG 字段计算死区时间
+ * @param tim 定时器
+ * @return 死区时间（s）
+ */
+static float DeadTimeFromBDTR(TIM_HandleTypeDef *tim) {
+  uint32_t dtg = tim->Instance->BDTR & TIM_BDTR_DTG;
+  uint32_t ckd = (tim->Instance->CR1 & TIM_CR1_CKD) >> TIM_CR1_CKD_Pos;
+  float t_dts = (float)(1U << ckd) / (float)HAL_RCC_GetPCLK2Freq();
+  uint32_t n;
+
+  if ((dtg & 0x80U) == 0U)
+    n = dtg;
+  else if ((dtg & 0xC0U) == 0x80U)
+    n = (64U + (dtg & 0x3FU)) * 2U;
+  else if ((dtg & 0xE0U) == 0xC0U)
+    n = (32U + (dtg & 0x1FU)) * 8U;
+  else
+    n = (32U + (dtg & 0x1FU)) * 16U;
+  return (float)n * t_dts;
+}
+
+/**
+ * @brief 相电压转 CCR，并限制在 [0, period]
+ */
+static uint32_t VoltageToCCR(float u, float k, float period) {
+  float ccr = u * k + 0.5f * period;
+  ccr = (ccr > period) ? period : ccr;
+  ccr = (ccr < 0.0f) ? 0.0f : ccr;
+  return (uint32_t)ccr;
+}
+
+/**
+ * @brief 根据 Uabc 和调制方式设置 CCR
+ * @param instance FOC实例
+ */
+static void SetPWM(FOC_Instance *instance) {
+  float g = instance->pwm.om_gain;
+  abc_Typedef U = {instance->param.Uabc.a * g, instance->param.Uabc.b * g,
+                   instance->param.Uabc.c * g};
+  float u0 = ZeroSequence(instance, &U);
+  float period = (float)instance->pwm.period;
+  float k = instance->param.powerVol_inv * period;
+
+  /* 死区补偿在零序注入之后叠加，补偿量换算为相电压 */
+  if (instance->dtc.enable) {
+    abc_Typedef duty;
+    DeadTimeComp(instance, &duty);
+    U.a += duty.a * instance->param.powerVol;
+    U.b += duty.b * instance->param.powerVol;
+    U.c += duty.c * instance->param.powerVol;
   }
 
-  instance->pwm.tim->Instance->CCR1 = aCCR;
-  instance->pwm.tim->Instance->CCR2 = bCCR;
-  instance->pwm.tim->Instance->CCR3 = cCCR;
+  instance->pwm.tim->Instance->CCR1 = VoltageToCCR(U.a + u0, k, period);
+  instance->pwm.tim->Instance->CCR2 = VoltageToCCR(U.b + u0, k, period);
+  instance->pwm.tim->Instance->CCR3 = VoltageToCCR(U.c + u0, k, period);
+}
+/* -------- PWM 调制  End  -------- */
+#if FOC_FIXED_POINT
+/* -------- Q15 定点 Begin -------- */
+/* 电压以母线电压为基值归一化，Q15 的 1.0 对应 Vdc；
+ * 角度 [0, 2PI) 对应 Q15 的 [0, 1)，与 arm_sin_q15 的输入一致。
+ * 浮点只出现在入口：Udq、电角度和死区补偿的相电流各经一次乘法转换为 Q15，
+ * 单次乘法不会被编译器合并为 FMA，此后到 CCR 全部为整数运算，
+ * 主机构建（Sim/Src/sim_dsp.c 移植的 CMSIS 查表插值）与目标板的 CCR 逐位一致，
+ * 由 Sim/Test/test_q15.c 的黄金向量检查。 */
+#define Q15_HALF 16384              // 0.5
+#define Q15_SQRT3_DIV2 28378        // √3 / 2
+#define Q15_RAD_SCALE 5215.1891752f // 32768 / 2PI
+#define FOC_MI_MAX_Q15 0.98f        // 过调制增益放大后的电压矢量须在 Q15 范围内
+
+typedef struct {
+  q15_t Alpha;
+  q15_t Beta;
+} AlphaBeta_q15_Typedef;
+
+typedef struct {
+  q15_t a;
+  q15_t b;
+  q15_t c;
+} abc_q15_Typedef;
+
+/**
+ * @brief 浮点数转 Q15（饱和）
+ */
+static q15_t FloatToQ15(float x) {
+  if (x >= 1.0f)
+    return Q15_MAX;
+  if (x <= -1.0f)
+    return Q15_MIN;
+  return (q15_t)(x * 32768.0f);
+}
+
+/**
+ * @brief 两组 Q15 的点积，结果右移 15 位并饱和为 Q15（SMLAD 双 MAC）
+ * @param x 低 16 位、高 16 位各存放一个 Q15
+ * @param y 低 16 位、高 16 位各存放一个 Q15
+ */
+static q15_t DotQ15(uint32_t x, uint32_t y) {
+  return (q15_t)__SSAT((q31_t)__SMLAD(x, y, 0) >> 15, 16);
+}
+
+/**
+ * @brief Park逆变换（Q15）
+ * @param d 直轴电压（标幺）
+ * @param q 交轴电压（标幺）
+ * @param theta 电角度（Q15，[0, 1) 对应 [0, 2PI)）
+ */
+static void InPark_q15(q15_t d, q15_t q, q15_t theta,
+                       AlphaBeta_q15_Typedef *AlphaBeta) {
+  q15_t cos_theta = arm_cos_q15(theta);
+  q15_t sin_theta = arm_sin_q15(theta);
+  q15_t neg_sin_theta = (q15_t)__SSAT(-(q31_t)sin_theta, 16);
+  uint32_t dq = __PKHBT(d, q, 16);
+
+  AlphaBeta->Alpha = DotQ15(dq, __PKHBT(cos_theta, neg_sin_theta,
+                                        16)); // α = d * cosθ - q * sinθ
+  AlphaBeta->Beta =
+      DotQ15(dq, __PKHBT(sin_theta, cos_theta, 16)); // β = d * sinθ + q * cosθ
+}
+
+/**
+ * @brief Clarke逆变换（Q15）
+ */
+static void InClarke_q15(AlphaBeta_q15_Typedef *AlphaBeta,
+                         abc_q15_Typedef *abc) {
+  uint32_t ab = __PKHBT(AlphaBeta->Alpha, AlphaBeta->Beta, 16);
+
+  abc->a = AlphaBeta->Alpha; // a = α
+  abc->b = DotQ15(ab, __PKHBT(-Q15_HALF, Q15_SQRT3_DIV2,
+                              16)); // b = (-α + √3 * β) / 2
+  abc->c = DotQ15(ab, __PKHBT(-Q15_HALF, -Q15_SQRT3_DIV2,
+                              16)); // c = (-α - √3 * β) / 2
+}
+
+static q15_t Max3_q15(q15_t a, q15_t b, q15_t c) {
+  q15_t m = (a > b) ? a : b;
+  return (m > c) ? m : c;
+}
+
+static q15_t Min3_q15(q15_t a, q15_t b, q15_t c) {
+  q15_t m = (a < b) ? a : b;
+  return (m < c) ? m : c;
+}
+
+/**
+ * @brief 计算零序分量（Q15），THIPWM 在定点下按 SVPWM 处理
+ */
+static q31_t ZeroSequence_q15(FOC_Instance *instance, abc_q15_Typedef *U) {
+  q31_t max = Max3_q15(U->a, U->b, U->c);
+  q31_t min = Min3_q15(U->a, U->b, U->c);
+  q31_t top = Q15_HALF - max;
+  q31_t bottom = -Q15_HALF - min;
+
+  if (instance->pwm.mi > FOC_MI_LINEAR)
+    return -((max + min) >> 1);
+
+  switch (instance->pwm.modulation) {
+  case FOC_SVPWM:
+  case FOC_THIPWM:
+    return -((max + min) >> 1);
+  case FOC_DPWM0: {
+    q31_t la = (q31_t)U->a - U->b, lb = (q31_t)U->b - U->c,
+          lc = (q31_t)U->c - U->a;
+    q31_t lmax = (la > lb) ? la : lb, lmin = (la < lb) ? la : lb;
+    lmax = (lmax > lc) ? lmax : lc;
+    lmin = (lmin < lc) ? lmin : lc;
+    return (lmax + lmin >= 0) ? top : bottom;
+  }
+  case FOC_DPWM1:
+    return (max + min >= 0) ? top : bottom;
+  case FOC_DPWM2: {
+    q31_t la = (q31_t)U->a - U->c, lb = (q31_t)U->b - U->a,
+          lc = (q31_t)U->c - U->b;
+    q31_t lmax = (la > lb) ? la : lb, lmin = (la < lb) ? la : lb;
+    lmax = (lmax > lc) ? lmax : lc;
+    lmin = (lmin < lc) ? lmin : lc;
+    return (lmax + lmin >= 0) ? top : bottom;
+  }
+  case FOC_DPWM3:
+    return (max + min >= 0) ? bottom : top;
+  case FOC_SPWM:
+  default:
+    return 0;
+  }
+}
+
+/**
+ * @brief 标幺相电压转 CCR：CCR = (U + 0.5) * period，限制在 [0, period]
+ */
+static uint32_t Q15ToCCR(q31_t u, uint32_t period) {
+  q31_t duty = u + Q15_HALF;
+  duty = (duty > 32768) ? 32768 : duty;
+  duty = (duty < 0) ? 0 : duty;
+  return ((uint32_t)duty * period) >> 15;
+}
+
+/**
+ * @brief 根据 Uabc（Q15）和调制方式设置 CCR
+ */
+static void SetPWM_q15(FOC_Instance *instance, abc_q15_Typedef *U) {
+  q31_t u0 = ZeroSequence_q15(instance, U);
+  uint32_t period = instance->pwm.period;
+  q31_t ca = 0, cb = 0, cc = 0;
+
+  /* 死区补偿：I / band 饱和到 ±1 即平滑符号函数，与补偿占空比相乘 */
+  FOC_DeadTimeComp *dtc = &instance->dtc;
+  if (dtc->enable) {
+    abc_Typedef *I = &instance->param.Iabc;
+    ca = ((q31_t)dtc->duty_q15 * FloatToQ15(I->a * dtc->band_inv)) >> 15;
+    cb = ((q31_t)dtc->duty_q15 * FloatToQ15(I->b * dtc->band_inv)) >> 15;
+    cc = ((q31_t)dtc->duty_q15 * FloatToQ15(I->c * dtc->band_inv)) >> 15;
+  }
+
+  instance->pwm.tim->Instance->CCR1 = Q15ToCCR(U->a + u0 + ca, period);
+  instance->pwm.tim->Instance->CCR2 = Q15ToCCR(U->b + u0 + cb, period);
+  instance->pwm.tim->Instance->CCR3 = Q15ToCCR(U->c + u0 + cc, period);
+}
+
+/**
+ * @brief 定点电压合成：Udq、电角度转换为 Q15 后经 Park 逆变换、Clarke 逆变换设置 CCR，
+ *        过调制增益在转换为标幺值时计入；回写 UAlphaBeta（V）供观测器使用
+ */
+static void SetVoltage_q15(FOC_Instance *instance) {
+  float k = instance->pwm.om_gain * instance->param.powerVol_inv;
+  q15_t d = FloatToQ15(instance->param.Udq.d * k);
+  q15_t q = FloatToQ15(instance->param.Udq.q * k);
+  q15_t theta =
+      (q15_t)((q31_t)(instance->param.angle_electrical * Q15_RAD_SCALE) &
+              0x7FFF);
+
+  AlphaBeta_q15_Typedef UAlphaBeta;
+  abc_q15_Typedef Uabc;
+  PROFILE_BEGIN(foc_inpark);
+  InPark_q15(d, q, theta, &UAlphaBeta);
+  PROFILE_END(foc_inpark);
+  PROFILE_BEGIN(foc_inclarke);
+  InClarke_q15(&UAlphaBeta, &Uabc);
+  PROFILE_END(foc_inclarke);
+  PROFILE_BEGIN(foc_setpwm);
+  SetPWM_q15(instance, &Uabc);
+  PROFILE_END(foc_setpwm);
+
+  float u_scale = 1.0f / (32768.0f * k);
+  instance->param.UAlphaBeta.Alpha = UAlphaBeta.Alpha * u_scale;
+  instance->param.UAlphaBeta.Beta = UAlphaBeta.Beta * u_scale;
+}
+/* -------- Q15 定点  End  -------- */
+#endif
+
+/**
+ * @brief 电压合成：Udq 经 Park 逆变换、Clarke 逆变换后设置 PWM
+ * @param instance FOC实例
+ * @param sc 电角度的 sin/cos，为 NULL 时由 angle_electrical 计算
+ */
+static void SetVoltage(FOC_Instance *instance, const SinCos_Typedef *sc) {
+  VBusUpdate(instance);
+
+  /* 浮点模式的 Park 逆变换和六边形限幅需要 sin/cos */
+  SinCos_Typedef sc_tmp;
+  if (sc == NULL && (!FOC_FIXED_POINT || HexagonLimited(instance))) {
+    SinCosStart(instance->param.angle_electrical);
+    SinCosGet(instance->param.angle_electrical, &sc_tmp);
+    sc = &sc_tmp;
+  }
+  ModulationLimit(instance, sc);
+
+#if FOC_FIXED_POINT
+  (void)sc;
+  /* 定点模式下不回写 Uabc */
+  SetVoltage_q15(instance);
+#else
+  /* 通过 Park 逆变换和 Clarke 逆变换，将 Uqd 转换为 Uabc */
+  PROFILE_BEGIN(foc_inpark);
+  InPark(&instance->param.Udq, &instance->param.UAlphaBeta, sc);
+  PROFILE_END(foc_inpark);
+  PROFILE_BEGIN(foc_inclarke);
+  InClarke(&instance->param.UAlphaBeta, &instance->param.Uabc);
+  PROFILE_END(foc_inclarke);
+
+  /* 根据计算得到的 Uabc 值和调制方式，设置 PWM */
+  PROFILE_BEGIN(foc_setpwm);
+  SetPWM(instance);
+  PROFILE_END(foc_setpwm);
+#endif
+}
+/* -------- 参数辨识 Begin -------- */
+/**
+ * @brief 进入下一辨识步骤，清除计数和累加值
+ */
+static void IdentNext(FOC_Ident *ident, FOC_IdentState state) {
+  ident->state = state;
+  ident->count = 0;
+  ident->step = 0;
+  ident->n = 0;
+  ident->sum_ud = 0.0f;
+  ident->sum_uq = 0.0f;
+  ident->sum_id = 0.0f;
+  ident->sum_iq = 0.0f;
+}
+
+/**
+ * @brief 稳定时间结束后累加 Udq、Idq，返回平均时间是否结束
+ */
+static uint8_t IdentAverage(FOC_Instance *instance) {
+  FOC_Ident *ident = &instance->ident;
+  uint32_t settle = (uint32_t)(FOC_IDENT_SETTLE / instance->pwm.Ts);
+  uint32_t average = (uint32_t)(FOC_IDENT_AVERAGE / instance->pwm.Ts);
+
+  if (++ident->count <= settle)
+    return 0;
+  ident->sum_ud += instance->param.Udq.d;
+  ident->sum_uq += instance->param.Udq.q;
+  ident->sum_id += instance->param.Idq.d;
+  ident->sum_iq += instance->param.Idq.q;
+  if (ident->count < settle + average)
+    return 0;
+
+  float inv = 1.0f / (float)average;
+  ident->sum_ud *= inv;
+  ident->sum_uq *= inv;
+  ident->sum_id *= inv;
+  ident->sum_iq *= inv;
+  return 1;
+}
+
+/**
+ * @brief 电阻辨识：电角度 0 处闭环通入 I / 2 和 I 两级 d 轴电流，
+ *        R = ΔU / ΔI，死区等与电流无关的电压误差被抵消
+ */
+static void IdentResistance(FOC_Instance *instance) {
+  FOC_Ident *ident = &instance->ident;
+  float current = (ident->step == 0) ? 0.5f * ident->config.current
+                                     : ident->config.current;
+  FOC_CurrentLoop(instance, current, 0.0f, 0.0f);
+  if (!IdentAverage(instance))
+    return;
+
+  if (ident->step == 0) {
+    float u = ident->sum_ud, i = ident->sum_id;
+    IdentNext(ident, FOC_IDENT_RESISTANCE);
+    ident->u1 = u;
+    ident->i1 = i;
+    ident->step = 1;
+    return;
+  }
+
+  float di = ident->sum_id - ident->i1;
+  if (di < 0.25f * ident->config.current) {
+    IdentNext(ident, FOC_IDENT_ERROR);
+    return;
+  }
+  instance->param.Rs = (ident->sum_ud - ident->u1) / di;
+  float ud = ident->sum_ud, uq = ident->sum_uq;
+  float id = ident->sum_id, iq = ident->sum_iq;
+  IdentNext(ident, FOC_IDENT_INDUCTANCE_D);
+  ident->ud = ud;
+  ident->uq = uq;
+  ident->id = id;
+  ident->iq = iq;
+}
+
+/**
+ * @brief 电感辨识：保持锁定转子的直流电压，在 d 轴或 q 轴叠加方波电压，
+ *        每个半周期跳过翻转后的 FOC_IDENT_SKIP 个采样，在剩余区间上累计
+ *        伏秒 ∫(u - Rs * (i - i_dc))dt 和电流变化 Δi，L = 伏秒 / Δi
+ * @param axis_q 0：d 轴；1：q 轴
+ */
+static void IdentInductance(FOC_Instance *instance, uint8_t axis_q) {
+  FOC_Ident *ident = &instance->ident;
+  float Ts = instance->pwm.Ts;
+  CurrentSample(instance);
+  Clarke(&instance->param.Iabc, &instance->param.IAlphaBeta);
+  /* 电角度为 0，Park 变换不改变电流 */
+  float i = axis_q ? instance->param.IAlphaBeta.Beta
+                   : instance->param.IAlphaBeta.Alpha;
+  float i_dc = axis_q ? ident->iq : ident->id;
+
+  uint32_t phase = ident->count % (2 * FOC_IDENT_HALF);
+  uint32_t index = phase % FOC_IDENT_HALF;
+  float sign = (phase < FOC_IDENT_HALF) ? 1.0f : -1.0f;
+  /* 本次采样前的区间属于哪个半周期：index 为 0 时是刚结束的半周期 */
+  float sign_last = (index == 0) ? -sign : sign;
+  if ((index > FOC_IDENT_SKIP || index == 0) && ident->count > FOC_IDENT_SKIP) {
+    float i_mid = 0.5f * (i + ident->i1) - i_dc;
+    ident->sum_ud +=
+        (ident->config.voltage - sign_last * instance->param.Rs * i_mid) * Ts;
+    if (index == 0) {
+      ident->sum_id += sign_last * (i - ident->i_start);
+      ident->n++;
+    }
+  }
+  if (index == FOC_IDENT_SKIP)
+    ident->i_start = i;
+  ident->i1 = i;
+
+  float u = sign * ident->config.voltage;
+  instance->param.Udq.d = ident->ud + (axis_q ? 0.0f : u);
+  instance->param.Udq.q = ident->uq + (axis_q ? u : 0.0f);
+  instance->param.angle_electrical = 0.0f;
+  SetVoltage(instance, NULL);
+
+  /* 在半周期结束时停止，伏秒与电流变化覆盖相同的区间 */
+  if (++ident->count < (uint32_t)(FOC_IDENT_AVERAGE / Ts) || index != 0)
+    return;
+  if (ident->n == 0 || ident->sum_id <= 0.0f) {
+    IdentNext(ident, FOC_IDENT_ERROR);
+    return;
+  }
+  float L = ident->sum_ud / ident->sum_id;
+  float ud = ident->ud, uq = ident->uq, id = ident->id, iq = ident->iq;
+  if (axis_q) {
+    instance->param.Lq = L;
+    IdentNext(ident, FOC_IDENT_FLUX);
+    ident->theta = 0.0f;
+    ident->omega = 0.0f;
+    ident->travel_elec = 0.0f;
+    ident->travel_mech = 0.0f;
+    ident->mech_last = instance->param.angle_mechanical;
+  } else {
+    instance->param.Ld = L;
+    IdentNext(ident, FOC_IDENT_INDUCTANCE_Q);
+    ident->ud = ud;
+    ident->uq = uq;
+    ident->id = id;
+    ident->iq = iq;
+  }
+}
+
+/**
+ * @brief 磁链与极对数辨识：d 轴电流开环拖动转子加速到 speed，
+ *        匀速段由 dq 电压方程扣除电阻、电感压降得到反电动势 E，ψ = |E| / ω；
+ *        全程累计开环电角度和编码器机械角度，二者之比取整即极对数
+ */
+static void IdentFlux(FOC_Instance *instance) {
+  FOC_Ident *ident = &instance->ident;
+  FOC_MotorParam *param = &instance->param;
+  float Ts = instance->pwm.Ts;
+
+  float delta = param->angle_mechanical - ident->mech_last;
+  AngleLimit(&delta);
+  if (delta > PI)
+    delta -= 2.0f * PI;
+  ident->travel_mech += delta;
+  ident->mech_last = param->angle_mechanical;
+
+  ident->omega += ident->config.accel * Ts;
+  if (ident->omega > ident->config.speed)
+    ident->omega = ident->config.speed;
+  ident->theta += ident->omega * Ts;
+  ident->travel_elec += ident->omega * Ts;
+  AngleLimit(&ident->theta);
+  FOC_CurrentLoop(instance, ident->config.current, 0.0f, ident->theta);
+
+  if (ident->omega < ident->config.speed || !IdentAverage(instance))
+    return;
+
+  float w = ident->omega;
+  float ed = ident->sum_ud - param->Rs * ident->sum_id + w * param->Lq * ident->sum_iq;
+  float eq = ident->sum_uq - param->Rs * ident->sum_iq - w * param->Ld * ident->sum_id;
+  float e;
+  arm_sqrt_f32(ed * ed + eq * eq, &e);
+
+  float travel = fabsf(ident->travel_mech);
+  float pole_pairs = (travel > 0.0f) ? ident->travel_elec / travel : 0.0f;
+  float rounded = floorf(pole_pairs + 0.5f);
+  if (rounded < 1.0f || rounded > 255.0f ||
+      fabsf(pole_pairs - rounded) > 0.25f) {
+    IdentNext(ident, FOC_IDENT_ERROR);
+    return;
+  }
+  param->flux = e / w;
+  param->pole_pairs = (uint8_t)rounded;
+  IdentNext(ident, FOC_IDENT_DONE);
+}
+/* -------- 参数辨识  End  -------- */
+
+/**
+ * @brief 零偏校准拟合：正反扫的编码器行程给出方向并校验极对数，
+ *        各锁定点的零偏 dir * p * θm - θe 取圆周平均，不受 ±PI 处跳变影响，
+ *        正反扫平均抵消摩擦造成的滞后
+ */
+static void CalibFit(FOC_Instance *instance) {
+  FOC_Calib *calib = &instance->calib;
+  FOC_MotorParam *param = &instance->param;
+
+  /* 正扫行程为正、反扫行程为负时方向为正 */
+  float travel = 0.0f;
+  for (uint8_t j = 1; j < 2 * FOC_CALIB_STEPS; j++) {
+    if (j == FOC_CALIB_STEPS)
+      continue;
+    float delta = calib->mech[j] - calib->mech[j - 1];
+    AngleLimit(&delta);
+    if (delta > PI)
+      delta -= 2.0f * PI;
+    travel += (j < FOC_CALIB_STEPS) ? delta : -delta;
+  }
+  float expect = 4.0f * PI * (FOC_CALIB_STEPS - 1) / FOC_CALIB_STEPS;
+  float ratio = fabsf(travel) * param->pole_pairs / expect;
+  if (ratio < 0.75f || ratio > 1.25f) {
+    calib->state = FOC_CALIB_ERROR;
+    return;
+  }
+  int8_t direction = (travel > 0.0f) ? 1 : -1;
+
+  float sum_sin = 0.0f, sum_cos = 0.0f;
+  for (uint8_t j = 0; j < 2 * FOC_CALIB_STEPS; j++) {
+    uint8_t k = (j < FOC_CALIB_STEPS) ? j + 1 : 2 * FOC_CALIB_STEPS - 1 - j;
+    float offset = direction * param->pole_pairs * calib->mech[j] -
+                   k * (2.0f * PI / FOC_CALIB_STEPS);
+    AngleLimit(&offset);
+    sum_sin += arm_sin_f32(offset);
+    sum_cos += arm_cos_f32(offset);
+  }
+  float offset = atan2f(sum_sin, sum_cos);
+  AngleLimit(&offset);
+  param->angle_electrical_offset = offset;
+  param->direction = direction;
+  calib->state = FOC_CALIB_DONE;
 }
-/* -------- SVPWM  End  -------- */
 /* ---------------- 驱动函数  End  ---------------- */
 /* ---------------- 用户函数 Begin ---------------- */
 /**
@@ -214,17 +1074,104 @@ FOC_Instance *FOC_Register(FOC_InitTypedef *init) {
   if (init->powerVol <= 0 || init->tim == NULL || init->pole_pairs == 0)
     return NULL;
 
-  FOC_Instance *instance = (FOC_Instance *)malloc(sizeof(FOC_Instance));
+  FOC_Instance *instance = (FOC_Instance *)Pool_Alloc(&foc_pool);
   if (instance == NULL)
     return NULL;
-  memset(instance, 0, sizeof(FOC_Instance));
 
   instance->state = FOC_OpenLoopMode;
   instance->pwm.tim = init->tim;
   instance->pwm.period = (init->tim->Init.Period + 1);
+  instance->pwm.modulation = init->modulation;
+  instance->pwm.mi_max = FOC_MI_LINEAR;
+  instance->pwm.om_gain = 1.0f;
+  instance->pwm.limit_shape = init->limit_shape;
+  instance->pwm.limit_priority = init->limit_priority;
   instance->param.powerVol = init->powerVol;
   instance->param.powerVol_half = init->powerVol / 2.0f;
+  instance->param.powerVol_inv = 1.0f / init->powerVol;
   instance->param.pole_pairs = init->pole_pairs;
+  instance->param.direction = 1;
+  instance->param.Ld = init->Ld;
+  instance->param.Lq = init->Lq;
+  instance->param.flux = init->flux;
+
+  /* 中心对齐模式下计数器先增后减，一个 PWM 周期为 2 * period 个时钟 */
+  float tim_clk = (float)HAL_RCC_GetPCLK2Freq() / (init->tim->Init.Prescaler + 1);
+  if (init->tim->Init.CounterMode == TIM_COUNTERMODE_UP ||
+      init->tim->Init.CounterMode == TIM_COUNTERMODE_DOWN)
+    instance->pwm.Ts = instance->pwm.period / tim_clk;
+  else
+    instance->pwm.Ts = 2.0f * instance->pwm.period / tim_clk;
+
+  /* 电流环 */
+  instance->isense.adc = init->adc;
+  instance->isense.gain = init->current_gain;
+  PI_Init(&instance->pi_d, init->current_kp, init->current_ki,
+          instance->pwm.Ts, VoltageMax(instance));
+  PI_Init(&instance->pi_q, init->current_kp, init->current_ki,
+          instance->pwm.Ts, VoltageMax(instance));
+  float kb = init->current_kb;
+  if (kb <= 0.0f && init->current_kp > 0.0f)
+    kb = init->current_ki / init->current_kp;
+  PI_SetBackCalculation(&instance->pi_d, kb);
+  PI_SetBackCalculation(&instance->pi_q, kb);
+
+  /* 死区补偿 */
+  if (init->dt_band > 0.0f) {
+    instance->dtc.enable = 1;
+    instance->dtc.time =
+        DeadTimeFromBDTR(init->tim) + init->dt_ton - init->dt_toff;
+    instance->dtc.duty = instance->dtc.time / instance->pwm.Ts;
+    instance->dtc.band_inv = 1.0f / init->dt_band;
+    float duty_q15 = instance->dtc.duty * 32768.0f;
+    if (duty_q15 > 32767.0f)
+      duty_q15 = 32767.0f;
+    else if (duty_q15 < -32768.0f)
+      duty_q15 = -32768.0f;
+    instance->dtc.duty_q15 = (int16_t)duty_q15;
+  }
+
+  /* 弱磁 */
+  instance->current_max = init->current_max;
+  if (init->fw_id_max > 0.0f) {
+    instance->fw.enable = 1;
+    instance->fw.ki = init->fw_ki;
+    instance->fw.mi_ref =
+        (init->fw_mi_ref > 0.0f && init->fw_mi_ref <= 1.0f) ? init->fw_mi_ref
+                                                             : 0.95f;
+    instance->fw.id_max = init->fw_id_max;
+  }
+
+  /* 母线电压采样 */
+  if (init->vbus_adc != NULL &&
+      (init->vbus_adc->Init.NbrOfConversion > FOC_VBUS_CONV_MAX ||
+       init->vbus_rank >= init->vbus_adc->Init.NbrOfConversion)) {
+    Pool_Free(&foc_pool, instance);
+    return NULL;
+  }
+  instance->vbus.adc = init->vbus_adc;
+  instance->vbus.rank = init->vbus_rank;
+  instance->vbus.gain = init->vbus_gain;
+  instance->vbus.uv = init->vbus_uv;
+  instance->vbus.ov = init->vbus_ov;
+  instance->vbus.status = FOC_VBUS_NORMAL;
+
+  /* 低通滤波器：ADC 满量程映射到 FMAC 的 q1.15，从额定电压开始滤波 */
+  if (init->vbus_adc != NULL) {
+    Filter_Init_Config_s filter;
+    Filter_LowpassConfig(&filter, (init->vbus_alpha > 0.0f &&
+                                   init->vbus_alpha <= 1.0f)
+                                      ? init->vbus_alpha
+                                      : 1.0f);
+    filter.full_scale = init->vbus_gain * FOC_VBUS_ADC_FULL_SCALE;
+    filter.use_fmac = 1;
+    instance->vbus.filter = Filter_Register(&filter);
+    if (instance->vbus.filter == NULL) {
+      Pool_Free(&foc_pool, instance);
+      return NULL;
+    }
+    Filter_Preset(instance->vbus.filter, init->powerVol);
+  }
 
   return instance;
 }
@@ -238,21 +1185,111 @@ void FOC_Init(FOC_Instance *instance, float angle_electrical_offset) {
   instance->pwm.tim->Instance->CCR1 = 0;
   instance->pwm.tim->Instance->CCR2 = 0;
   instance->pwm.tim->Instance->CCR3 = 0;
+#if FOC_SINCOS_CORDIC
+  CORDIC_Init();
+#endif
   HAL_TIM_PWM_Start(instance->pwm.tim, TIM_CHANNEL_1);
   HAL_TIMEx_PWMN_Start(instance->pwm.tim, TIM_CHANNEL_1);
   HAL_TIM_PWM_Start(instance->pwm.tim, TIM_CHANNEL_2);
   HAL_TIMEx_PWMN_Start(instance->pwm.tim, TIM_CHANNEL_2);
   HAL_TIM_PWM_Start(instance->pwm.tim, TIM_CHANNEL_3);
   HAL_TIMEx_PWMN_Start(instance->pwm.tim, TIM_CHANNEL_3);
+
+  /* CH4 比较事件触发 ADC 注入转换，电流环在注入转换完成回调中执行 */
+  if (instance->isense.adc != NULL) {
+    instance->isense.offset_a = 0.0f;
+    instance->isense.offset_c = 0.0f;
+    instance->isense.offset_cnt = 0;
+    HAL_ADCEx_Calibration_Start(instance->isense.adc, ADC_SINGLE_ENDED);
+    HAL_ADCEx_InjectedStart_IT(instance->isense.adc);
+    HAL_TIM_PWM_Start(instance->pwm.tim, TIM_CHANNEL_4);
+  }
+
+  /* TIM1 TRGO（OC4REF）每个 PWM 周期触发一次 ADC2 规则序列，DMA 循环写入缓冲区，
+   * 由控制循环直接读取，因此关闭 DMA 传输完成/半传输中断 */
+  if (instance->vbus.adc != NULL) {
+    HAL_ADCEx_Calibration_Start(instance->vbus.adc, ADC_SINGLE_ENDED);
+    HAL_ADC_Start_DMA(instance->vbus.adc, (uint32_t *)instance->vbus.buf,
+                      instance->vbus.adc->Init.NbrOfConversion);
+    __HAL_DMA_DISABLE_IT(instance->vbus.adc->DMA_Handle, DMA_IT_TC | DMA_IT_HT);
+  }
 }
 
 /**
  * @brief FOC 设置模式
  */
 void FOC_SetMode(FOC_Instance *instance, FOC_ControlState mode) {
+  if (mode == FOC_CurrentLoopMode && instance->state != FOC_CurrentLoopMode) {
+    PI_Reset(&instance->pi_d);
+    PI_Reset(&instance->pi_q);
+    instance->fw.id = 0.0f;
+  }
   instance->state = mode;
 }
 
+/**
+ * @brief FOC 设置调制方式
+ */
+void FOC_SetModulation(FOC_Instance *instance, FOC_Modulation modulation) {
+  instance->pwm.modulation = modulation;
+  instance->pi_d.out_max = VoltageMax(instance);
+  instance->pi_q.out_max = instance->pi_d.out_max;
+}
+
+/**
+ * @brief FOC 设置过调制
+ * @note SPWM 不支持过调制；定点模式下受 Q15 范围限制，最大调制比为 FOC_MI_MAX_Q15
+ * @param instance FOC实例
+ * @param mi_max 最大调制比，[FOC_MI_LINEAR, 1]，FOC_MI_LINEAR 为关闭过调制，
+ *               1 为允许连续过渡到六步运行
+ */
+void FOC_SetOvermodulation(FOC_Instance *instance, float mi_max) {
+#if FOC_FIXED_POINT
+  float limit = FOC_MI_MAX_Q15;
+#else
+  float limit = 1.0f;
+#endif
+  mi_max = (mi_max > limit) ? limit : mi_max;
+  mi_max = (mi_max < FOC_MI_LINEAR) ? FOC_MI_LINEAR : mi_max;
+  instance->pwm.mi_max = mi_max;
+  instance->pi_d.out_max = VoltageMax(instance);
+  instance->pi_q.out_max = instance->pi_d.out_max;
+}
+
+/**
+ * @brief FOC 设置电压矢量限幅
+ * @note 六边形限幅在零序注入调制下可用到线性区全部电压（顶点方向比内切圆多 15.5%），
+ *       不进入过调制；限幅削去的电压经反算回馈到电流环积分
+ * @param instance FOC实例
+ * @param shape 限幅形状
+ * @param priority 超限时的分配方式，弱磁时宜用 d 轴优先，保证 Id 可控；
+ *                 q 轴优先在高速饱和时 Ud 不足，Id 可能正向偏离且不能自行恢复
+ */
+void FOC_SetVoltageLimit(FOC_Instance *instance, FOC_VLimitShape shape,
+                         FOC_VLimitPriority priority) {
+  instance->pwm.limit_shape = shape;
+  instance->pwm.limit_priority = priority;
+  instance->pi_d.out_max = VoltageMax(instance);
+  instance->pi_q.out_max = instance->pi_d.out_max;
+}
+
+/**
+ * @brief 获取当前输出的调制比
+ * @return 基波相电压幅值与六步运行基波幅值（2 * Vdc / PI）之比
+ */
+float FOC_GetModulationIndex(FOC_Instance *instance) {
+  return instance->pwm.mi;
+}
+
+/**
+ * @brief 获取电压裕量：允许的最大调制比减去上一 PWM 周期的调制比需求
+ * @note 调制比需求为限幅前的值，六边形限幅时已按边界比例折算，与弱磁使用的相同
+ * @return 调制比裕量，为负时表示需求超出上限、输出已被限幅
+ */
+float FOC_GetVoltageHeadroom(FOC_Instance *instance) {
+  return ModulationMax(instance) - instance->pwm.mi_demand;
+}
+
 /**
  * @brief FOC 开环控制
  * @param instance FOC实例
@@ -267,13 +1304,8 @@ void FOC_OpenLoop(FOC_Instance *instance, float Ud, float Uq, float angle) {
   instance->param.angle_electrical = angle;
   AngleLimit(&instance->param.angle_electrical);
 
-  /* 通过 Park 逆变换和 Clarke 逆变换，将 Uqd 转换为 Uabc */
-  InPark(&instance->param.Udq, &instance->param.UAlphaBeta,
-         instance->param.angle_electrical);
-  InClarke(&instance->param.UAlphaBeta, &instance->param.Uabc);
-
-  /* 根据计算得到的 Uabc 值，设置 SPWM */
-  FOC_SetSPWM(instance);
+  /* 将 Udq 转换为三相 PWM 输出 */
+  SetVoltage(instance, NULL);
 }
 
 /**
@@ -289,19 +1321,311 @@ void FOC_EncoderOpenLoop(FOC_Instance *instance, float Ud, float Uq,
   instance->param.Udq.d = Ud;
   instance->param.Udq.q = Uq;
   instance->param.angle_mechanical = angle;
-  instance->param.angle_electrical =
-      (float)(angle * instance->param.pole_pairs) -
-      instance->param.angle_electrical_offset;
+  instance->param.angle_electrical = FOC_ElectricalAngle(instance, angle);
   AngleLimit(&instance->param.angle_mechanical);
+
+  /* 将 Udq 转换为三相 PWM 输出 */
+  SetVoltage(instance, NULL);
+}
+
+/**
+ * @brief FOC 设置无传感器观测器，观测器在电流环中每个 PWM 周期更新
+ * @param instance FOC实例
+ * @param observer 观测器实例，为 NULL 时停止观测并切回外部角度
+ */
+void FOC_SetObserver(FOC_Instance *instance, SMO_Instance *observer) {
+  instance->observer = observer;
+  if (observer == NULL && instance->angle_source == FOC_ANGLE_OBSERVER)
+    instance->angle_source = FOC_ANGLE_EXTERNAL;
+}
+
+/**
+ * @brief FOC 设置高频注入
+ * @param instance FOC实例
+ * @param hfi 高频注入实例，为 NULL 时切回外部角度
+ */
+void FOC_SetHFI(FOC_Instance *instance, HFI_Instance *hfi) {
+  instance->hfi = hfi;
+  if (hfi == NULL && instance->angle_source == FOC_ANGLE_HFI)
+    instance->angle_source = FOC_ANGLE_EXTERNAL;
+}
+
+/**
+ * @brief FOC 设置电流环角度来源，切换到高频注入时重新收敛并辨识极性
+ */
+void FOC_SetAngleSource(FOC_Instance *instance, FOC_AngleSource source) {
+  if (source == FOC_ANGLE_OBSERVER && instance->observer == NULL)
+    return;
+  if (source == FOC_ANGLE_HFI) {
+    if (instance->hfi == NULL)
+      return;
+    if (instance->angle_source != FOC_ANGLE_HFI)
+      HFI_Reset(instance->hfi, instance->param.angle_electrical);
+  }
+  instance->angle_source = source;
+}
+
+/**
+ * @brief FOC 电流闭环控制
+ * @note 须在 ADC 注入转换完成回调（HAL_ADCEx_InjectedConvCpltCallback）中调用，
+ *       采样、计算、更新 CCR 均在同一个 PWM 周期内完成
+ * @param instance FOC实例
+ * @param Id 直轴电流目标值
+ * @param Iq 交轴电流目标值
+ * @param angle 电角度，角度来源为观测器时忽略
+ */
+void FOC_CurrentLoop(FOC_Instance *instance, float Id, float Iq, float angle) {
+  if (instance->isense.adc == NULL)
+    return;
+
+  /* 零偏校准期间输出零电压 */
+  PROFILE_BEGIN(foc_sample);
+  uint8_t calibrating = CurrentSample(instance);
+  PROFILE_END(foc_sample);
+  VBusStart(instance);
+  if (calibrating != 0) {
+    instance->param.Udq.d = 0.0f;
+    instance->param.Udq.q = 0.0f;
+    SetVoltage(instance, NULL);
+    return;
+  }
+
+  /* 观测器、高频注入在上一周期已将角度外推到本采样时刻 */
+  if (instance->angle_source == FOC_ANGLE_OBSERVER)
+    angle = instance->observer->angle;
+  else if (instance->angle_source == FOC_ANGLE_HFI)
+    angle = HFI_Angle(instance->hfi, instance->observer);
+  instance->param.angle_electrical = angle;
   AngleLimit(&instance->param.angle_electrical);
 
-  /* 通过 Park 逆变换和 Clarke 逆变换，将 Uqd 转换为 Uabc */
-  InPark(&instance->param.Udq, &instance->param.UAlphaBeta,
-         instance->param.angle_electrical);
-  InClarke(&instance->param.UAlphaBeta, &instance->param.Uabc);
+  /* 启动 sin/cos 计算，与 Clarke 变换并行，Park 变换和 Park 逆变换共用结果 */
+  SinCos_Typedef sc;
+  SinCosStart(instance->param.angle_electrical);
+
+  /* 通过 Clarke 变换和 Park 变换，将 Iabc 转换为 Idq */
+  PROFILE_BEGIN(foc_clarke);
+  Clarke(&instance->param.Iabc, &instance->param.IAlphaBeta);
+  PROFILE_END(foc_clarke);
+
+  /* 观测器输入：本周期电流和上一周期输出的电压（UAlphaBeta 尚未更新） */
+  if (instance->observer != NULL)
+    SMO_Update(instance->observer, instance->param.IAlphaBeta.Alpha,
+               instance->param.IAlphaBeta.Beta,
+               instance->param.UAlphaBeta.Alpha,
+               instance->param.UAlphaBeta.Beta);
+  SinCosGet(instance->param.angle_electrical, &sc);
+  PROFILE_BEGIN(foc_park);
+  Park(&instance->param.IAlphaBeta, &instance->param.Idq, &sc);
+  PROFILE_END(foc_park);
+
+  /* 高频注入：解调跟踪角度，Idq 替换为滤除高频分量后的基波电流 */
+  if (instance->angle_source == FOC_ANGLE_HFI) {
+    HFI_Update(instance->hfi, &instance->param.Idq.d, &instance->param.Idq.q);
+    Id += instance->hfi->id_bias;
+  }
+
+  /* 弱磁和电流限幅 */
+  if (instance->fw.enable) {
+    FieldWeakening(instance);
+    Id += instance->fw.id;
+  }
+  CurrentLimit(instance, &Id, &Iq);
+
+  /* dq 轴电流 PI 调节 */
+  instance->param.Udq.d =
+      PI_Calculate(&instance->pi_d, instance->param.Idq.d, Id);
+  instance->param.Udq.q =
+      PI_Calculate(&instance->pi_q, instance->param.Idq.q, Iq);
+  if (instance->angle_source == FOC_ANGLE_HFI)
+    instance->param.Udq.d += instance->hfi->u_inject;
+
+  /* 解耦前馈 */
+  if (instance->decouple.enable) {
+    Decouple(instance);
+    instance->param.Udq.d += instance->decouple.ud;
+    instance->param.Udq.q += instance->decouple.uq;
+    DelayCompensate(instance);
+  }
+
+  /* 将 Udq 转换为三相 PWM 输出 */
+  SetVoltage(instance, &sc);
 
-  /* 根据计算得到的 Uabc 值，设置 SPWM */
-  FOC_SetSPWM(instance);
+  /* 反算抗饱和：限幅削去的电压回馈到电流环积分 */
+  PI_BackCalculate(&instance->pi_d, instance->pwm.excess.d);
+  PI_BackCalculate(&instance->pi_q, instance->pwm.excess.q);
 }
 
+/**
+ * @brief FOC 开关 dq 轴解耦前馈，使用 instance->param 中的 Ld、Lq、flux，
+ *        参数为 0 的项不补偿
+ * @note 角度来源为外部时由相邻两周期的电角度差分测速，
+ *       为观测器、高频注入时使用其速度估计
+ * @param instance FOC实例
+ * @param enable 1：启用；0：关闭
+ */
+void FOC_SetDecoupling(FOC_Instance *instance, uint8_t enable) {
+  FOC_Decouple *dc = &instance->decouple;
+  if (enable && !dc->enable) {
+    dc->valid = 0;
+    dc->omega = 0.0f;
+  }
+  dc->ud = 0.0f;
+  dc->uq = 0.0f;
+  dc->enable = enable;
+}
+
+/**
+ * @brief FOC 启动电机参数辨识，依次辨识 Rs、Ld、Lq、磁链和极对数，
+ *        结果写入 instance->param，电机会被拖动旋转
+ * @param instance FOC实例
+ * @param config 辨识配置
+ */
+void FOC_StartIdentify(FOC_Instance *instance, FOC_IdentTypedef *config) {
+  if (instance->isense.adc == NULL || config->current <= 0.0f ||
+      config->voltage <= 0.0f || config->speed <= 0.0f ||
+      config->accel <= 0.0f) {
+    IdentNext(&instance->ident, FOC_IDENT_ERROR);
+    return;
+  }
+  instance->ident.config = *config;
+  instance->angle_source = FOC_ANGLE_EXTERNAL;
+  PI_Reset(&instance->pi_d);
+  PI_Reset(&instance->pi_q);
+  IdentNext(&instance->ident, FOC_IDENT_RESISTANCE);
+}
+
+/**
+ * @brief FOC 电机参数辨识，代替 FOC_CurrentLoop 在 ADC 注入转换完成回调中调用
+ * @param instance FOC实例
+ * @param angle_mechanical 机械角度（编码器测得，rad）
+ * @return 1：辨识进行中；0：未启动或已结束，结果见 instance->ident.state
+ */
+uint8_t FOC_Identify(FOC_Instance *instance, float angle_mechanical) {
+  FOC_Ident *ident = &instance->ident;
+  if (ident->state == FOC_IDENT_IDLE || ident->state == FOC_IDENT_DONE ||
+      ident->state == FOC_IDENT_ERROR)
+    return 0;
+
+  /* 等待电流零偏校准完成 */
+  if (instance->isense.offset_cnt < FOC_CURRENT_OFFSET_SAMPLES) {
+    FOC_CurrentLoop(instance, 0.0f, 0.0f, 0.0f);
+    return 1;
+  }
+
+  instance->param.angle_mechanical = angle_mechanical;
+  switch (ident->state) {
+  case FOC_IDENT_RESISTANCE:
+    IdentResistance(instance);
+    break;
+  case FOC_IDENT_INDUCTANCE_D:
+    IdentInductance(instance, 0);
+    break;
+  case FOC_IDENT_INDUCTANCE_Q:
+    IdentInductance(instance, 1);
+    break;
+  case FOC_IDENT_FLUX:
+    IdentFlux(instance);
+    break;
+  default:
+    break;
+  }
+
+  /* 结束后输出零电压，清除电流环积分 */
+  if (ident->state == FOC_IDENT_DONE || ident->state == FOC_IDENT_ERROR) {
+    instance->param.Udq.d = 0.0f;
+    instance->param.Udq.q = 0.0f;
+    SetVoltage(instance, NULL);
+    PI_Reset(&instance->pi_d);
+    PI_Reset(&instance->pi_q);
+    return 0;
+  }
+  return 1;
+}
+/**
+ * @brief FOC 启动电角度零偏校准，d 轴电压依次将转子锁定于 FOC_CALIB_STEPS 个
+ *        电角度，正反各扫一遍，约 (2 * FOC_CALIB_STEPS + 2) * FOC_CALIB_DWELL 完成
+ * @param instance FOC实例
+ * @param voltage 锁定电压（V）
+ */
+void FOC_StartCalibrate(FOC_Instance *instance, float voltage) {
+  memset(&instance->calib, 0, sizeof(FOC_Calib));
+  if (voltage <= 0.0f) {
+    instance->calib.state = FOC_CALIB_ERROR;
+    return;
+  }
+  instance->calib.voltage = voltage;
+  instance->calib.state = FOC_CALIB_RUNNING;
+}
+
+/**
+ * @brief FOC 电角度零偏校准，代替 FOC_CurrentLoop 在 ADC 注入转换完成回调中调用，
+ *        结束后写入 angle_electrical_offset 和 direction
+ * @param instance FOC实例
+ * @param angle_mechanical 机械角度（编码器测得，rad）
+ * @return 1：校准进行中；0：未启动或已结束，结果见 instance->calib.state
+ */
+uint8_t FOC_CalibrateOffset(FOC_Instance *instance, float angle_mechanical) {
+  FOC_Calib *calib = &instance->calib;
+  if (calib->state != FOC_CALIB_RUNNING)
+    return 0;
+
+  /* 等待电流零偏校准完成，避免锁定电流影响电流零偏 */
+  if (instance->isense.adc != NULL &&
+      instance->isense.offset_cnt < FOC_CURRENT_OFFSET_SAMPLES) {
+    FOC_CurrentLoop(instance, 0.0f, 0.0f, 0.0f);
+    return 1;
+  }
+
+  /* 锁定点序号：正扫 0 ~ STEPS，反扫 STEPS - 1 ~ 0，首个锁定点停留加倍 */
+  uint32_t dwell = (uint32_t)(FOC_CALIB_DWELL / instance->pwm.Ts);
+  if (calib->step == 0)
+    dwell *= 2;
+  uint8_t k = (calib->step <= FOC_CALIB_STEPS)
+                  ? calib->step
+                  : 2 * FOC_CALIB_STEPS - calib->step;
+  FOC_OpenLoop(instance, calib->voltage, 0.0f,
+               k * (2.0f * PI / FOC_CALIB_STEPS));
+
+  /* 停留时间的后 1/4 平均编码器角度，以首个采样为参考避免跨越 0 / 2PI */
+  if (++calib->count > dwell - dwell / 4) {
+    if (calib->n == 0)
+      calib->mech_ref = angle_mechanical;
+    float delta = angle_mechanical - calib->mech_ref;
+    AngleLimit(&delta);
+    if (delta > PI)
+      delta -= 2.0f * PI;
+    calib->mech_sum += delta;
+    calib->n++;
+  }
+  if (calib->count < dwell)
+    return 1;
+
+  if (calib->step > 0)
+    calib->mech[calib->step - 1] =
+        calib->mech_ref + calib->mech_sum / (float)calib->n;
+  calib->step++;
+  calib->count = 0;
+  calib->n = 0;
+  calib->mech_sum = 0.0f;
+  if (calib->step <= 2 * FOC_CALIB_STEPS)
+    return 1;
+
+  CalibFit(instance);
+  FOC_OpenLoop(instance, 0.0f, 0.0f, 0.0f);
+  return 0;
+}
+
+/**
+ * @brief 由机械角度计算电角度，θe = direction * p * θm - offset
+ * @param instance FOC实例
+ * @param angle_mechanical 机械角度（rad）
+ * @return 电角度（rad），[0, 2PI)
+ */
+float FOC_ElectricalAngle(FOC_Instance *instance, float angle_mechanical) {
+  float angle = instance->param.direction * instance->param.pole_pairs *
+                    angle_mechanical -
+                instance->param.angle_electrical_offset;
+  AngleLimit(&angle);
+  return angle;
+}
 /* ---------------- 用户函数  End  ---------------- */
@@ -0,0 +1,233 @@
+#include "hfi.h"
+#include "bsp_pool.h"
+#include "arm_math.h"
+#include "string.h"
+
+POOL_DEFINE(hfi_pool, HFI_Instance, HFI_INSTANCE_MAX);
+
+#define HFI_DID_ALPHA 0.05f // d 轴高频电流幅值的低通系数
+#define HFI_DID_MIN 1e-4f   // d 轴高频电流幅值下限（A），避免归一化除零
+#define HFI_SETTLE_CYCLES 200 // 复位后等待 d 轴高频幅值稳定的周期数，期间不跟踪
+
+/* ---------------- 驱动函数 Begin ---------------- */
+static float Abs(float x) { return (x >= 0.0f) ? x : -x; }
+
+/**
+ * @brief 角度限制在 [0, 2PI)
+ */
+static float Wrap(float theta) {
+  while (theta >= 2.0f * PI)
+    theta -= 2.0f * PI;
+  while (theta < 0.0f)
+    theta += 2.0f * PI;
+  return theta;
+}
+
+/**
+ * @brief 角度差限制在 [-PI, PI)
+ */
+static float WrapDelta(float delta) {
+  while (delta >= PI)
+    delta -= 2.0f * PI;
+  while (delta < -PI)
+    delta += 2.0f * PI;
+  return delta;
+}
+
+/**
+ * @brief 进入下一状态
+ */
+static void StateNext(HFI_Instance *instance, HFI_State state) {
+  instance->state = state;
+  instance->cycles = 0;
+}
+
+/**
+ * @brief 极性辨识：正 d 轴电流使铁芯趋于饱和，Ld 减小，高频电流幅值增大；
+ *        正向幅值较小说明收敛到了 θ + PI，需翻转
+ * @param did_abs 本周期 d 轴高频电流幅值
+ */
+static void PolarityDetect(HFI_Instance *instance, float did_abs) {
+  uint16_t settle = instance->polarity_cycles / 2; // 前一半周期等待电流稳定
+
+  switch (instance->state) {
+  case HFI_CONVERGE:
+    if (++instance->cycles < instance->converge_cycles)
+      return;
+    if (instance->polarity_current > 0.0f) {
+      instance->polarity_pos = 0.0f;
+      instance->polarity_neg = 0.0f;
+      instance->id_bias = instance->polarity_current;
+      StateNext(instance, HFI_POLARITY_POS);
+    } else {
+      StateNext(instance, HFI_RUN);
+    }
+    break;
+  case HFI_POLARITY_POS:
+    if (++instance->cycles > settle)
+      instance->polarity_pos += did_abs;
+    if (instance->cycles >= instance->polarity_cycles) {
+      instance->id_bias = -instance->polarity_current;
+      StateNext(instance, HFI_POLARITY_NEG);
+    }
+    break;
+  case HFI_POLARITY_NEG:
+    if (++instance->cycles > settle)
+      instance->polarity_neg += did_abs;
+    if (instance->cycles >= instance->polarity_cycles) {
+      if (instance->polarity_pos < instance->polarity_neg) {
+        instance->theta = Wrap(instance->theta + PI);
+        instance->angle = instance->theta;
+      }
+      instance->id_bias = 0.0f;
+      StateNext(instance, HFI_RUN);
+    }
+    break;
+  case HFI_RUN:
+  default:
+    break;
+  }
+}
+/* ---------------- 驱动函数  End  ---------------- */
+
+/* ---------------- 用户函数 Begin ---------------- */
+/**
+ * @brief 注册高频注入实例
+ * @param config 初始化配置
+ * @return 高频注入实例
+ */
+HFI_Instance *HFI_Register(HFI_Init_Config_s *config) {
+  if (config->Ts <= 0.0f || config->Lq <= config->Ld ||
+      config->speed_high <= config->speed_low || config->demod_delay > 2 ||
+      config->converge_cycles <= HFI_SETTLE_CYCLES)
+    return NULL;
+
+  HFI_Instance *instance = (HFI_Instance *)Pool_Alloc(&hfi_pool);
+  if (instance == NULL)
+    return NULL;
+
+  instance->Ts = config->Ts;
+  instance->voltage = config->voltage;
+  instance->saliency_inv = config->Lq / (config->Lq - config->Ld);
+  instance->pll_kp = 2.0f * config->pll_bandwidth;
+  instance->pll_ki = config->pll_bandwidth * config->pll_bandwidth;
+  instance->speed_low = config->speed_low;
+  instance->speed_high_inv_span =
+      1.0f / (config->speed_high - config->speed_low);
+  instance->polarity_current = config->polarity_current;
+  instance->converge_cycles = config->converge_cycles;
+  instance->polarity_cycles = config->polarity_cycles;
+  instance->demod_delay = config->demod_delay;
+  instance->hold = (config->demod_delay == 1) ? 2 : 1;
+  HFI_Reset(instance, 0.0f);
+  return instance;
+}
+
+/**
+ * @brief 重新开始注入（收敛、极性辨识、跟踪）
+ * @param theta 初始电角度（rad）
+ */
+void HFI_Reset(HFI_Instance *instance, float theta) {
+  StateNext(instance, HFI_CONVERGE);
+  instance->sign[0] = 1;
+  instance->sign[1] = -1;
+  instance->phase = 0;
+  instance->did_hf = 0.0f;
+  instance->diq_hf = 0.0f;
+  instance->did_abs = 0.0f;
+  instance->pll_integral = 0.0f;
+  instance->theta = Wrap(theta);
+  instance->speed = 0.0f;
+  instance->weight = 0.0f;
+  instance->angle = instance->theta;
+  instance->u_inject = instance->voltage;
+  instance->id_bias = 0.0f;
+}
+
+/**
+ * @brief 获取本周期使用的电角度，并按转速与反电动势观测器平滑交接：
+ *        |ω| ≤ speed_low 时只用注入角度，≥ speed_high 时只用观测器角度并停止注入，
+ *        之间按权重线性融合角度、按 1 - 权重衰减注入电压
+ * @param instance 高频注入实例
+ * @param observer 反电动势观测器，为 NULL 时始终使用注入角度
+ * @return 电角度（rad）
+ */
+float HFI_Angle(HFI_Instance *instance, SMO_Instance *observer) {
+  float w = 0.0f;
+  if (observer != NULL && instance->state == HFI_RUN) {
+    w = (Abs(instance->speed) - instance->speed_low) *
+        instance->speed_high_inv_span;
+    w = (w > 1.0f) ? 1.0f : w;
+    w = (w < 0.0f) ? 0.0f : w;
+  }
+  instance->weight = w;
+
+  if (w >= 1.0f) {
+    /* 已完全交给观测器，跟踪器同步其状态，转速降低后无跳变地切回 */
+    instance->theta = observer->angle;
+    instance->speed = observer->speed;
+    instance->pll_integral = observer->speed;
+    instance->angle = observer->angle;
+  } else if (w > 0.0f) {
+    instance->angle = Wrap(instance->theta +
+                           w * WrapDelta(observer->angle - instance->theta));
+  } else {
+    instance->angle = instance->theta;
+  }
+  return instance->angle;
+}
+
+/**
+ * @brief 解调与角度跟踪，每个 PWM 周期在 Park 变换之后调用一次
+ *        相邻两次采样之间的电流增量为高频响应，该区间内生效的注入方向由注入历史和
+ *        demod_delay 决定：延迟为半个周期时区间前后两半的方向相反则互相抵消，
+ *        因此注入电平保持两个周期，只在两半方向相同的区间解调。
+ *        q 轴高频响应 Δiq 与 sin(2θ̃) 成正比，乘以注入方向并按 d 轴高频幅值归一化后
+ *        作为跟踪误差
+ * @param instance 高频注入实例
+ * @param id 估计坐标系下的 d 轴电流（A），返回滤除高频分量后的值
+ * @param iq 估计坐标系下的 q 轴电流（A），返回滤除高频分量后的值
+ */
+void HFI_Update(HFI_Instance *instance, float *id, float *iq) {
+  float did = *id - instance->id_last;
+  float diq = *iq - instance->iq_last;
+  instance->id_last = *id;
+  instance->iq_last = *iq;
+
+  /* 本区间生效的注入方向：延迟 0 为最近一次输出，2 为再前一次，1 为二者各占一半 */
+  uint8_t d = instance->demod_delay;
+  float s = 0.5f * (float)(instance->sign[d >> 1] + instance->sign[(d + 1) >> 1]);
+  if (s != 0.0f) {
+    instance->did_hf = did;
+    instance->diq_hf = diq;
+  }
+  /* 采样值相对高频电流中点的偏移为最近一个有效区间增量的一半 */
+  *id -= 0.5f * instance->did_hf;
+  *iq -= 0.5f * instance->diq_hf;
+
+  if (instance->weight < 1.0f) {
+    /* 无效区间的跟踪误差为 0，极性辨识的正负两段计入的有效区间数相同 */
+    if (s != 0.0f)
+      instance->did_abs += HFI_DID_ALPHA * (Abs(did) - instance->did_abs);
+    float did_abs =
+        (instance->did_abs > HFI_DID_MIN) ? instance->did_abs : HFI_DID_MIN;
+    float err = diq * s / did_abs * instance->saliency_inv;
+    if (instance->state == HFI_CONVERGE &&
+        instance->cycles < HFI_SETTLE_CYCLES)
+      err = 0.0f;
+
+    instance->pll_integral += instance->pll_ki * instance->Ts * err;
+    instance->speed = instance->pll_kp * err + instance->pll_integral;
+    instance->theta = Wrap(instance->theta + instance->speed * instance->Ts);
+    PolarityDetect(instance, Abs(did * s));
+  }
+
+  /* 注入方向每 hold 个周期翻转，幅值随交接权重衰减 */
+  instance->sign[1] = instance->sign[0];
+  if (++instance->phase >= instance->hold) {
+    instance->phase = 0;
+    instance->sign[0] = (int8_t)-instance->sign[0];
+  }
+  instance->u_inject =
+      (float)instance->sign[0] * instance->voltage * (1.0f - instance->weight);
+}
@@ -0,0 +1,112 @@
+#include "mtpa.h"
+#include "bsp_pool.h"
+#include "arm_math.h"
+#include "string.h"
+
+POOL_DEFINE(mtpa_pool, MTPA_Instance, MTPA_INSTANCE_MAX);
+
+#define MTPA_BISECT_ITER 40 // 由转矩反求电流幅值的二分次数
+
+/* ---------------- 驱动函数 Begin ---------------- */
+/**
+ * @brief 给定电流幅值时的 MTPA 工作点
+ *        id = (ψ - sqrt(ψ^2 + 8 * (Lq - Ld)^2 * I^2)) / (4 * (Lq - Ld))
+ * @param config 电机参数
+ * @param current 电流矢量幅值（A）
+ * @param id d 轴电流（输出）
+ * @param iq q 轴电流（输出）
+ * @return 电磁转矩 Te = 1.5 * p * iq * (ψ + (Ld - Lq) * id)
+ */
+static float MTPA_Point(MTPA_Init_Config_s *config, float current, float *id,
+                        float *iq) {
+  float delta = config->Lq - config->Ld;
+  float root;
+
+  if (delta * delta < 1e-18f) {
+    *id = 0.0f;
+  } else {
+    arm_sqrt_f32(config->flux * config->flux +
+                     8.0f * delta * delta * current * current,
+                 &root);
+    *id = (config->flux - root) / (4.0f * delta);
+  }
+  arm_sqrt_f32(current * current - *id * *id, &root);
+  *iq = root;
+  return 1.5f * config->pole_pairs * *iq * (config->flux - delta * *id);
+}
+/* ---------------- 驱动函数  End  ---------------- */
+
+/* ---------------- 用户函数 Begin ---------------- */
+/**
+ * @brief 由电机参数生成 MTPA 表
+ *        转矩按 [0, torque_max] 等间隔取点，逐点二分求解 MTPA 曲线上的电流幅值；
+ *        只在初始化时调用，不依赖外设，也可在主机上离线运行后导出表格
+ * @param config 电机参数
+ * @param table 生成的表（输出）
+ */
+void MTPA_Generate(MTPA_Init_Config_s *config, MTPA_Instance *table) {
+  float id, iq;
+  table->torque_const = 1.5f * config->pole_pairs * config->flux;
+  table->torque_max = MTPA_Point(config, config->current_max, &id, &iq);
+  table->torque_step_inv = (MTPA_TABLE_SIZE - 1) / table->torque_max;
+
+  for (uint16_t k = 0; k < MTPA_TABLE_SIZE; k++) {
+    float torque = table->torque_max * k / (MTPA_TABLE_SIZE - 1);
+    float lo = 0.0f, hi = config->current_max;
+    for (uint8_t n = 0; n < MTPA_BISECT_ITER; n++) {
+      float mid = 0.5f * (lo + hi);
+      if (MTPA_Point(config, mid, &id, &iq) < torque)
+        lo = mid;
+      else
+        hi = mid;
+    }
+    MTPA_Point(config, 0.5f * (lo + hi), &id, &iq);
+    table->id[k] = id;
+    table->iq[k] = iq;
+  }
+}
+
+/**
+ * @brief 注册 MTPA 实例并生成查找表
+ * @param config 电机参数
+ * @return MTPA 实例
+ */
+MTPA_Instance *MTPA_Register(MTPA_Init_Config_s *config) {
+  if (config->pole_pairs == 0 || config->flux <= 0.0f ||
+      config->current_max <= 0.0f || config->Ld <= 0.0f || config->Lq <= 0.0f)
+    return NULL;
+
+  MTPA_Instance *instance = (MTPA_Instance *)Pool_Alloc(&mtpa_pool);
+  if (instance == NULL)
+    return NULL;
+
+  MTPA_Generate(config, instance);
+  return instance;
+}
+
+/**
+ * @brief 转矩指令转 (Id, Iq)，线性插值，运算量固定
+ *        超出 ±torque_max 时取表端点；负转矩 Iq 取反，Id 不变
+ * @param instance MTPA 实例
+ * @param torque 转矩指令（N·m）
+ * @param id d 轴电流给定（输出）
+ * @param iq q 轴电流给定（输出）
+ */
+void MTPA_Calculate(MTPA_Instance *instance, float torque, float *id,
+                    float *iq) {
+  float t = (torque >= 0.0f) ? torque : -torque;
+  float x = t * instance->torque_step_inv;
+  int32_t k = (int32_t)x;
+
+  if (k >= MTPA_TABLE_SIZE - 1) {
+    *id = instance->id[MTPA_TABLE_SIZE - 1];
+    *iq = instance->iq[MTPA_TABLE_SIZE - 1];
+  } else {
+    float f = x - (float)k;
+    *id = instance->id[k] + (instance->id[k + 1] - instance->id[k]) * f;
+    *iq = instance->iq[k] + (instance->iq[k + 1] - instance->iq[k]) * f;
+  }
+  if (torque < 0.0f)
+    *iq = -*iq;
+}
+/* ---------------- 用户函数  End  ---------------- */
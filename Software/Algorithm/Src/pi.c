@@ -0,0 +1,73 @@
+#include "pi.h"
+
+/**
+ * @brief 限幅
+ */
+static float Limit(float value, float max) {
+  if (value > max)
+    return max;
+  if (value < -max)
+    return -max;
+  return value;
+}
+
+/**
+ * @brief PI 控制器初始化
+ * @param pi PI 实例
+ * @param kp 比例增益
+ * @param ki 积分增益（连续域）
+ * @param Ts 控制周期（s）
+ * @param out_max 输出限幅
+ */
+void PI_Init(PI_Instance *pi, float kp, float ki, float Ts, float out_max) {
+  pi->kp = kp;
+  pi->ki = ki;
+  pi->Ts = Ts;
+  pi->out_max = out_max;
+  pi->kb = 0.0f;
+  PI_Reset(pi);
+}
+
+/**
+ * @brief 清除 PI 控制器的积分项和输出
+ */
+void PI_Reset(PI_Instance *pi) {
+  pi->integral = 0.0f;
+  pi->out = 0.0f;
+}
+
+/**
+ * @brief PI 计算（积分限幅抗饱和）
+ * @param pi PI 实例
+ * @param measure 测量值
+ * @param ref 目标值
+ * @return 控制器输出
+ */
+float PI_Calculate(PI_Instance *pi, float measure, float ref) {
+  float err = ref - measure;
+
+  /* 积分项单独限幅，防止积分饱和 */
+  pi->integral = Limit(pi->integral + pi->ki * pi->Ts * err, pi->out_max);
+  pi->out = Limit(pi->kp * err + pi->integral, pi->out_max);
+
+  return pi->out;
+}
+
+/**
+ * @brief 设置反算抗饱和增益
+ * @param pi PI 实例
+ * @param kb 反算增益（1/s），常取 ki / kp，即跟踪时间常数等于积分时间常数；为 0 时关闭
+ */
+void PI_SetBackCalculation(PI_Instance *pi, float kb) { pi->kb = kb; }
+
+/**
+ * @brief 反算抗饱和：下游限幅使实际输出与 PI 输出（含叠加在其上的前馈）不同时，
+ *        把差值按 kb 回馈到积分项，退出饱和后无需先消耗多余的积分
+ * @param pi PI 实例
+ * @param excess 实际输出 - 限幅前输出，未饱和时为 0
+ */
+void PI_BackCalculate(PI_Instance *pi, float excess) {
+  pi->integral =
+      Limit(pi->integral + pi->kb * pi->Ts * excess, pi->out_max);
+  pi->out += excess;
+}
@@ -0,0 +1,140 @@
+#include "smo.h"
+#include "bsp_pool.h"
+#include "arm_math.h"
+#include "math.h"
+#include "string.h"
+
+POOL_DEFINE(smo_pool, SMO_Instance, SMO_INSTANCE_MAX);
+
+#define SMO_EMF_MIN 1e-3f // 反电动势幅值下限（V），避免归一化除零
+
+/* ---------------- 驱动函数 Begin ---------------- */
+/**
+ * @brief 饱和函数，边界层内线性
+ */
+static float Sat(float x) {
+  if (x > 1.0f)
+    return 1.0f;
+  if (x < -1.0f)
+    return -1.0f;
+  return x;
+}
+
+/**
+ * @brief 角度限制在 [0, 2PI)
+ */
+static float Wrap(float theta) {
+  while (theta >= 2.0f * PI)
+    theta -= 2.0f * PI;
+  while (theta < 0.0f)
+    theta += 2.0f * PI;
+  return theta;
+}
+
+/**
+ * @brief 单轴电流观测：L * di/dt = u - R * i - z，z = k * sat((î - i) / φ)
+ * @return 滑模控制量 z（V）
+ */
+static float CurrentObserve(SMO_Instance *instance, float *i_hat, float i,
+                            float u) {
+  float z = instance->k_slide * Sat((*i_hat - i) * instance->boundary_inv);
+  *i_hat += instance->Ts * instance->Ls_inv * (u - instance->Rs * *i_hat - z);
+  return z;
+}
+/* ---------------- 驱动函数  End  ---------------- */
+
+/* ---------------- 用户函数 Begin ---------------- */
+/**
+ * @brief 注册滑模观测器
+ * @param config 初始化配置
+ * @return 观测器实例
+ */
+SMO_Instance *SMO_Register(SMO_Init_Config_s *config) {
+  if (config->Ls <= 0.0f || config->Ts <= 0.0f || config->boundary <= 0.0f ||
+      config->lpf_cutoff <= 0.0f)
+    return NULL;
+
+  SMO_Instance *instance = (SMO_Instance *)Pool_Alloc(&smo_pool);
+  if (instance == NULL)
+    return NULL;
+
+  float wc_ts = config->lpf_cutoff * config->Ts;
+  instance->Rs = config->Rs;
+  instance->Ls_inv = 1.0f / config->Ls;
+  instance->Ts = config->Ts;
+  instance->k_slide = config->k_slide;
+  /* 离散化后边界层内的等效增益 k * Ts / (L * φ) 须不大于 1，否则估计电流发散 */
+  float boundary_min = config->k_slide * config->Ts / config->Ls;
+  instance->boundary_inv =
+      1.0f / ((config->boundary > boundary_min) ? config->boundary
+                                                : boundary_min);
+  instance->lpf_alpha = wc_ts / (1.0f + wc_ts);
+  instance->lpf_cutoff_inv = 1.0f / config->lpf_cutoff;
+  instance->pll_kp = 2.0f * config->pll_bandwidth;
+  instance->pll_ki = config->pll_bandwidth * config->pll_bandwidth;
+  instance->speed_min = config->speed_min;
+  return instance;
+}
+
+/**
+ * @brief 清除观测器状态
+ */
+void SMO_Reset(SMO_Instance *instance) {
+  instance->i_alpha = 0.0f;
+  instance->i_beta = 0.0f;
+  instance->e_alpha = 0.0f;
+  instance->e_beta = 0.0f;
+  instance->pll_integral = 0.0f;
+  instance->theta = 0.0f;
+  instance->speed = 0.0f;
+  instance->angle = 0.0f;
+}
+
+/**
+ * @brief 观测器更新，每个 PWM 周期调用一次
+ * @param instance 观测器实例
+ * @param i_alpha 本周期采样的 α 轴电流（A）
+ * @param i_beta 本周期采样的 β 轴电流（A）
+ * @param u_alpha 上一周期输出、在两次采样之间作用的 α 轴电压（V）
+ * @param u_beta 上一周期输出的 β 轴电压（V）
+ */
+void SMO_Update(SMO_Instance *instance, float i_alpha, float i_beta,
+                float u_alpha, float u_beta) {
+  /* 滑模电流观测器，z 的低频分量即为反电动势 */
+  float z_alpha = CurrentObserve(instance, &instance->i_alpha, i_alpha, u_alpha);
+  float z_beta = CurrentObserve(instance, &instance->i_beta, i_beta, u_beta);
+  instance->e_alpha += instance->lpf_alpha * (z_alpha - instance->e_alpha);
+  instance->e_beta += instance->lpf_alpha * (z_beta - instance->e_beta);
+
+  /* PLL 跟踪反电动势矢量角 φ：误差 eβ * cosφ̂ - eα * sinφ̂ = |e| * sin(φ - φ̂)，
+   * 按 |e| 归一化使环路增益与转速无关 */
+  float mag;
+  arm_sqrt_f32(instance->e_alpha * instance->e_alpha +
+                   instance->e_beta * instance->e_beta,
+               &mag);
+  mag = (mag > SMO_EMF_MIN) ? mag : SMO_EMF_MIN;
+  float err = (instance->e_beta * arm_cos_f32(instance->theta) -
+               instance->e_alpha * arm_sin_f32(instance->theta)) /
+              mag;
+
+  instance->pll_integral += instance->pll_ki * instance->Ts * err;
+  instance->speed = instance->pll_kp * err + instance->pll_integral;
+  instance->theta = Wrap(instance->theta + instance->speed * instance->Ts);
+
+  /* e = ωψ * [-sinθ, cosθ]，正转时 φ 超前转子角 PI/2，反转时滞后 PI/2；
+   * 同时补偿反电动势低通滤波的相位滞后 atan(ω / ωc)
+   * 和电流观测器的一拍延迟 ω * Ts */
+  float offset = (instance->speed >= 0.0f) ? -0.5f * PI : 0.5f * PI;
+  instance->angle =
+      Wrap(instance->theta + offset + instance->speed * instance->Ts +
+           atanf(instance->speed * instance->lpf_cutoff_inv));
+}
+
+/**
+ * @brief 估计值是否有效（转速高于 speed_min，反电动势足以观测）
+ */
+uint8_t SMO_IsValid(SMO_Instance *instance) {
+  float speed = (instance->speed >= 0.0f) ? instance->speed : -instance->speed;
+  return speed >= instance->speed_min;
+}
+/* ---------------- 用户函数  End  ---------------- */
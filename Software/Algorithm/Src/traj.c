@@ -0,0 +1,230 @@
+#include "traj.h"
+#include "bsp_pool.h"
+#include "math.h"
+
+POOL_DEFINE(traj_pool, Traj_Instance, TRAJ_INSTANCE_MAX);
+
+/* ---------------- 驱动函数 Begin ---------------- */
+/**
+ * @brief 按恒定加加速度积分一段时间
+ */
+static void Segment(float *x, float *v, float *a, float jerk, float t) {
+  *x += t * (*v + t * (0.5f * *a + t * jerk / 6.0f));
+  *v += t * (*a + 0.5f * t * jerk);
+  *a += t * jerk;
+}
+
+/**
+ * @brief 从 (v, a) 以最大能力减速到静止所经过的位移
+ * @note S 形曲线的减速过程为：加速度以 -jerk 降至 -peak，保持，再以 +jerk 回到 0；
+ *       若立即把加速度降到 0 时速度已反向，则按镜像计算
+ */
+static float StopTravel(Traj_Instance *instance, float v, float a) {
+  float A = instance->acc_max;
+  if (instance->profile == TRAJ_TRAPEZOID)
+    return v * fabsf(v) / (2.0f * A);
+
+  float J = instance->jerk_max;
+  float sign = (v + a * fabsf(a) / (2.0f * J) >= 0.0f) ? 1.0f : -1.0f;
+  v *= sign;
+  a *= sign;
+
+  float peak = J * v + 0.5f * a * a;
+  float hold = 0.0f;
+  if (peak < A * A) {
+    peak = sqrtf(peak);
+  } else {
+    hold = (v + (0.5f * a * a - A * A) / J) / A;
+    if (hold < 0.0f)
+      hold = 0.0f;
+    peak = A;
+  }
+
+  float x = 0.0f;
+  Segment(&x, &v, &a, -J, (a + peak) / J);
+  Segment(&x, &v, &a, 0.0f, hold);
+  Segment(&x, &v, &a, J, peak / J);
+  return sign * x;
+}
+
+/**
+ * @brief 以加速度 a_next 推进一个周期后，减速到静止时相对目标的超出量（> 0 表示越过目标）
+ * @param d 剩余距离，v、a 为当前速度和加速度（均已按运动方向归一化）
+ */
+static float Overshoot(Traj_Instance *instance, float d, float v, float a,
+                       float a_next) {
+  float Ts = instance->Ts;
+  if (instance->profile == TRAJ_TRAPEZOID) {
+    d -= Ts * (v + 0.5f * Ts * a_next);
+    v += Ts * a_next;
+    return StopTravel(instance, v, 0.0f) - d;
+  }
+  d -= Ts * (v + Ts * (2.0f * a + a_next) / 6.0f);
+  v += 0.5f * Ts * (a + a_next);
+  return StopTravel(instance, v, a_next) - d;
+}
+
+/**
+ * @brief 以最快方式把速度推向 vel_max 时下一周期的加速度
+ * @note S 形曲线选取 a_next 使推进一个周期后，加速度以 jerk 降到 0 时速度恰好等于 vel_max
+ */
+static float Accelerate(Traj_Instance *instance, float v, float a) {
+  float Ts = instance->Ts;
+  float e = instance->vel_max - v;
+  if (instance->profile == TRAJ_TRAPEZOID)
+    return e / Ts;
+
+  float J = instance->jerk_max;
+  float h = 0.5f * J * Ts;
+  float r = e - 0.5f * a * Ts;
+  if (r >= 0.0f)
+    return -h + sqrtf(h * h + 2.0f * J * r);
+  return h - sqrtf(h * h - 2.0f * J * r);
+}
+/* ---------------- 驱动函数  End  ---------------- */
+
+/* ---------------- 用户函数 Begin ---------------- */
+/**
+ * @brief 注册轨迹规划实例，初始停在位置 0
+ * @param config 初始化配置
+ * @return 轨迹规划实例
+ */
+Traj_Instance *Traj_Register(Traj_Init_Config_s *config) {
+  if (config->Ts <= 0.0f || config->vel_max <= 0.0f ||
+      config->acc_max <= 0.0f ||
+      (config->profile == TRAJ_SCURVE && config->jerk_max <= 0.0f))
+    return NULL;
+
+  Traj_Instance *instance = (Traj_Instance *)Pool_Alloc(&traj_pool);
+  if (instance == NULL)
+    return NULL;
+
+  instance->profile = config->profile;
+  instance->Ts = config->Ts;
+  instance->vel_max = config->vel_max;
+  instance->acc_max = config->acc_max;
+  instance->jerk_max = config->jerk_max;
+  instance->done = 1;
+  return instance;
+}
+
+/**
+ * @brief 以当前状态重置设定点，目标设为当前位置；速度不为 0 时先减速停下再回到该位置
+ * @param instance 轨迹规划实例
+ * @param pos 当前位置（rad）
+ * @param vel 当前速度（rad/s）
+ */
+void Traj_Reset(Traj_Instance *instance, float pos, float vel) {
+  instance->target = pos;
+  instance->pos = pos;
+  instance->vel = vel;
+  instance->acc = 0.0f;
+  instance->done = (vel == 0.0f);
+}
+
+/**
+ * @brief 设置目标位置，可在运动中随时修改，下一次更新即按新目标重新规划
+ * @param instance 轨迹规划实例
+ * @param target 目标位置（rad）
+ */
+void Traj_SetTarget(Traj_Instance *instance, float target) {
+  instance->target = target;
+  instance->done = 0;
+}
+
+/**
+ * @brief 修改速度、加速度、加加速度上限，非正值保持原值；
+ *        当前状态超出新上限时以原加加速度（梯形曲线为新加速度）回到限制内
+ */
+void Traj_SetLimits(Traj_Instance *instance, float vel_max, float acc_max,
+                    float jerk_max) {
+  if (vel_max > 0.0f)
+    instance->vel_max = vel_max;
+  if (acc_max > 0.0f)
+    instance->acc_max = acc_max;
+  if (jerk_max > 0.0f)
+    instance->jerk_max = jerk_max;
+  instance->done = 0;
+}
+
+/**
+ * @brief 推进一个周期，更新 pos、vel、acc 设定点
+ * @note 每次在可行加速度区间内二分 TRAJ_ITERATIONS 次，取不越过目标的最大加速度，
+ *       耗时有固定上限；目标突变导致无法避免越过时以最大能力减速后反向返回
+ * @param instance 轨迹规划实例
+ */
+void Traj_Update(Traj_Instance *instance) {
+  if (instance->done) {
+    instance->acc = 0.0f;
+    return;
+  }
+
+  float Ts = instance->Ts;
+  float A = instance->acc_max;
+  float J = instance->jerk_max;
+
+  /* 按运动方向归一化：目标在正方向，d 为剩余距离 */
+  float sign = (instance->target >= instance->pos) ? 1.0f : -1.0f;
+  float d = sign * (instance->target - instance->pos);
+  float v = sign * instance->vel;
+  float a = sign * instance->acc;
+
+  /* 下一周期加速度的可行区间 */
+  float lo = -A, hi = A;
+  if (instance->profile == TRAJ_SCURVE) {
+    lo = fmaxf(a - J * Ts, -A);
+    hi = fminf(a + J * Ts, A);
+    if (lo > hi) {
+      if (a > 0.0f)
+        hi = lo;
+      else
+        lo = hi;
+    }
+  }
+
+  /* 不越过目标的最大加速度 */
+  float land;
+  if (Overshoot(instance, d, v, a, hi) <= 0.0f) {
+    land = hi;
+  } else if (Overshoot(instance, d, v, a, lo) >= 0.0f) {
+    land = lo;
+  } else {
+    float l = lo, h = hi;
+    for (uint8_t i = 0; i < TRAJ_ITERATIONS; i++) {
+      float m = 0.5f * (l + h);
+      if (Overshoot(instance, d, v, a, m) > 0.0f)
+        h = m;
+      else
+        l = m;
+    }
+    land = l;
+  }
+
+  float a_next = fminf(Accelerate(instance, v, a), land);
+  a_next = fminf(fmaxf(a_next, lo), hi);
+
+  /* 积分 */
+  if (instance->profile == TRAJ_TRAPEZOID) {
+    d -= Ts * (v + 0.5f * Ts * a_next);
+    v += Ts * a_next;
+  } else {
+    d -= Ts * (v + Ts * (2.0f * a + a_next) / 6.0f);
+    v += 0.5f * Ts * (a + a_next);
+  }
+  a = a_next;
+
+  /* 到达：剩余量小于一个周期的最小可分辨量时落到目标，
+   * 加速度在下一周期归零，以免超出加加速度限制 */
+  float jerk_ts = (instance->profile == TRAJ_SCURVE) ? J * Ts : A;
+  if (fabsf(d) <= jerk_ts * Ts * Ts && fabsf(v) <= jerk_ts * Ts &&
+      (instance->profile == TRAJ_TRAPEZOID || fabsf(a) <= jerk_ts)) {
+    d = 0.0f;
+    v = 0.0f;
+    instance->done = 1;
+  }
+
+  instance->pos = instance->target - sign * d;
+  instance->vel = sign * v;
+  instance->acc = sign * a;
+}
+/* ---------------- 用户函数  End  ---------------- */
@@ -0,0 +1,48 @@
+#ifndef BSP_CORDIC_H
+#define BSP_CORDIC_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* ------------------------------------------------- include
+ * ------------------------------------------------- */
+#include "stdint.h"
+#include "stm32g4xx_hal.h"
+
+/* ------------------------------------------------- define
+ * ------------------------------------------------- */
+#define CORDIC_PRECISION 6 // 迭代次数 = 4 * CORDIC_PRECISION
+
+/* 软件模型在 CORDIC_PRECISION 为 6 时，sin/cos 在 [-PI, PI) 上的最大误差实测为
+ * 1.25e-7（约 2^-23），上限取 2^-22（Sim/Test/test_cordic.c）。
+ * 模型未与硬件逐位比对，硬件误差以参考手册为准 */
+#define CORDIC_MODEL_ERROR_LOG2 22
+
+/* 1：不访问寄存器，使用软件迭代模型（主机构建、离线测试用） */
+#ifndef BSP_CORDIC_MODEL
+#define BSP_CORDIC_MODEL 0
+#endif
+
+/* ------------------------------------------------- functions
+ * ------------------------------------------------- */
+/**
+ * @brief 初始化 CORDIC：余弦函数，同时输出 cos 和 sin，输入输出均为 q1.31
+ */
+void CORDIC_Init(void);
+
+/**
+ * @brief 写入角度，启动一次 sin/cos 计算（不等待结果）
+ * @param angle 角度，q1.31 格式，[-1, 1) 对应 [-PI, PI)
+ */
+void CORDIC_SinCosStart(int32_t angle);
+
+/**
+ * @brief 读取 sin/cos 结果，若计算未完成，读操作会插入等待周期直至完成
+ * @param sin_q31 sin 结果（q1.31）
+ * @param cos_q31 cos 结果（q1.31）
+ */
+void CORDIC_SinCosRead(int32_t *sin_q31, int32_t *cos_q31);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
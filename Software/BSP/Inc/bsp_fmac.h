@@ -0,0 +1,70 @@
+#ifndef BSP_FMAC_H
+#define BSP_FMAC_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* ------------------------------------------------- include
+ * ------------------------------------------------- */
+#include "stdint.h"
+#include "stm32g4xx_hal.h"
+
+/* ------------------------------------------------- define
+ * ------------------------------------------------- */
+#define FMAC_MAX_TAPS 16 // 前馈/反馈系数的最大个数
+
+/* 1：不访问寄存器，使用软件模型（主机构建、离线测试用） */
+#ifndef BSP_FMAC_MODEL
+#define BSP_FMAC_MODEL 0
+#endif
+
+/* ------------------------------------------------- typedef
+ * ------------------------------------------------- */
+/* FMAC 滤波函数 */
+typedef enum {
+  FMAC_FUNC_FIR = 8, // 卷积（FIR）
+  FMAC_FUNC_IIR = 9, // IIR 直接 I 型
+} FMAC_Function;
+
+/* FMAC 滤波器配置，系数为 q1.15
+ * y[n] = 2^r * (Σ b[k] * x[n-k] + Σ a[k] * y[n-k])
+ * 注意反馈系数的符号与常规差分方程 y = Σ b * x - Σ a * y 相反 */
+typedef struct {
+  FMAC_Function func;
+  uint8_t p;                      // 前馈系数个数 b[0] ~ b[p-1]
+  uint8_t q;                      // 反馈系数个数 a[1] ~ a[q]（FIR 为 0）
+  uint8_t r;                      // 输出增益 2^r（0 ~ 7）
+  int16_t coeff_b[FMAC_MAX_TAPS]; // 前馈系数
+  int16_t coeff_a[FMAC_MAX_TAPS]; // 反馈系数，coeff_a[0] 对应 a[1]
+  int16_t x_init;                 // 初始状态：历史输入 x[n-1] ~ x[n-p+1]
+  int16_t y_init;                 // 初始状态：历史输出 y[n-1] ~ y[n-q]
+} FMAC_Filter_Config_s;
+
+/* ------------------------------------------------- functions
+ * ------------------------------------------------- */
+/**
+ * @brief 配置并启动 FMAC 滤波（写入系数、预载初始状态、打开输出饱和）
+ * @param config 滤波器配置
+ * @retval HAL_OK：成功；HAL_ERROR：参数错误
+ */
+HAL_StatusTypeDef FMAC_Filter_Start(FMAC_Filter_Config_s *config);
+
+/**
+ * @brief 写入一个输入样本（不等待结果，可与其他运算并行）
+ */
+void FMAC_Filter_Write(int16_t x);
+
+/**
+ * @brief 读取一个输出样本，若计算未完成则等待
+ */
+int16_t FMAC_Filter_Read(void);
+
+/**
+ * @brief 查询饱和标志（标志在 FMAC_Filter_Start 时清除）
+ * @retval 1：启动以来发生过输出饱和；0：未饱和
+ */
+uint8_t FMAC_Filter_Saturated(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,91 @@
+#ifndef BSP_POOL_H
+#define BSP_POOL_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* ------------------------------------------------- include
+ * ------------------------------------------------- */
+#include "stddef.h"
+#include "stdint.h"
+
+/* ------------------------------------------------- define
+ * ------------------------------------------------- */
+#define POOL_CAPACITY_MAX 32 // 单个对象池的最大容量（占用位图为 32 位）
+
+/* 每个对象池单独放在 .bss.pool.<name> 段：未被引用的对象池可被 --gc-sections 移除，
+ * 链接脚本统计所有对象池的总大小并与 _Pool_Budget 比较 */
+#if defined(__GNUC__)
+#define POOL_SECTION(name) __attribute__((section(".bss.pool." #name), aligned(4)))
+#else
+#define POOL_SECTION(name)
+#endif
+
+/**
+ * @brief 定义一个静态对象池，容量在编译时检查
+ * @param name 对象池变量名
+ * @param type 对象类型
+ * @param capacity 对象个数，[1, POOL_CAPACITY_MAX]
+ */
+#define POOL_DEFINE(name, type, capacity)                                      \
+  _Static_assert((capacity) >= 1 && (capacity) <= POOL_CAPACITY_MAX,           \
+                 #name ": capacity must be in [1, POOL_CAPACITY_MAX]");        \
+  static type name##_storage[(capacity)] POOL_SECTION(name);                   \
+  static Pool_Instance name = {#name, (uint8_t *)name##_storage, sizeof(type), \
+                               (capacity), 0, 0, 0, 0, 0, NULL}
+
+/* ------------------------------------------------- typedef
+ * ------------------------------------------------- */
+/* 对象池 */
+typedef struct Pool_Instance {
+  const char *name;           // 对象池名称
+  uint8_t *storage;           // 静态存储区
+  uint16_t size;              // 单个对象的字节数
+  uint8_t capacity;           // 对象个数
+  uint8_t used;               // 已分配的对象个数
+  uint8_t peak;               // 已分配对象个数的峰值
+  uint8_t linked;             // 已加入统计链表
+  uint16_t fail;              // 容量不足导致分配失败的次数
+  uint32_t mask;              // 占用位图，第 i 位对应第 i 个对象
+  struct Pool_Instance *next; // 统计链表
+} Pool_Instance;
+
+/* 所有对象池的使用统计 */
+typedef struct {
+  uint8_t pools;        // 已使用过的对象池个数
+  uint32_t bytes_total; // 静态存储区总字节数
+  uint32_t bytes_used;  // 已分配的字节数
+  uint32_t bytes_peak;  // 各对象池峰值之和（字节）
+  uint16_t fail;        // 分配失败总次数
+} Pool_Stats;
+
+/* ------------------------------------------------- functions
+ * ------------------------------------------------- */
+/**
+ * @brief 从对象池分配一个对象，内容清零
+ * @param pool 对象池
+ * @retval 对象指针，容量不足时返回 NULL
+ */
+void *Pool_Alloc(Pool_Instance *pool);
+
+/**
+ * @brief 归还对象（注册中途失败时使用）
+ * @param pool 对象池
+ * @param object 由 Pool_Alloc 分配的对象指针
+ */
+void Pool_Free(Pool_Instance *pool, void *object);
+
+/**
+ * @brief 统计所有使用过的对象池
+ * @param stats 统计结果（输出）
+ */
+void Pool_GetStats(Pool_Stats *stats);
+
+/**
+ * @brief 统计链表表头，可遍历各对象池的 used / peak / fail
+ */
+Pool_Instance *Pool_List(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,122 @@
+#ifndef BSP_PROFILE_H
+#define BSP_PROFILE_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* ------------------------------------------------- include
+ * ------------------------------------------------- */
+#include "stdint.h"
+
+/* ------------------------------------------------- define
+ * ------------------------------------------------- */
+/* 1：PROFILE_BEGIN / PROFILE_END 统计各阶段耗时；0：宏展开为空，不产生任何代码 */
+#ifndef PROFILE_ENABLE
+#define PROFILE_ENABLE 0
+#endif
+
+/* 1：主机构建，计时基于 CLOCK_MONOTONIC（ns）；0：目标板，计时基于 DWT CYCCNT */
+#ifndef PROFILE_HOST
+#if defined(__arm__)
+#define PROFILE_HOST 0
+#else
+#define PROFILE_HOST 1
+#endif
+#endif
+
+#define PROFILE_STAGE_MAX 16 // 可统计的阶段个数
+#define PROFILE_HIST_BINS 8  // 直方图区间个数
+#define PROFILE_HIST_SHIFT 6 // 区间 0 为 [0, 2^SHIFT)，之后每个区间上限翻倍，末区间不封顶
+
+#if PROFILE_HOST
+#include "time.h"
+#else
+#include "stm32g4xx.h"
+#endif
+
+/**
+ * @brief 统计一个阶段的耗时，BEGIN 与 END 须在同一作用域内成对使用
+ * @note 每个调用点在首次执行时按名称登记到 profile_table，之后只做一次减法和一次函数调用；
+ *       同名的多个调用点共用一条统计
+ * @param stage 阶段名（标识符），同时作为表中的名称
+ */
+#if PROFILE_ENABLE
+#define PROFILE_BEGIN(stage)                                                   \
+  static Profile_Stage *profile_##stage = NULL;                                \
+  uint32_t profile_start_##stage = Profile_Now()
+#define PROFILE_END(stage)                                                     \
+  Profile_Record(&profile_##stage, #stage,                                     \
+                 Profile_Now() - profile_start_##stage)
+#else
+#define PROFILE_BEGIN(stage) ((void)0)
+#define PROFILE_END(stage) ((void)0)
+#endif
+
+/* ------------------------------------------------- typedef
+ * ------------------------------------------------- */
+/* 单个阶段的耗时统计，单位为计时节拍（目标板为 CPU 周期，主机为 ns） */
+typedef struct {
+  const char *name;                  // 阶段名称
+  uint32_t count;                    // 执行次数
+  uint32_t last;                     // 上次耗时
+  uint32_t min;                      // 最小耗时
+  uint32_t max;                      // 最大耗时
+  uint64_t sum;                      // 耗时累加，mean = sum / count
+  uint32_t hist[PROFILE_HIST_BINS];  // 对数直方图
+} Profile_Stage;
+
+/* ------------------------------------------------- variable
+ * ------------------------------------------------- */
+/* 统计表，调试器可直接观察 profile_table[0 .. profile_stages - 1] */
+extern Profile_Stage profile_table[PROFILE_STAGE_MAX];
+extern uint8_t profile_stages;
+
+/* ------------------------------------------------- functions
+ * ------------------------------------------------- */
+/**
+ * @brief 读取计时节拍
+ */
+static inline uint32_t Profile_Now(void) {
+#if PROFILE_HOST
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+#else
+  return DWT->CYCCNT;
+#endif
+}
+
+/**
+ * @brief 启用计时器（目标板开启 DWT CYCCNT），并测量 BEGIN / END 本身的开销
+ */
+void Profile_Init(void);
+
+/**
+ * @brief 计时节拍频率（Hz），目标板为 SystemCoreClock，主机为 1e9
+ */
+float Profile_ClockHz(void);
+
+/**
+ * @brief 记录一次耗时，由 PROFILE_END 调用
+ * @param stage 调用点的阶段指针，为 NULL 时按名称登记
+ * @param name 阶段名称
+ * @param ticks 耗时（节拍），扣除测得的计时开销后计入
+ */
+void Profile_Record(Profile_Stage **stage, const char *name, uint32_t ticks);
+
+/**
+ * @brief 清除所有阶段的统计，保留已登记的名称
+ */
+void Profile_Reset(void);
+
+/**
+ * @brief 导出统计表，每个阶段依次为 mean、min、max（节拍），可直接交给 VOFA_Send
+ * @param buf 输出缓冲区
+ * @param size 缓冲区可容纳的 float 个数
+ * @retval 写入的 float 个数
+ */
+uint16_t Profile_Export(float *buf, uint16_t size);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,92 @@
+#include "bsp_cordic.h"
+
+#if BSP_CORDIC_MODEL
+#include <math.h>
+
+#define CORDIC_ITERATIONS (4 * CORDIC_PRECISION)
+
+static int32_t cordic_atan[CORDIC_ITERATIONS]; // atan(2^-i) / PI，q1.31
+static int64_t cordic_gain;                    // 增益补偿 K，q1.31
+static int32_t cordic_sin, cordic_cos;         // 上一次计算的结果
+
+/**
+ * @brief 初始化迭代模型的查找表
+ */
+void CORDIC_Init(void) {
+  double gain = 1.0;
+  for (uint8_t i = 0; i < CORDIC_ITERATIONS; i++) {
+    cordic_atan[i] =
+        (int32_t)llround(atan(ldexp(1.0, -i)) / M_PI * 2147483648.0);
+    gain /= sqrt(1.0 + ldexp(1.0, -2 * i));
+  }
+  cordic_gain = llround(gain * 2147483648.0);
+  cordic_sin = 0;
+  cordic_cos = INT32_MAX;
+}
+
+/**
+ * @brief 饱和到 q1.31
+ */
+static int32_t SatQ31(int64_t x) {
+  if (x > INT32_MAX)
+    return INT32_MAX;
+  if (x < INT32_MIN)
+    return INT32_MIN;
+  return (int32_t)x;
+}
+
+/**
+ * @brief 旋转模式 CORDIC 迭代，与硬件相同的 q1.31 定点格式和迭代次数
+ */
+void CORDIC_SinCosStart(int32_t angle) {
+  /* 迭代收敛域为 ±PI/2，超出时先旋转 PI，结果取反 */
+  uint8_t flip = (angle > (INT32_MAX >> 1)) || (angle < (INT32_MIN >> 1));
+  int64_t z = flip ? (int32_t)((uint32_t)angle + 0x80000000U) : angle;
+  int64_t x = cordic_gain, y = 0;
+
+  for (uint8_t i = 0; i < CORDIC_ITERATIONS; i++) {
+    int64_t dx = y >> i, dy = x >> i;
+    if (z >= 0) {
+      x -= dx;
+      y += dy;
+      z -= cordic_atan[i];
+    } else {
+      x += dx;
+      y -= dy;
+      z += cordic_atan[i];
+    }
+  }
+
+  cordic_cos = SatQ31(flip ? -x : x);
+  cordic_sin = SatQ31(flip ? -y : y);
+}
+
+void CORDIC_SinCosRead(int32_t *sin_q31, int32_t *cos_q31) {
+  *sin_q31 = cordic_sin;
+  *cos_q31 = cordic_cos;
+}
+#else
+void CORDIC_Init(void) {
+  __HAL_RCC_CORDIC_CLK_ENABLE();
+
+  /* 先以两个参数写入一次模值 m = 1，之后只需写入角度 */
+  CORDIC->CSR = (0U << CORDIC_CSR_FUNC_Pos) |
+                (CORDIC_PRECISION << CORDIC_CSR_PRECISION_Pos) |
+                CORDIC_CSR_NRES | CORDIC_CSR_NARGS;
+  CORDIC->WDATA = 0;
+  CORDIC->WDATA = 0x7FFFFFFF;
+  (void)CORDIC->RDATA;
+  (void)CORDIC->RDATA;
+
+  CORDIC->CSR = (0U << CORDIC_CSR_FUNC_Pos) |
+                (CORDIC_PRECISION << CORDIC_CSR_PRECISION_Pos) |
+                CORDIC_CSR_NRES;
+}
+
+void CORDIC_SinCosStart(int32_t angle) { CORDIC->WDATA = (uint32_t)angle; }
+
+void CORDIC_SinCosRead(int32_t *sin_q31, int32_t *cos_q31) {
+  *cos_q31 = (int32_t)CORDIC->RDATA; // 第一个结果为 m * cosθ
+  *sin_q31 = (int32_t)CORDIC->RDATA; // 第二个结果为 m * sinθ
+}
+#endif
@@ -0,0 +1,130 @@
+#include "bsp_fmac.h"
+#include "string.h"
+
+#if BSP_FMAC_MODEL
+static FMAC_Filter_Config_s fmac_config;
+static int16_t fmac_x[FMAC_MAX_TAPS]; // x[n] ~ x[n-p+1]
+static int16_t fmac_y[FMAC_MAX_TAPS]; // y[n-1] ~ y[n-q]
+static int16_t fmac_out;
+static uint8_t fmac_sat;
+
+HAL_StatusTypeDef FMAC_Filter_Start(FMAC_Filter_Config_s *config) {
+  if (config == NULL || config->p == 0 || config->p > FMAC_MAX_TAPS ||
+      config->q > FMAC_MAX_TAPS || config->r > 7)
+    return HAL_ERROR;
+
+  fmac_config = *config;
+  for (uint8_t i = 0; i < FMAC_MAX_TAPS; i++) {
+    fmac_x[i] = config->x_init;
+    fmac_y[i] = config->y_init;
+  }
+  fmac_out = config->y_init;
+  fmac_sat = 0;
+  return HAL_OK;
+}
+
+/**
+ * @brief 定点模型：q1.15 乘积在宽累加器中求和，乘以 2^r 后截断为 q1.15，
+ *        超出范围时饱和（对应 CR.CLIPEN = 1）
+ */
+void FMAC_Filter_Write(int16_t x) {
+  memmove(&fmac_x[1], &fmac_x[0], (FMAC_MAX_TAPS - 1) * sizeof(int16_t));
+  fmac_x[0] = x;
+
+  int64_t acc = 0;
+  for (uint8_t k = 0; k < fmac_config.p; k++)
+    acc += (int32_t)fmac_config.coeff_b[k] * fmac_x[k];
+  for (uint8_t k = 0; k < fmac_config.q; k++)
+    acc += (int32_t)fmac_config.coeff_a[k] * fmac_y[k];
+  acc = (acc * ((int64_t)1 << fmac_config.r)) >> 15;
+
+  if (acc > INT16_MAX) {
+    acc = INT16_MAX;
+    fmac_sat = 1;
+  } else if (acc < INT16_MIN) {
+    acc = INT16_MIN;
+    fmac_sat = 1;
+  }
+  fmac_out = (int16_t)acc;
+
+  memmove(&fmac_y[1], &fmac_y[0], (FMAC_MAX_TAPS - 1) * sizeof(int16_t));
+  fmac_y[0] = fmac_out;
+}
+
+int16_t FMAC_Filter_Read(void) { return fmac_out; }
+
+uint8_t FMAC_Filter_Saturated(void) { return fmac_sat; }
+#else
+/**
+ * @brief 向 FMAC 预载 n 个数据
+ * @param func 预载目标（1：X1；2：X2；3：Y）
+ * @param data_p 前 p 个数据，为 NULL 时均写入 fill
+ * @param data_q 后 q 个数据，为 NULL 时均写入 fill
+ */
+static void FMAC_Preload(uint32_t func, uint8_t p, uint8_t q,
+                         const int16_t *data_p, const int16_t *data_q,
+                         int16_t fill) {
+  FMAC->PARAM = (func << FMAC_PARAM_FUNC_Pos) | ((uint32_t)p << FMAC_PARAM_P_Pos) |
+                ((uint32_t)q << FMAC_PARAM_Q_Pos) | FMAC_PARAM_START;
+  for (uint8_t i = 0; i < p; i++)
+    FMAC->WDATA = (uint16_t)(data_p ? data_p[i] : fill);
+  for (uint8_t i = 0; i < q; i++)
+    FMAC->WDATA = (uint16_t)(data_q ? data_q[i] : fill);
+}
+
+HAL_StatusTypeDef FMAC_Filter_Start(FMAC_Filter_Config_s *config) {
+  if (config == NULL || config->p == 0 || config->p > FMAC_MAX_TAPS ||
+      config->q > FMAC_MAX_TAPS || config->r > 7)
+    return HAL_ERROR;
+  if (config->func == FMAC_FUNC_FIR && config->q != 0)
+    return HAL_ERROR;
+
+  __HAL_RCC_FMAC_CLK_ENABLE();
+
+  /* 复位 FMAC，清空缓冲区指针 */
+  FMAC->CR = FMAC_CR_RESET;
+  while (FMAC->CR & FMAC_CR_RESET)
+    ;
+
+  /* 内部存储器划分：| X1 (p + 1) | X2 (p + q) | Y (q + 1) | */
+  uint32_t x1_size = config->p + 1U;
+  uint32_t x2_size = (uint32_t)config->p + config->q;
+  uint32_t y_size = config->q + 1U;
+  FMAC->X1BUFCFG = (0U << FMAC_X1BUFCFG_X1_BASE_Pos) |
+                   (x1_size << FMAC_X1BUFCFG_X1_BUF_SIZE_Pos);
+  FMAC->X2BUFCFG = (x1_size << FMAC_X2BUFCFG_X2_BASE_Pos) |
+                   (x2_size << FMAC_X2BUFCFG_X2_BUF_SIZE_Pos);
+  FMAC->YBUFCFG = ((x1_size + x2_size) << FMAC_YBUFCFG_Y_BASE_Pos) |
+                  (y_size << FMAC_YBUFCFG_Y_BUF_SIZE_Pos);
+
+  /* 载入系数：X2 = | b[0] ~ b[p-1] | a[1] ~ a[q] | */
+  FMAC_Preload(2U, config->p, config->q, config->coeff_b, config->coeff_a, 0);
+
+  /* 初始状态：X1 预载 p - 1 个 x_init，Y 预载 q 个 y_init */
+  if (config->p > 1)
+    FMAC_Preload(1U, config->p - 1U, 0, NULL, NULL, config->x_init);
+  if (config->q > 0)
+    FMAC_Preload(3U, config->q, 0, NULL, NULL, config->y_init);
+
+  /* 输出饱和而非回绕 */
+  FMAC->CR = FMAC_CR_CLIPEN;
+
+  FMAC->PARAM = ((uint32_t)config->func << FMAC_PARAM_FUNC_Pos) |
+                ((uint32_t)config->p << FMAC_PARAM_P_Pos) |
+                ((uint32_t)config->q << FMAC_PARAM_Q_Pos) |
+                ((uint32_t)config->r << FMAC_PARAM_R_Pos) | FMAC_PARAM_START;
+  return HAL_OK;
+}
+
+void FMAC_Filter_Write(int16_t x) { FMAC->WDATA = (uint16_t)x; }
+
+int16_t FMAC_Filter_Read(void) {
+  while (FMAC->SR & FMAC_SR_YEMPTY)
+    ;
+  return (int16_t)FMAC->RDATA;
+}
+
+uint8_t FMAC_Filter_Saturated(void) {
+  return (FMAC->SR & FMAC_SR_SAT) ? 1 : 0;
+}
+#endif
@@ -0,0 +1,74 @@
+#include "bsp_pool.h"
+#include "string.h"
+
+/* 使用过的对象池链表，首次分配时加入 */
+static Pool_Instance *pool_list;
+
+/**
+ * @brief 从对象池分配一个对象
+ * @param pool 对象池
+ * @retval 对象指针
+ */
+void *Pool_Alloc(Pool_Instance *pool) {
+  if (pool == NULL)
+    return NULL;
+
+  if (!pool->linked) {
+    pool->next = pool_list;
+    pool_list = pool;
+    pool->linked = 1;
+  }
+
+  /* 查找第一个空闲对象 */
+  for (uint8_t i = 0; i < pool->capacity; i++) {
+    if (pool->mask & (1UL << i))
+      continue;
+    pool->mask |= (1UL << i);
+    if (++pool->used > pool->peak)
+      pool->peak = pool->used;
+    uint8_t *object = pool->storage + (uint32_t)i * pool->size;
+    memset(object, 0, pool->size);
+    return object;
+  }
+
+  pool->fail++;
+  return NULL;
+}
+
+/**
+ * @brief 归还对象
+ * @param pool 对象池
+ * @param object 对象指针
+ */
+void Pool_Free(Pool_Instance *pool, void *object) {
+  if (pool == NULL || object == NULL)
+    return;
+
+  uint32_t offset = (uint32_t)((uint8_t *)object - pool->storage);
+  uint8_t i = (uint8_t)(offset / pool->size);
+  if ((uint8_t *)object < pool->storage || i >= pool->capacity ||
+      offset % pool->size != 0 || !(pool->mask & (1UL << i)))
+    return;
+  pool->mask &= ~(1UL << i);
+  pool->used--;
+}
+
+/**
+ * @brief 统计所有使用过的对象池
+ * @param stats 统计结果
+ */
+void Pool_GetStats(Pool_Stats *stats) {
+  memset(stats, 0, sizeof(Pool_Stats));
+  for (Pool_Instance *pool = pool_list; pool != NULL; pool = pool->next) {
+    stats->pools++;
+    stats->bytes_total += (uint32_t)pool->capacity * pool->size;
+    stats->bytes_used += (uint32_t)pool->used * pool->size;
+    stats->bytes_peak += (uint32_t)pool->peak * pool->size;
+    stats->fail += pool->fail;
+  }
+}
+
+/**
+ * @brief 统计链表表头
+ */
+Pool_Instance *Pool_List(void) { return pool_list; }
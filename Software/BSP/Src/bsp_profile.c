@@ -0,0 +1,112 @@
+#include "bsp_profile.h"
+#include "string.h"
+
+Profile_Stage profile_table[PROFILE_STAGE_MAX];
+uint8_t profile_stages;
+
+/* PROFILE_BEGIN 紧接 PROFILE_END 时测得的节拍数，记录时扣除 */
+static uint32_t profile_overhead;
+
+/**
+ * @brief 耗时对应的直方图区间
+ */
+static uint8_t HistBin(uint32_t ticks) {
+  if (ticks < (1UL << PROFILE_HIST_SHIFT))
+    return 0;
+  uint8_t bin = (uint8_t)(32 - __builtin_clz(ticks) - PROFILE_HIST_SHIFT);
+  return (bin < PROFILE_HIST_BINS) ? bin : PROFILE_HIST_BINS - 1;
+}
+
+/**
+ * @brief 按名称查找阶段，不存在时登记，表满时返回 NULL
+ */
+static Profile_Stage *StageFind(const char *name) {
+  for (uint8_t i = 0; i < profile_stages; i++) {
+    if (strcmp(profile_table[i].name, name) == 0)
+      return &profile_table[i];
+  }
+  if (profile_stages >= PROFILE_STAGE_MAX)
+    return NULL;
+  Profile_Stage *stage = &profile_table[profile_stages++];
+  stage->name = name;
+  return stage;
+}
+
+/**
+ * @brief 启用计时器并测量计时开销
+ */
+void Profile_Init(void) {
+#if !PROFILE_HOST
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+  /* 取多次中的最小值，排除中断打断的情况 */
+  uint32_t overhead = UINT32_MAX;
+  for (uint8_t i = 0; i < 16; i++) {
+    uint32_t start = Profile_Now();
+    uint32_t ticks = Profile_Now() - start;
+    if (ticks < overhead)
+      overhead = ticks;
+  }
+  profile_overhead = overhead;
+}
+
+/**
+ * @brief 计时节拍频率（Hz）
+ */
+float Profile_ClockHz(void) {
+#if PROFILE_HOST
+  return 1e9f;
+#else
+  return (float)SystemCoreClock;
+#endif
+}
+
+/**
+ * @brief 记录一次耗时
+ */
+void Profile_Record(Profile_Stage **stage, const char *name, uint32_t ticks) {
+  if (*stage == NULL) {
+    *stage = StageFind(name);
+    if (*stage == NULL)
+      return;
+  }
+
+  Profile_Stage *s = *stage;
+  ticks = (ticks > profile_overhead) ? ticks - profile_overhead : 0;
+  s->last = ticks;
+  if (s->count == 0 || ticks < s->min)
+    s->min = ticks;
+  if (ticks > s->max)
+    s->max = ticks;
+  s->sum += ticks;
+  s->count++;
+  s->hist[HistBin(ticks)]++;
+}
+
+/**
+ * @brief 清除统计，保留名称
+ */
+void Profile_Reset(void) {
+  for (uint8_t i = 0; i < profile_stages; i++) {
+    const char *name = profile_table[i].name;
+    memset(&profile_table[i], 0, sizeof(Profile_Stage));
+    profile_table[i].name = name;
+  }
+}
+
+/**
+ * @brief 导出统计表
+ */
+uint16_t Profile_Export(float *buf, uint16_t size) {
+  uint16_t n = 0;
+  for (uint8_t i = 0; i < profile_stages && n + 3 <= size; i++) {
+    Profile_Stage *s = &profile_table[i];
+    buf[n++] = (s->count > 0) ? (float)s->sum / (float)s->count : 0.0f;
+    buf[n++] = (float)s->min;
+    buf[n++] = (float)s->max;
+  }
+  return n;
+}
@@ -1,10 +1,11 @@
 #include "bsp_uart.h"
-#include "stdlib.h"
+#include "bsp_pool.h"
 #include "stm32g4xx_hal_uart_ex.h"
 #include "string.h"
 
 /* UART 所有实例信息 */
 static uint8_t idx; // 已注册的 UART 实例数量
+POOL_DEFINE(uart_pool, UART_Instance, DEVICE_UART_CNT);
 static UART_Instance *usart_instance[DEVICE_UART_CNT] = {
     NULL}; // UART 实例指针数组
 
@@ -29,11 +30,10 @@ UART_Instance *UART_Register(void *device_instance,
     if (usart_instance[i]->uart_handle == init_config->uart_handle)
       return NULL;
 
-  /* 分配内存 */
-  UART_Instance *instance = (UART_Instance *)malloc(sizeof(UART_Instance));
+  /* 从对象池分配 */
+  UART_Instance *instance = (UART_Instance *)Pool_Alloc(&uart_pool);
   if (instance == NULL)
     return NULL;
-  memset(instance, 0, sizeof(UART_Instance));
 
   /* 参数传递 */
   instance->device_instance = device_instance;
@@ -0,0 +1,147 @@
+#ifndef BENCH_H
+#define BENCH_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* ------------------------------------------------- include
+ * ------------------------------------------------- */
+#include "stdint.h"
+#include "stm32g4xx.h"
+
+/* ------------------------------------------------- define
+ * ------------------------------------------------- */
+/* 1：QEMU 仿真的 Cortex-M4（mps2-an386），计时基于 SysTick，单位为周期；
+ * 0：主机，计时基于 CLOCK_MONOTONIC，单位为 ns */
+#ifndef BENCH_M4
+#define BENCH_M4 0
+#endif
+
+/* SysTick 每计一次对应的周期数。QEMU 以 -icount shift=0 运行时每条指令推进 1 ns
+ * 虚拟时间，SysTick 按 25 MHz 计数，即 40 条指令；此时的“周期”实为指令数，
+ * 不含流水线和等待周期，只适合跟踪相对变化。实板运行时改为 1 */
+#ifndef BENCH_M4_TICK_CYCLES
+#define BENCH_M4_TICK_CYCLES 40
+#endif
+
+#define BENCH_INPUTS 4096 // 随机输入个数，同时是边界输入个数的上限
+#define BENCH_REPEAT 7    // 重复计时次数，取最短的一次
+
+#if !BENCH_M4
+#include "bsp_profile.h"
+#endif
+
+/* ------------------------------------------------- typedef
+ * ------------------------------------------------- */
+/* 输入集 */
+typedef enum {
+  BENCH_RANDOM, // 均匀分布的随机输入
+  BENCH_EDGE,   // 扇区边界、零值、值域端点等边界输入
+} Bench_Case;
+
+/* 与双精度参考值的误差统计 */
+typedef struct {
+  uint32_t n;
+  double max;       // 最大绝对误差
+  double sq_sum;    // 误差平方和，rms = sqrt(sq_sum / n)
+  uint32_t failures; // 超出值域或超出容差的个数
+} Bench_Error;
+
+/* ------------------------------------------------- functions
+ * ------------------------------------------------- */
+/**
+ * @brief 启动计时器
+ */
+void Bench_Init(void);
+
+/**
+ * @brief 读取计时节拍
+ */
+static inline uint32_t Bench_Now(void) {
+  __asm__ volatile("" ::: "memory"); // 计时点两侧的内存访问不得被编译器移动
+#if BENCH_M4
+  return SysTick->VAL;
+#else
+  return Profile_Now();
+#endif
+}
+
+/**
+ * @brief 自 start 起经过的时间，主机为 ns，目标为周期
+ */
+static inline uint32_t Bench_Elapsed(uint32_t start) {
+#if BENCH_M4
+  /* SysTick 为 24 位递减计数器，单次计时不得超过一个重装周期 */
+  return ((start - Bench_Now()) & SysTick_LOAD_RELOAD_Msk) *
+         BENCH_M4_TICK_CYCLES;
+#else
+  return Bench_Now() - start;
+#endif
+}
+
+/**
+ * @brief 对被计时的语句计时，每次计时执行 n 次，重复 BENCH_REPEAT 次取最短
+ * @note 被计时的语句（可含逗号）中以 i 作为输入下标；结果含循环本身约 1~2 个周期的开销
+ * @param per_call 输出，每次调用的耗时
+ */
+#define BENCH_TIME(per_call, n, ...)                                           \
+  do {                                                                         \
+    uint32_t bench_best = UINT32_MAX;                                          \
+    for (uint32_t bench_r = 0; bench_r < BENCH_REPEAT; bench_r++) {            \
+      uint32_t bench_start = Bench_Now();                                      \
+      for (uint32_t i = 0; i < (n); i++) {                                     \
+        __VA_ARGS__;                                                           \
+      }                                                                        \
+      uint32_t bench_t = Bench_Elapsed(bench_start);                           \
+      if (bench_t < bench_best)                                                \
+        bench_best = bench_t;                                                  \
+    }                                                                          \
+    (per_call) = (double)bench_best / (double)(n);                             \
+  } while (0)
+
+/**
+ * @brief 均匀分布随机数（xorshift32），序列由 Bench_Seed 决定
+ */
+uint32_t Bench_Rand(void);
+
+/**
+ * @brief [lo, hi) 上均匀分布的随机数
+ */
+float Bench_Uniform(float lo, float hi);
+
+/**
+ * @brief 设置随机数种子，每组输入开始前调用，使输入与运行顺序无关
+ */
+void Bench_Seed(uint32_t seed);
+
+/**
+ * @brief 记录一个误差
+ * @param tolerance 容差，超过时计为失败；为负时不检查
+ */
+void Bench_ErrorAdd(Bench_Error *error, double err, double tolerance);
+
+/**
+ * @brief 输出一行结果
+ * @param kernel 内核名称
+ * @param input_case 输入集
+ * @param n 输入个数
+ * @param per_call 每次调用的耗时
+ * @param error 误差统计
+ * @param unit 误差单位
+ */
+void Bench_Emit(const char *kernel, Bench_Case input_case, uint32_t n,
+                double per_call, const Bench_Error *error, const char *unit);
+
+/**
+ * @brief FOC 内核：Park/Clarke 及其逆变换、角度限制、PWM 调制（浮点与 Q15）
+ */
+void Bench_FOC(void);
+
+/**
+ * @brief AS5047P 内核：奇偶校验、角度回绕
+ */
+void Bench_AS5047P(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,39 @@
+#include "stm32g4xx.h"
+
+/* QEMU mps2-an386 的最小启动代码：向量表只含内核异常，复位后开启 FPU，
+ * 由 newlib 的 _start（rdimon.specs）清零 .bss、初始化半主机并调用 main */
+
+extern uint32_t __stack_top;
+extern void _start(void);
+
+void Reset_Handler(void) {
+  SCB->CPACR |= (3UL << 20) | (3UL << 22); // CP10、CP11 全访问
+  __DSB();
+  __ISB();
+  _start();
+}
+
+static void Default_Handler(void) {
+  while (1) {
+  }
+}
+
+__attribute__((section(".isr_vector"), used)) static void (
+    *const vectors[16])(void) = {
+    (void (*)(void))&__stack_top,
+    Reset_Handler,
+    Default_Handler, // NMI
+    Default_Handler, // HardFault
+    Default_Handler, // MemManage
+    Default_Handler, // BusFault
+    Default_Handler, // UsageFault
+    0,
+    0,
+    0,
+    0,
+    Default_Handler, // SVCall
+    Default_Handler, // DebugMonitor
+    0,
+    Default_Handler, // PendSV
+    Default_Handler, // SysTick
+};
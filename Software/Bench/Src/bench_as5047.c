@@ -0,0 +1,143 @@
+/* 内核均为 as5047.c 中的 static 函数，直接包含源文件 */
+#include "as5047.c"
+
+#include "bench.h"
+#include "float.h"
+#include <math.h>
+
+#define BENCH_2PI 6.283185307179586476925
+#define BENCH_PI 3.141592653589793238463
+#define BENCH_WORDS 65536 // 16 位数据的全部取值
+
+static uint16_t in_word[BENCH_WORDS];
+static uint16_t out_word[BENCH_WORDS];
+static float in_angle[BENCH_INPUTS];
+static float out_angle[BENCH_INPUTS];
+
+/**
+ * @brief 两个角度在圆周上的距离
+ */
+static double AngleDistance(double a, double b) {
+  double d = fmod(fabs(a - b), BENCH_2PI);
+  return fmin(d, BENCH_2PI - d);
+}
+
+/**
+ * @brief 奇偶校验，边界输入为 16 位数据的全部取值
+ */
+static void BenchParity(Bench_Case input_case) {
+  uint32_t n;
+  if (input_case == BENCH_RANDOM) {
+    for (n = 0; n < BENCH_INPUTS; n++)
+      in_word[n] = (uint16_t)Bench_Rand();
+  } else {
+    for (n = 0; n < BENCH_WORDS; n++)
+      in_word[n] = (uint16_t)n;
+  }
+
+  double t;
+  BENCH_TIME(t, n, out_word[i] = Parity_bit_Calculate(in_word[i]));
+
+  Bench_Error error = {0};
+  for (uint32_t i = 0; i < n; i++)
+    Bench_ErrorAdd(&error,
+                   (out_word[i] != (uint16_t)__builtin_parity(in_word[i])),
+                   0.0);
+  Bench_Emit("Parity_bit_Calculate", input_case, n, t, &error, "bit");
+}
+
+/**
+ * @brief 生成角度输入
+ * @param lo 随机输入下限
+ * @param hi 随机输入上限
+ * @param edge 边界输入
+ * @param edges 边界输入个数
+ */
+static uint32_t GenAngle(Bench_Case input_case, float lo, float hi,
+                         const float *edge, uint32_t edges) {
+  uint32_t n = 0;
+  if (input_case == BENCH_RANDOM) {
+    for (; n < BENCH_INPUTS; n++)
+      in_angle[n] = Bench_Uniform(lo, hi);
+  } else {
+    for (; n < edges; n++)
+      in_angle[n] = edge[n];
+  }
+  return n;
+}
+
+/**
+ * @brief 弧度回绕到 [0, 2PI)，输入只允许超出一圈
+ */
+static void BenchRadLimit(Bench_Case input_case) {
+  const float edge[] = {0.0f,
+                        -0.0f,
+                        FLT_TRUE_MIN,
+                        -FLT_TRUE_MIN,
+                        -1e-7f,
+                        PI,
+                        2 * PI,
+                        nextafterf(2 * PI, 0.0f),
+                        nextafterf(2 * PI, 8.0f),
+                        -2 * PI,
+                        nextafterf(-2 * PI, 0.0f),
+                        nextafterf(4 * PI, 0.0f)};
+  uint32_t n = GenAngle(input_case, -2 * PI, 4 * PI, edge,
+                        sizeof(edge) / sizeof(edge[0]));
+  double t;
+  BENCH_TIME(t, n, out_angle[i] = Rad_Limit(in_angle[i]));
+
+  Bench_Error error = {0};
+  for (uint32_t i = 0; i < n; i++) {
+    double ref = fmod(in_angle[i], BENCH_2PI);
+    if (ref < 0.0)
+      ref += BENCH_2PI;
+    Bench_ErrorAdd(&error, AngleDistance(out_angle[i], ref), 1e-6);
+    if (out_angle[i] < 0.0f || out_angle[i] >= 2 * PI)
+      error.failures++;
+  }
+  Bench_Emit("Rad_Limit", input_case, n, t, &error, "rad");
+}
+
+/**
+ * @brief 弧度差回绕到 [-PI, PI)，输入只允许超出一圈
+ */
+static void BenchRadErrLimit(Bench_Case input_case) {
+  const float edge[] = {0.0f,
+                        -0.0f,
+                        FLT_TRUE_MIN,
+                        -FLT_TRUE_MIN,
+                        PI,
+                        -PI,
+                        nextafterf(PI, 0.0f),
+                        nextafterf(-PI, 0.0f),
+                        nextafterf(-PI, -8.0f),
+                        3 * PI,
+                        nextafterf(3 * PI, 0.0f),
+                        -3 * PI};
+  uint32_t n = GenAngle(input_case, -3 * PI, 3 * PI, edge,
+                        sizeof(edge) / sizeof(edge[0]));
+  double t;
+  BENCH_TIME(t, n, out_angle[i] = RadErr_Limit(in_angle[i]));
+
+  Bench_Error error = {0};
+  for (uint32_t i = 0; i < n; i++) {
+    double ref = fmod((double)in_angle[i] + BENCH_PI, BENCH_2PI);
+    if (ref < 0.0)
+      ref += BENCH_2PI;
+    ref -= BENCH_PI;
+    Bench_ErrorAdd(&error, AngleDistance(out_angle[i], ref), 1e-6);
+    if (out_angle[i] < -PI || out_angle[i] >= PI)
+      error.failures++;
+  }
+  Bench_Emit("RadErr_Limit", input_case, n, t, &error, "rad");
+}
+
+void Bench_AS5047P(void) {
+  for (Bench_Case c = BENCH_RANDOM; c <= BENCH_EDGE; c++) {
+    Bench_Seed(0x5047u + c);
+    BenchParity(c);
+    BenchRadLimit(c);
+    BenchRadErrLimit(c);
+  }
+}
@@ -0,0 +1,524 @@
+/* 内核均为 foc.c 中的 static 函数，直接包含源文件以便在同一编译单元内调用和内联；
+ * 同时打开 Q15 定点路径，浮点与定点内核在同一次运行中对比 */
+#define FOC_FIXED_POINT 1
+#include "foc.c"
+
+#include "bench.h"
+#include "sim_legacy_pwm.h"
+#include "float.h"
+#include <math.h>
+
+#define BENCH_VBUS 12.0f     // 母线电压（V）
+#define BENCH_PERIOD 4249    // TIM1 ARR，20 kHz 中心对齐
+#define BENCH_2PI 6.283185307179586476925
+
+static abc_Typedef in_abc[BENCH_INPUTS];
+static AlphaBeta_Typedef in_ab[BENCH_INPUTS];
+static dq_Typedef in_dq[BENCH_INPUTS];
+static SinCos_Typedef in_sc[BENCH_INPUTS];
+static float in_angle[BENCH_INPUTS];
+static q15_t in_q15[BENCH_INPUTS][3]; // d/α、q/β、θ
+
+static abc_Typedef out_abc[BENCH_INPUTS];
+static AlphaBeta_Typedef out_ab[BENCH_INPUTS];
+static dq_Typedef out_dq[BENCH_INPUTS];
+static float out_angle[BENCH_INPUTS];
+static AlphaBeta_q15_Typedef out_ab_q15[BENCH_INPUTS];
+static abc_q15_Typedef out_abc_q15[BENCH_INPUTS];
+static uint16_t out_ccr[BENCH_INPUTS][3];
+
+static FOC_Instance bench_foc;
+static TIM_HandleTypeDef bench_htim;
+
+/* ---------------- 输入生成 Begin ---------------- */
+/**
+ * @brief 边界角度：每 30° 一个（六个扇区边界及其中点），以及相邻的浮点数
+ * @return 角度个数
+ */
+static uint32_t EdgeAngles(float *angle) {
+  uint32_t n = 0;
+  for (uint32_t k = 0; k < 12; k++) {
+    float a = (float)k * (PI / 6.0f);
+    angle[n++] = a;
+    angle[n++] = nextafterf(a, (k == 0) ? 1.0f : 0.0f);
+    angle[n++] = (k == 0) ? nextafterf(_2PI, 0.0f) : nextafterf(a, 8.0f);
+  }
+  return n;
+}
+
+/**
+ * @brief 生成二维矢量输入，同一组数值同时填入 dq、αβ、abc（c = -a - b）
+ * @param scale 分量幅值
+ * @return 输入个数
+ */
+static uint32_t GenVector(Bench_Case input_case, float scale) {
+  uint32_t n = 0;
+  if (input_case == BENCH_RANDOM) {
+    for (; n < BENCH_INPUTS; n++) {
+      in_dq[n].d = Bench_Uniform(-scale, scale);
+      in_dq[n].q = Bench_Uniform(-scale, scale);
+      in_angle[n] = Bench_Uniform(0.0f, _2PI);
+    }
+  } else {
+    const float comp[] = {0.0f,    FLT_MIN,         -FLT_MIN, 1e-6f * scale,
+                          -1e-6f * scale, scale, -scale};
+    const uint32_t comps = sizeof(comp) / sizeof(comp[0]);
+    float angle[36];
+    uint32_t angles = EdgeAngles(angle);
+    for (uint32_t k = 0; k < angles; k++)
+      for (uint32_t x = 0; x < comps; x++)
+        for (uint32_t y = 0; y < comps; y++, n++) {
+          in_dq[n].d = comp[x];
+          in_dq[n].q = comp[y];
+          in_angle[n] = angle[k];
+        }
+  }
+  for (uint32_t i = 0; i < n; i++) {
+    in_ab[i].Alpha = in_dq[i].d;
+    in_ab[i].Beta = in_dq[i].q;
+    in_abc[i].a = in_dq[i].d;
+    in_abc[i].b = in_dq[i].q;
+    in_abc[i].c = -in_dq[i].d - in_dq[i].q;
+    in_sc[i].sin = arm_sin_f32(in_angle[i]);
+    in_sc[i].cos = arm_cos_f32(in_angle[i]);
+  }
+  return n;
+}
+
+/**
+ * @brief 生成对称三相电压，幅值覆盖线性区边界两侧
+ * @return 输入个数
+ */
+static uint32_t GenPhase(Bench_Case input_case) {
+  const float linear = BENCH_VBUS * INV_SQRT3; // 六边形内切圆半径
+  uint32_t n = 0;
+  if (input_case == BENCH_RANDOM) {
+    for (; n < BENCH_INPUTS; n++) {
+      in_dq[n].d = Bench_Uniform(0.0f, 1.1f * linear);
+      in_angle[n] = Bench_Uniform(0.0f, _2PI);
+    }
+  } else {
+    const float mag[] = {0.0f, 0.5f * BENCH_VBUS, nextafterf(linear, 0.0f),
+                         linear, 1.1f * linear};
+    float angle[36];
+    uint32_t angles = EdgeAngles(angle);
+    for (uint32_t k = 0; k < angles; k++)
+      for (uint32_t m = 0; m < sizeof(mag) / sizeof(mag[0]); m++, n++) {
+        in_dq[n].d = mag[m];
+        in_angle[n] = angle[k];
+      }
+  }
+  for (uint32_t i = 0; i < n; i++) {
+    AlphaBeta_Typedef ab = {in_dq[i].d * arm_cos_f32(in_angle[i]),
+                            in_dq[i].d * arm_sin_f32(in_angle[i])};
+    in_ab[i] = ab;
+    InClarke(&ab, &in_abc[i]);
+  }
+  return n;
+}
+
+/**
+ * @brief 生成 Q15 输入：两个分量和一个角度
+ * @param scale 分量幅值（Q15）
+ * @return 输入个数
+ */
+static uint32_t GenQ15(Bench_Case input_case, int32_t scale) {
+  uint32_t n = 0;
+  if (input_case == BENCH_RANDOM) {
+    for (; n < BENCH_INPUTS; n++) {
+      in_q15[n][0] = (q15_t)((int32_t)(Bench_Rand() % (2 * scale)) - scale);
+      in_q15[n][1] = (q15_t)((int32_t)(Bench_Rand() % (2 * scale)) - scale);
+      in_q15[n][2] = (q15_t)(Bench_Rand() & 0x7FFF);
+    }
+  } else {
+    const q15_t comp[] = {0, 1, -1, Q15_HALF, -Q15_HALF, Q15_MAX, Q15_MIN};
+    const uint32_t comps = sizeof(comp) / sizeof(comp[0]);
+    for (uint32_t k = 0; k < 12; k++) {
+      q15_t theta = (q15_t)((k * 32768 + 6) / 12); // 每 30° 一个
+      for (int32_t d = -1; d <= 1; d++)
+        for (uint32_t x = 0; x < comps; x++)
+          for (uint32_t y = 0; y < comps; y++, n++) {
+            in_q15[n][0] = comp[x];
+            in_q15[n][1] = comp[y];
+            in_q15[n][2] = (q15_t)((theta + d) & 0x7FFF);
+          }
+    }
+  }
+  return n;
+}
+/* ---------------- 输入生成  End  ---------------- */
+
+/* ---------------- 参考实现 Begin ---------------- */
+static double RefMax3(double a, double b, double c) {
+  return fmax(fmax(a, b), c);
+}
+
+static double RefMin3(double a, double b, double c) {
+  return fmin(fmin(a, b), c);
+}
+
+/**
+ * @brief 双精度零序分量
+ * @param alt 输出，钳位方向恰好处于切换点时的另一个取值，否则与返回值相同
+ */
+static double RefZeroSequence(FOC_Modulation modulation, double a, double b,
+                              double c, double half, double *alt) {
+  double max = RefMax3(a, b, c), min = RefMin3(a, b, c);
+  double top = half - max, bottom = -half - min;
+  double sel;
+  switch (modulation) {
+  case FOC_SVPWM:
+    *alt = -0.5 * (max + min);
+    return *alt;
+  case FOC_THIPWM: {
+    double sq = a * a + b * b + c * c;
+    *alt = (sq > 0.0) ? -a * b * c / sq : 0.0;
+    return *alt;
+  }
+  case FOC_DPWM0:
+    sel = RefMax3(a - b, b - c, c - a) + RefMin3(a - b, b - c, c - a);
+    break;
+  case FOC_DPWM1:
+  case FOC_DPWM3:
+    sel = max + min;
+    break;
+  case FOC_DPWM2:
+    sel = RefMax3(a - c, b - a, c - b) + RefMin3(a - c, b - a, c - b);
+    break;
+  case FOC_SPWM:
+  default:
+    *alt = 0.0;
+    return 0.0;
+  }
+  if (modulation == FOC_DPWM3) {
+    double t = top;
+    top = bottom;
+    bottom = t;
+  }
+  double u0 = (sel >= 0.0) ? top : bottom;
+  *alt = (fabs(sel) <= 1e-5 * half) ? ((sel >= 0.0) ? bottom : top) : u0;
+  return u0;
+}
+
+/**
+ * @brief 双精度 CCR（未取整）
+ */
+static double RefCCR(double u, double u0) {
+  double ccr = (u + u0) / BENCH_VBUS * BENCH_PERIOD + 0.5 * BENCH_PERIOD;
+  return fmin(fmax(ccr, 0.0), BENCH_PERIOD);
+}
+
+/**
+ * @brief 两个角度在圆周上的距离
+ */
+static double AngleDistance(double a, double b) {
+  double d = fmod(fabs(a - b), BENCH_2PI);
+  return fmin(d, BENCH_2PI - d);
+}
+
+/**
+ * @brief Q15 参考值取整并饱和
+ */
+static double RefQ15(double x) {
+  x *= 32768.0;
+  return fmin(fmax(x, -32768.0), 32767.0);
+}
+/* ---------------- 参考实现  End  ---------------- */
+
+/* ---------------- 内核 Begin ---------------- */
+static void BenchInPark(Bench_Case input_case) {
+  uint32_t n = GenVector(input_case, BENCH_VBUS);
+  double t;
+  BENCH_TIME(t, n, InPark(&in_dq[i], &out_ab[i], &in_sc[i]));
+
+  Bench_Error error = {0};
+  for (uint32_t i = 0; i < n; i++) {
+    double d = in_dq[i].d, q = in_dq[i].q;
+    double c = in_sc[i].cos, s = in_sc[i].sin;
+    double ea = fabs(out_ab[i].Alpha - (d * c - q * s));
+    double eb = fabs(out_ab[i].Beta - (d * s + q * c));
+    Bench_ErrorAdd(&error, fmax(ea, eb), 4.0 * FLT_EPSILON * BENCH_VBUS);
+  }
+  Bench_Emit("InPark", input_case, n, t, &error, "V");
+}
+
+static void BenchPark(Bench_Case input_case) {
+  uint32_t n = GenVector(input_case, BENCH_VBUS);
+  double t;
+  BENCH_TIME(t, n, Park(&in_ab[i], &out_dq[i], &in_sc[i]));
+
+  Bench_Error error = {0};
+  for (uint32_t i = 0; i < n; i++) {
+    double a = in_ab[i].Alpha, b = in_ab[i].Beta;
+    double c = in_sc[i].cos, s = in_sc[i].sin;
+    double ed = fabs(out_dq[i].d - (a * c + b * s));
+    double eq = fabs(out_dq[i].q - (-a * s + b * c));
+    Bench_ErrorAdd(&error, fmax(ed, eq), 4.0 * FLT_EPSILON * BENCH_VBUS);
+  }
+  Bench_Emit("Park", input_case, n, t, &error, "V");
+}
+
+static void BenchInClarke(Bench_Case input_case) {
+  uint32_t n = GenVector(input_case, BENCH_VBUS);
+  double t;
+  BENCH_TIME(t, n, InClarke(&in_ab[i], &out_abc[i]));
+
+  Bench_Error error = {0};
+  for (uint32_t i = 0; i < n; i++) {
+    double a = in_ab[i].Alpha, b = in_ab[i].Beta;
+    double ea = fabs(out_abc[i].a - a);
+    double eb = fabs(out_abc[i].b - (-0.5 * a + sqrt(3.0) / 2.0 * b));
+    double ec = fabs(out_abc[i].c - (-0.5 * a - sqrt(3.0) / 2.0 * b));
+    Bench_ErrorAdd(&error, fmax(ea, fmax(eb, ec)),
+                   4.0 * FLT_EPSILON * BENCH_VBUS);
+  }
+  Bench_Emit("InClarke", input_case, n, t, &error, "V");
+}
+
+static void BenchClarke(Bench_Case input_case) {
+  uint32_t n = GenVector(input_case, BENCH_VBUS);
+  double t;
+  BENCH_TIME(t, n, Clarke(&in_abc[i], &out_ab[i]));
+
+  Bench_Error error = {0};
+  for (uint32_t i = 0; i < n; i++) {
+    double a = in_abc[i].a, b = in_abc[i].b;
+    double ea = fabs(out_ab[i].Alpha - a);
+    double eb = fabs(out_ab[i].Beta - (a + 2.0 * b) / sqrt(3.0));
+    Bench_ErrorAdd(&error, fmax(ea, eb), 4.0 * FLT_EPSILON * BENCH_VBUS);
+  }
+  Bench_Emit("Clarke", input_case, n, t, &error, "V");
+}
+
+/**
+ * @brief AngleLimit 的输入不限圈数，误差不随回绕次数增加；
+ *        输出须在 [0, 2PI) 内，否则计为失败
+ */
+static void BenchAngleLimit(Bench_Case input_case) {
+  uint32_t n = 0;
+  if (input_case == BENCH_RANDOM) {
+    for (; n < BENCH_INPUTS; n++)
+      in_angle[n] = Bench_Uniform(-4.0f * _2PI, 4.0f * _2PI);
+  } else {
+    const float edge[] = {0.0f,
+                          -0.0f,
+                          FLT_TRUE_MIN,
+                          -FLT_TRUE_MIN,
+                          -1e-7f,
+                          PI,
+                          -PI,
+                          _2PI,
+                          nextafterf(_2PI, 0.0f),
+                          nextafterf(_2PI, 8.0f),
+                          -_2PI,
+                          nextafterf(-_2PI, 0.0f),
+                          2.0f * _2PI,
+                          -2.0f * _2PI,
+                          1000.0f,
+                          -1000.0f};
+    for (; n < sizeof(edge) / sizeof(edge[0]); n++)
+      in_angle[n] = edge[n];
+  }
+
+  double t;
+  BENCH_TIME(t, n, {
+    float theta = in_angle[i];
+    AngleLimit(&theta);
+    out_angle[i] = theta;
+  });
+
+  Bench_Error error = {0};
+  for (uint32_t i = 0; i < n; i++) {
+    double x = in_angle[i];
+    double ref = fmod(x, BENCH_2PI);
+    if (ref < 0.0)
+      ref += BENCH_2PI;
+    Bench_ErrorAdd(&error, AngleDistance(out_angle[i], ref), 1e-6);
+    if (out_angle[i] < 0.0f || out_angle[i] >= _2PI)
+      error.failures++;
+  }
+  Bench_Emit("AngleLimit", input_case, n, t, &error, "rad");
+}
+
+/**
+ * @brief 零序注入 + CCR 计算（SetPWM），误差以 CCR 计数为单位，
+ *        与双精度取整结果相差超过 1 个计数计为失败
+ */
+static void BenchSetPWM(Bench_Case input_case, FOC_Modulation modulation,
+                        const char *name) {
+  uint32_t n = GenPhase(input_case);
+  bench_foc.pwm.modulation = modulation;
+  double t;
+  BENCH_TIME(t, n, {
+    bench_foc.param.Uabc = in_abc[i];
+    SetPWM(&bench_foc);
+  });
+
+  for (uint32_t i = 0; i < n; i++) {
+    bench_foc.param.Uabc = in_abc[i];
+    SetPWM(&bench_foc);
+    out_ccr[i][0] = (uint16_t)TIM1->CCR1;
+    out_ccr[i][1] = (uint16_t)TIM1->CCR2;
+    out_ccr[i][2] = (uint16_t)TIM1->CCR3;
+  }
+
+  Bench_Error error = {0};
+  for (uint32_t i = 0; i < n; i++) {
+    double u[3] = {in_abc[i].a, in_abc[i].b, in_abc[i].c};
+    double alt;
+    double u0 = RefZeroSequence(modulation, u[0], u[1], u[2],
+                                0.5 * BENCH_VBUS, &alt);
+    double worst = 0.0;
+    for (uint8_t p = 0; p < 3; p++) {
+      double e = fabs(out_ccr[i][p] - RefCCR(u[p], u0));
+      double e_alt = fabs(out_ccr[i][p] - RefCCR(u[p], alt));
+      worst = fmax(worst, fmin(e, e_alt));
+    }
+    /* 取整为截断，正常误差在 [0, 1) 内 */
+    Bench_ErrorAdd(&error, worst, 1.0);
+  }
+  Bench_Emit(name, input_case, n, t, &error, "count");
+}
+
+/**
+ * @brief 零序注入之前的 FOC_SetSPWM / SetSVPWM（Sim/Inc/sim_legacy_pwm.h），
+ *        与 SetPWM_SPWM、SetPWM_SVPWM 的耗时对比。原实现没有限幅，
+ *        误差只统计各自线性区内的输入；原 SetSVPWM 的 CCR 按 period - 2 * CCR
+ *        换算为高电平时间，含两倍截断。原 SetSVPWM 在零电压矢量时扇区判断为 0，
+ *        CCR 未赋值（替换它的原因之一），零矢量输入不计入误差
+ */
+static void BenchLegacySetPWM(Bench_Case input_case, FOC_Modulation modulation,
+                              const char *name) {
+  uint32_t n = GenPhase(input_case);
+  double t;
+  if (modulation == FOC_SVPWM) {
+    BENCH_TIME(t, n, {
+      bench_foc.param.UAlphaBeta = in_ab[i];
+      Legacy_SetSVPWM(&bench_foc);
+    });
+  } else {
+    BENCH_TIME(t, n, {
+      bench_foc.param.Uabc = in_abc[i];
+      Legacy_SetSPWM(&bench_foc);
+    });
+  }
+
+  double linear = (modulation == FOC_SVPWM) ? BENCH_VBUS / sqrt(3.0)
+                                            : 0.5 * BENCH_VBUS;
+  Bench_Error error = {0};
+  for (uint32_t i = 0; i < n; i++) {
+    if (in_dq[i].d >= linear ||
+        (modulation == FOC_SVPWM && in_dq[i].d == 0.0f))
+      continue;
+    bench_foc.param.Uabc = in_abc[i];
+    bench_foc.param.UAlphaBeta = in_ab[i];
+    double u[3] = {in_abc[i].a, in_abc[i].b, in_abc[i].c};
+    double alt, u0 = 0.0, tolerance = 1.0;
+    uint32_t ccr[3];
+    if (modulation == FOC_SVPWM) {
+      Legacy_SetSVPWM(&bench_foc);
+      u0 = RefZeroSequence(FOC_SVPWM, u[0], u[1], u[2], 0.5 * BENCH_VBUS,
+                           &alt);
+      tolerance = 2.0;
+    } else {
+      Legacy_SetSPWM(&bench_foc);
+    }
+    ccr[0] = TIM1->CCR1;
+    ccr[1] = TIM1->CCR2;
+    ccr[2] = TIM1->CCR3;
+    double worst = 0.0;
+    for (uint8_t p = 0; p < 3; p++) {
+      double high = (modulation == FOC_SVPWM)
+                        ? (double)BENCH_PERIOD - 2.0 * ccr[p]
+                        : (double)ccr[p];
+      worst = fmax(worst, fabs(high - RefCCR(u[p], u0)));
+    }
+    Bench_ErrorAdd(&error, worst, tolerance);
+  }
+  Bench_Emit(name, input_case, n, t, &error, "count");
+}
+
+/**
+ * @brief Park 逆变换（Q15），含 arm_sin_q15 / arm_cos_q15 查表，
+ *        参考值按精确角度计算，误差以 Q15 LSB 为单位；
+ *        CMSIS 查表插值的 sin/cos 误差至多 5 LSB（Sim/Test/test_q15.c），
+ *        按 |d|、|q| 加权后再加 1 LSB 的截断
+ */
+static void BenchInParkQ15(Bench_Case input_case) {
+  uint32_t n = GenQ15(input_case, Q15_HALF);
+  double t;
+  BENCH_TIME(t, n,
+             InPark_q15(in_q15[i][0], in_q15[i][1], in_q15[i][2],
+                        &out_ab_q15[i]));
+
+  Bench_Error error = {0};
+  for (uint32_t i = 0; i < n; i++) {
+    double d = in_q15[i][0] / 32768.0, q = in_q15[i][1] / 32768.0;
+    double theta = in_q15[i][2] * (BENCH_2PI / 32768.0);
+    double ea = fabs(out_ab_q15[i].Alpha -
+                     RefQ15(d * cos(theta) - q * sin(theta)));
+    double eb = fabs(out_ab_q15[i].Beta -
+                     RefQ15(d * sin(theta) + q * cos(theta)));
+    Bench_ErrorAdd(&error, fmax(ea, eb), 1.0 + 5.0 * (fabs(d) + fabs(q)));
+  }
+  Bench_Emit("InPark_q15", input_case, n, t, &error, "lsb");
+}
+
+static void BenchInClarkeQ15(Bench_Case input_case) {
+  uint32_t n = GenQ15(input_case, 32768);
+  double t;
+  BENCH_TIME(t, n, {
+    AlphaBeta_q15_Typedef ab = {in_q15[i][0], in_q15[i][1]};
+    InClarke_q15(&ab, &out_abc_q15[i]);
+  });
+
+  Bench_Error error = {0};
+  for (uint32_t i = 0; i < n; i++) {
+    double a = in_q15[i][0] / 32768.0, b = in_q15[i][1] / 32768.0;
+    double ea = fabs(out_abc_q15[i].a - RefQ15(a));
+    double eb =
+        fabs(out_abc_q15[i].b - RefQ15(-0.5 * a + sqrt(3.0) / 2.0 * b));
+    double ec =
+        fabs(out_abc_q15[i].c - RefQ15(-0.5 * a - sqrt(3.0) / 2.0 * b));
+    Bench_ErrorAdd(&error, fmax(ea, fmax(eb, ec)), 2.0);
+  }
+  Bench_Emit("InClarke_q15", input_case, n, t, &error, "lsb");
+}
+/* ---------------- 内核  End  ---------------- */
+
+void Bench_FOC(void) {
+  static const struct {
+    FOC_Modulation modulation;
+    const char *name;
+  } modulations[] = {
+      {FOC_SPWM, "SetPWM_SPWM"},   {FOC_SVPWM, "SetPWM_SVPWM"},
+      {FOC_THIPWM, "SetPWM_THIPWM"}, {FOC_DPWM0, "SetPWM_DPWM0"},
+      {FOC_DPWM1, "SetPWM_DPWM1"}, {FOC_DPWM2, "SetPWM_DPWM2"},
+      {FOC_DPWM3, "SetPWM_DPWM3"},
+  };
+
+  /* SetPWM 只用到 PWM 和母线电压参数，不经 FOC_Register 初始化 */
+  bench_htim.Instance = TIM1;
+  bench_foc.pwm.tim = &bench_htim;
+  bench_foc.pwm.period = BENCH_PERIOD;
+  bench_foc.pwm.om_gain = 1.0f;
+  bench_foc.pwm.mi = 0.0f;
+  bench_foc.param.powerVol = BENCH_VBUS;
+  bench_foc.param.powerVol_half = 0.5f * BENCH_VBUS;
+  bench_foc.param.powerVol_inv = 1.0f / BENCH_VBUS;
+
+  for (Bench_Case c = BENCH_RANDOM; c <= BENCH_EDGE; c++) {
+    Bench_Seed(0x1234u + c);
+    BenchInPark(c);
+    BenchPark(c);
+    BenchInClarke(c);
+    BenchClarke(c);
+    BenchAngleLimit(c);
+    for (uint32_t m = 0; m < sizeof(modulations) / sizeof(modulations[0]); m++)
+      BenchSetPWM(c, modulations[m].modulation, modulations[m].name);
+    BenchLegacySetPWM(c, FOC_SPWM, "Legacy_SetSPWM");
+    BenchLegacySetPWM(c, FOC_SVPWM, "Legacy_SetSVPWM");
+    BenchInParkQ15(c);
+    BenchInClarkeQ15(c);
+  }
+}
@@ -0,0 +1,106 @@
+#include "bench.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include <math.h>
+
+/* 结果为 CSV，每行一个内核和输入集：
+ * kernel,case,inputs,time_per_call,time_unit,max_err,rms_err,err_unit,failures
+ * time_unit 在主机上为 ns，在 Cortex-M4 上为 cycles */
+
+static FILE *csv;
+static uint8_t summary; // 1：结果写入文件，同时在终端打印摘要
+static uint32_t failed; // 有失败输入的结果行数
+static uint32_t rand_state = 1;
+
+void Bench_Init(void) {
+#if BENCH_M4
+  SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+  SysTick->VAL = 0;
+  SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+#endif
+}
+
+uint32_t Bench_Rand(void) {
+  uint32_t x = rand_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  rand_state = x;
+  return x;
+}
+
+float Bench_Uniform(float lo, float hi) {
+  return lo + (hi - lo) * (float)(Bench_Rand() >> 8) * (1.0f / 16777216.0f);
+}
+
+void Bench_Seed(uint32_t seed) { rand_state = seed ? seed : 1; }
+
+void Bench_ErrorAdd(Bench_Error *error, double err, double tolerance) {
+  error->n++;
+  error->sq_sum += err * err;
+  if (err > error->max)
+    error->max = err;
+  if (tolerance >= 0.0 && err > tolerance)
+    error->failures++;
+}
+
+void Bench_Emit(const char *kernel, Bench_Case input_case, uint32_t n,
+                double per_call, const Bench_Error *error, const char *unit) {
+  const char *name = (input_case == BENCH_RANDOM) ? "random" : "edge";
+  const char *time_unit = BENCH_M4 ? "cycles" : "ns";
+  double rms = error->n ? sqrt(error->sq_sum / error->n) : 0.0;
+  if (error->failures)
+    failed++;
+
+  fprintf(csv, "%s,%s,%lu,%.3f,%s,%.6g,%.6g,%s,%lu\n", kernel, name,
+          (unsigned long)n, per_call, time_unit, error->max, rms, unit,
+          (unsigned long)error->failures);
+  if (summary)
+    printf("%-22s %-6s %8.2f %-6s max %-10.3g %-5s %s\n", kernel, name,
+           per_call, time_unit, error->max, unit,
+           error->failures ? "FAIL" : "ok");
+}
+
+static void Usage(const char *prog) {
+  printf("usage: %s [-o results.csv]\n"
+         "  -o FILE  write CSV results to FILE (default: stdout)\n"
+         "exit status is 1 if any result row has failures\n",
+         prog);
+}
+
+int main(int argc, char **argv) {
+  const char *path = NULL;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+      path = argv[++i];
+    } else {
+      Usage(argv[0]);
+      return (strcmp(argv[i], "-h") == 0) ? 0 : 2;
+    }
+  }
+
+  csv = stdout;
+  if (path != NULL) {
+    csv = fopen(path, "w");
+    if (csv == NULL) {
+      perror(path);
+      return 1;
+    }
+    summary = 1;
+  }
+
+  Bench_Init();
+  fprintf(csv, "kernel,case,inputs,time_per_call,time_unit,max_err,rms_err,"
+               "err_unit,failures\n");
+  Bench_FOC();
+  Bench_AS5047P();
+
+  if (csv != stdout)
+    fclose(csv);
+  if (failed) {
+    fprintf(stderr, "%lu result rows with failures\n", (unsigned long)failed);
+    return 1;
+  }
+  return 0;
+}
@@ -38,8 +38,6 @@ extern TIM_HandleTypeDef htim2;
 
 extern TIM_HandleTypeDef htim3;
 
-extern TIM_HandleTypeDef htim6;
-
 /* USER CODE BEGIN Private defines */
 
 /* USER CODE END Private defines */
@@ -47,7 +45,6 @@ extern TIM_HandleTypeDef htim6;
 void MX_TIM1_Init(void);
 void MX_TIM2_Init(void);
 void MX_TIM3_Init(void);
-void MX_TIM6_Init(void);
 
 void HAL_TIM_MspPostInit(TIM_HandleTypeDef *htim);
 
@@ -34,8 +34,10 @@
 /* USER CODE BEGIN Includes */
 #include "vofa.h"
 #include "foc.h"
+#include "cascade.h"
 #include "arm_math.h"
 #include "as5047.h"
+#include "bsp_profile.h"
 #include <math.h>
 /* USER CODE END Includes */
 
@@ -46,6 +48,21 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
+#define CURRENT_AMP_GAIN 50.0f   // INA240A2 放大倍数
+#define CURRENT_SHUNT_RES 0.01f  // 采样电阻（Ω），按实际板卡修改
+#define CURRENT_ADC_GAIN (3.3f / 4096.0f / CURRENT_AMP_GAIN / CURRENT_SHUNT_RES)
+#define VBUS_DIVIDER 19.0f       // 母线电压分压比（18k / 1k），按实际板卡修改
+#define VBUS_ADC_GAIN (3.3f / 4096.0f * VBUS_DIVIDER)
+/* 1：ADC2 实测母线电压参与 PWM 计算和欠压/过压判断；
+ * 0：使用固定的 powerVol。分压比和 ADC2 规则序列位置（vbus_rank）尚未在板上核实，
+ * 核实后再打开 */
+#ifndef VBUS_SENSE
+#define VBUS_SENSE 0
+#endif
+/* 1：上电后辨识电机参数（电机会被拖动旋转），结果见 foc->param */
+#ifndef MOTOR_IDENTIFY
+#define MOTOR_IDENTIFY 0
+#endif
 
 /* USER CODE END PD */
 
@@ -59,7 +76,11 @@
 /* USER CODE BEGIN PV */
 VOFA_Instance *vofa;
 float vofa_sendfloat[8] = {0};
+#if PROFILE_ENABLE
+float profile_sendfloat[PROFILE_STAGE_MAX * 3] = {0};
+#endif
 FOC_Instance *foc;
+Cascade_Instance *cascade;
 
 AS5047P_Instance *as5047p;
 float as5047p_angle;
@@ -69,12 +90,8 @@ float ele_angle_act = 0.0f;
 float mec_angle_target = 0.0f;
 float ele_angle_target = 0.0f;
 
-uint32_t count1_start = 0;
-uint32_t count2_nums = 0;
-
-float bias = 0.0f;
-float bias_sum = 0.0f;
-float bias_avg = 0.0f;
+float id_target = 0.0f;
+float iq_target = 0.3f;
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 /* USER CODE BEGIN PFP */
@@ -83,12 +100,14 @@ void SystemClock_Config(void);
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
-void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim) {
-  if (htim->Instance == TIM6) {
-    as5047p_angle = AS5047P_ReadAngle(as5047p); 
+void HAL_ADCEx_InjectedConvCpltCallback(ADC_HandleTypeDef *hadc) {
+  if (hadc->Instance == ADC1) {
+    PROFILE_BEGIN(as5047p_read);
+    as5047p_angle = AS5047P_ReadAngle(as5047p);
+    PROFILE_END(as5047p_read);
 
     mec_angle_act = 2 * PI - as5047p_angle;
-    ele_angle_act = 14 * mec_angle_act + 42.0913811f;
+    ele_angle_act = FOC_ElectricalAngle(foc, mec_angle_act);
     // if(ele_angle_act >= 28 * PI) {
     //   ele_angle_act -= 28 * PI;
     // }
@@ -100,24 +119,15 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim) {
     // ele_angle_target = 14 * mec_angle_target;
 
     // FOC_OpenLoop(foc, 1.2f, 0.0f, ele_angle_target);
-    FOC_OpenLoop(foc, 0.0f, 1.5f, ele_angle_act);
-
-    // if(count1_start != 50000 ) {
-    //   count1_start ++;
-    // }
-    // else {
-    //   if(count2_nums < 50000) {
-    //     bias = ele_angle_target - ele_angle_act;
-    //     if(bias < 50.0f && bias > 40.0f) {
-    //       bias_sum += bias;
-    //       count2_nums ++;
-    //     }
-    //   }
-    //   else if(count2_nums == 50000) {
-    //     bias_avg = bias_sum / count2_nums;
-    //     count2_nums ++;
-    //   }
-    // }
+    // FOC_OpenLoop(foc, 0.0f, 1.5f, ele_angle_act);
+    // FOC_CurrentLoop(foc, id_target, iq_target, ele_angle_act);
+    /* 参数辨识、零偏校准期间不运行串级控制 */
+    if (FOC_Identify(foc, mec_angle_act))
+      return;
+    if (FOC_CalibrateOffset(foc, mec_angle_act))
+      return;
+    Cascade_SetCurrent(cascade, id_target, iq_target);
+    Cascade_Update(cascade, mec_angle_act, ele_angle_act);
 
     // FOC_EncoderOpenLoop(foc, 0.0f, 1.2f, -as5047p_angle);
   }
@@ -164,7 +174,6 @@ int main(void)
   MX_USART3_UART_Init();
   MX_USB_Device_Init();
   MX_ADC2_Init();
-  MX_TIM6_Init();
   /* USER CODE BEGIN 2 */
   vofa = VOFA_Register(&huart1);
   if (vofa == NULL)
@@ -175,27 +184,143 @@ int main(void)
     .powerVol = 8.0f,
     .tim = &htim1,
     .pole_pairs = 14,
+    .adc = &hadc1,
+    .current_gain = CURRENT_ADC_GAIN,
+    .current_kp = 2.0f,
+    .current_ki = 400.0f,
+    .limit_priority = FOC_VLIMIT_D_PRIORITY, // 电压饱和时优先保证 Ud，弱磁时 Id 可控
+    .vbus_adc = VBUS_SENSE ? &hadc2 : NULL,
+    .vbus_rank = 0,
+    .vbus_gain = VBUS_ADC_GAIN,
+    .vbus_alpha = 0.05f,
+    .vbus_uv = 6.0f,
+    .vbus_ov = 28.0f,
+    .dt_ton = 0.0f,  // 按实际 MOSFET 参数修改
+    .dt_toff = 0.0f,
+    .dt_band = 0.1f,
+    .current_max = 2.0f,
+    .fw_ki = 50.0f,
+    .fw_mi_ref = 0.95f,
+    .fw_id_max = 1.0f,
+    .Ld = 1e-4f, // 按实际电机参数修改，启用参数辨识时被辨识结果覆盖
+    .Lq = 2e-4f,
+    .flux = 0.0f,
   };
   foc = FOC_Register(&init);
   if (foc == NULL)
     while (1)
       ;
 
+  /* 无传感器观测器与编码器并行运行，FOC_SetAngleSource 切换角度来源 */
+  SMO_Init_Config_s smo_config = {
+    .Rs = 0.5f,   // 按实际电机参数修改
+    .Ls = 2e-4f,
+    .Ts = foc->pwm.Ts,
+    .k_slide = 10.0f,
+    .boundary = 2.5f,
+    .lpf_cutoff = 2000.0f,
+    .pll_bandwidth = 300.0f,
+    .speed_min = 200.0f,
+  };
+  FOC_SetObserver(foc, SMO_Register(&smo_config));
+
+  /* 零速、低速由高频注入给出角度，高于 speed_high 交接给观测器 */
+  HFI_Init_Config_s hfi_config = {
+    .Ts = foc->pwm.Ts,
+    .Ld = 1e-4f, // 按实际电机参数修改
+    .Lq = 2e-4f,
+    .voltage = 1.0f,
+    .pll_bandwidth = 200.0f,
+    .speed_low = 300.0f,
+    .speed_high = 600.0f,
+    .polarity_current = 1.0f,
+    .converge_cycles = 2000,
+    .polarity_cycles = 400,
+    .demod_delay = 1, // CH4 在计数峰值附近触发采样，新 CCR 在随后的下溢处生效
+  };
+  FOC_SetHFI(foc, HFI_Register(&hfi_config));
+
+  /* 电流环 20 kHz；速度环 2 kHz，位置环 1 kHz，二者相位错开 */
+  Cascade_Init_Config_s cascade_config = {
+    .foc = foc,
+    .speed_div = 10,
+    .speed_phase = 0,
+    .pos_div = 20,
+    .pos_phase = 5,
+    .speed_kp = 0.02f,
+    .speed_ki = 0.2f,
+    .iq_max = 1.0f,
+    .speed_alpha = 0.2f,
+    .speed_range = 200.0f, // FMAC 已由 Vbus 滤波占用时自动使用 CPU 滤波
+    .pos_kp = 20.0f,
+    .speed_max = 50.0f,
+    .acc_gain = 0.0f, // 转动惯量 / 转矩常数，按实际电机参数修改
+  };
+  cascade = Cascade_Register(&cascade_config);
+  if (cascade == NULL)
+    while (1)
+      ;
+
+  /* 齿槽转矩补偿：表初始为 0，速度模式低速匀速运行时调用 Cogging_StartLearn 学习，
+   * 学习转速下的齿槽频率须低于速度环带宽 */
+  Cogging_Init_Config_s cogging_config = {
+    .iq_max = 0.5f,
+    .gain = 0.05f,
+    .mean_alpha = 0.001f,
+  };
+  Cascade_SetCogging(cascade, Cogging_Register(&cogging_config));
+
+  /* 位置模式下 Cascade_SetPosition 的目标经 S 形轨迹规划，每个位置环周期推进一步 */
+  Traj_Init_Config_s traj_config = {
+    .profile = TRAJ_SCURVE,
+    .Ts = foc->pwm.Ts * cascade_config.pos_div,
+    .vel_max = 30.0f,
+    .acc_max = 300.0f,
+    .jerk_max = 10000.0f,
+  };
+  Cascade_SetTrajectory(cascade, Traj_Register(&traj_config));
+
   as5047p = AS5047P_Register(&hspi1, GPIOA, GPIO_PIN_15, 0.15f);
+  /* 编码器每个 PWM 周期读取一次，用锁相环跟踪器代替一阶低通 */
+  AS5047P_SetTracker(as5047p, 1000.0f, foc->pwm.Ts);
   
-  HAL_Delay(500);
-  HAL_TIM_Base_Start_IT(&htim6);
-  FOC_Init(foc, -2.807407843);
+#if PROFILE_ENABLE
+  Profile_Init();
+#endif
+  /* 反电动势与交叉耦合前馈，PI 只需处理剩余误差 */
+  FOC_SetDecoupling(foc, 1);
+#if MOTOR_IDENTIFY
+  FOC_IdentTypedef ident_config = {
+    .current = 1.5f,
+    .voltage = 2.0f,
+    .speed = 300.0f,
+    .accel = 600.0f,
+  };
+  FOC_StartIdentify(foc, &ident_config);
+#endif
+  /* 电角度零偏和编码器方向由校准得到，在参数辨识之后执行 */
+  FOC_StartCalibrate(foc, 1.2f);
+
+  /* 以上配置须在 FOC_Init 之前完成：FOC_Init 启动 ADC 注入中断后，
+   * 电流环立即在中断中运行并读取这些配置 */
+  FOC_SetMode(foc, FOC_CurrentLoopMode);
+  FOC_Init(foc, 0.0f);
   /* USER CODE END 2 */
 
   /* Infinite loop */
   /* USER CODE BEGIN WHILE */
   while (1) {
+#if PROFILE_ENABLE
+    /* 各阶段耗时表，每个阶段依次为 mean、min、max（CPU 周期） */
+    VOFA_Send(vofa, profile_sendfloat,
+              Profile_Export(profile_sendfloat, PROFILE_STAGE_MAX * 3));
+#else
     vofa_sendfloat[0] = mec_angle_act;
     vofa_sendfloat[1] = ele_angle_act;
     vofa_sendfloat[2] = mec_angle_target; 
     vofa_sendfloat[3] = ele_angle_target;
     VOFA_Send(vofa, vofa_sendfloat, 4);
+#endif
     HAL_Delay(5);
     /* USER CODE END WHILE */
 
@@ -5,6 +5,11 @@
 #include "stm32g4xx_hal.h"
 #include <stdint.h>
 
+/* 可注册的 AS5047P 实例个数（静态对象池容量） */
+#ifndef AS5047P_INSTANCE_MAX
+#define AS5047P_INSTANCE_MAX 1
+#endif
+
 /* AS5047 寄存器地址 */
 #define NOP 0x0000      // 无操作
 #define ERRFL 0x0001    // 错误寄存器
@@ -23,12 +28,56 @@ typedef struct {
   float measure;
 } AS5047P_Lowpass;
 
+/* 角度滤波方式 */
+typedef enum {
+  AS5047P_FILTER_LOWPASS, // 一阶低通（默认）
+  AS5047P_FILTER_TRACKER, // 二型锁相环跟踪器
+} AS5047P_Filter;
+
+/* 二型锁相环跟踪器，匀速时角度无静差 */
+typedef struct {
+  float Ts;    // 采样周期（s）
+  float kp;    // 比例增益，2 * bandwidth
+  float ki;    // 积分增益，bandwidth^2
+  float speed; // 角速度估计（单位/s）
+  float accel; // 角加速度估计（单位/s^2）
+  uint8_t valid;
+} AS5047P_Tracker;
+
+/* 非线性补偿表：匀速旋转时以时间为参考学习角度误差，按测量角度查表补偿 */
+#define AS5047P_LUT_SIZE 128 // 每圈的分段数
+
+typedef enum {
+  AS5047P_LUT_IDLE,   // 未学习，按已有表补偿
+  AS5047P_LUT_SYNC,   // 等待第一次过零
+  AS5047P_LUT_PERIOD, // 测量第一圈的周期
+  AS5047P_LUT_LEARN,  // 以上一圈周期为参考累计误差
+  AS5047P_LUT_DONE,   // 学习完成，补偿表已更新
+  AS5047P_LUT_ERROR,  // 转速不稳、反向或分段未覆盖，补偿表不变
+} AS5047P_LutState;
+
+typedef struct {
+  AS5047P_LutState state;
+  uint16_t revolutions; // 学习圈数
+  uint16_t rev;         // 已学习圈数
+  int8_t dir;           // 旋转方向
+  float last;           // 上次的测量值（未补偿）
+  float since;          // 距上次过零的采样数（含小数）
+  float period;         // 上一圈的采样数（含小数）
+  float table[AS5047P_LUT_SIZE];    // 补偿量，第 i 项对应分段 i 的中点
+  float sum[AS5047P_LUT_SIZE];      // 学习时各分段的误差累加
+  uint16_t count[AS5047P_LUT_SIZE]; // 学习时各分段的采样数
+} AS5047P_Lut;
+
 typedef struct {
   SPI_HandleTypeDef *spi;
   GPIO_TypeDef *cs_port;
   uint16_t cs_pin;
 
+  AS5047P_Filter filter;
   AS5047P_Lowpass lowpass;
+  AS5047P_Tracker tracker;
+  AS5047P_Lut *lut; // 非线性补偿表，为 NULL 时不补偿
   float angle;
 } AS5047P_Instance;
 
@@ -36,4 +85,8 @@ AS5047P_Instance *AS5047P_Register(SPI_HandleTypeDef *spi, GPIO_TypeDef *cs_port
                                   uint16_t cs_pin, float lowpass_alpha);
 uint16_t AS5047P_Read(AS5047P_Instance *instance, uint16_t addr);
 float AS5047P_ReadAngle(AS5047P_Instance *instance);
+void AS5047P_SetTracker(AS5047P_Instance *instance, float bandwidth, float Ts);
+float AS5047P_GetSpeed(AS5047P_Instance *instance);
+float AS5047P_GetAccel(AS5047P_Instance *instance);
+void AS5047P_StartLinearize(AS5047P_Instance *instance, uint16_t revolutions);
 #endif
@@ -5,6 +5,11 @@ extern "C" {
 #endif
 #include "bsp_uart.h"
 
+/* 可注册的 VOFA 实例个数（静态对象池容量） */
+#ifndef VOFA_INSTANCE_MAX
+#define VOFA_INSTANCE_MAX 1
+#endif
+
 #define VOFA_RX_HEAD 0x0A
 #define VOFA_RX_TAIL 0x0B
 #define VOFA_RX_NUM 8
@@ -1,16 +1,24 @@
 #include "as5047.h"
+#include "bsp_pool.h"
 #include "arm_math.h"
 #include "stdint.h"
 // #include "stm32g431xx.h"
 #include "stm32g4xx_hal_def.h"
 #include "stm32g4xx_hal_gpio.h"
 #include "stm32g4xx_hal_spi.h"
-#include "stdlib.h"
 #include "string.h"
 
+POOL_DEFINE(as5047p_pool, AS5047P_Instance, AS5047P_INSTANCE_MAX);
+POOL_DEFINE(as5047p_lut_pool, AS5047P_Lut, AS5047P_INSTANCE_MAX);
+
 #define AS5047P_OUTPUT_FORMAT 0 // 0：输出弧度值；1：输出角度值
 
 #if AS5047P_OUTPUT_FORMAT
+#define AS5047P_RAW_TO_UNIT AS5047P_RAW_TO_DEG
+#define AS5047P_FULL 360.0f
+#define AngleErr_Limit DegErr_Limit
+#define Angle_Limit Deg_Limit
+
 /**
  * @brief 将角度差限制在 [-180, 180] 内
  */
@@ -30,9 +38,17 @@ static float Deg_Limit(float angle) {
     angle -= 360.0f;
   if (angle < 0.0f)
     angle += 360.0f;
+  /* 绝对值极小的负数加 360 后舍入为 360 本身 */
+  if (angle >= 360.0f)
+    angle = 0.0f;
   return angle;
 }
 #else
+#define AS5047P_RAW_TO_UNIT AS5047P_RAW_TO_RAD
+#define AS5047P_FULL (2 * PI)
+#define AngleErr_Limit RadErr_Limit
+#define Angle_Limit Rad_Limit
+
 /**
  * @brief 将弧度差限制在 [-PI, PI) 内
  */
@@ -52,6 +68,9 @@ static float Rad_Limit(float angle) {
     angle -= 2 * PI;
   if (angle < 0.0f)
     angle += 2 * PI;
+  /* 绝对值极小的负数加 2PI 后舍入为 2PI 本身 */
+  if (angle >= 2 * PI)
+    angle = 0.0f;
   return angle;
 }
 #endif
@@ -86,6 +105,119 @@ static uint16_t AS5047P_ReadWriteByte(SPI_HandleTypeDef *spi,
   return rxdata;                                    // 返回接收到的数据
 }
 
+/**
+ * @brief 二型锁相环跟踪：误差经 PI 得到速度，速度积分得到角度
+ *        闭环极点为二重 -bandwidth，匀速时角度无静差；匀加速 a 时预测误差为 a / ki，
+ *        修正后的角度滞后为 (1 - kp * Ts) * a / ki
+ * @param measure 本次测量的角度
+ */
+static void Tracker_Update(AS5047P_Instance *instance, float measure) {
+  AS5047P_Tracker *tracker = &instance->tracker;
+  if (!tracker->valid) {
+    instance->angle = measure;
+    tracker->speed = 0.0f;
+    tracker->accel = 0.0f;
+    tracker->valid = 1;
+    return;
+  }
+
+  // 先按上次的速度预测本次角度，再用测量误差修正
+  float angle = instance->angle + tracker->speed * tracker->Ts;
+  float err = AngleErr_Limit(measure - angle);
+  tracker->accel = tracker->ki * err;
+  tracker->speed += tracker->accel * tracker->Ts;
+  instance->angle = Angle_Limit(angle + tracker->kp * tracker->Ts * err);
+}
+
+/**
+ * @brief 查补偿表，分段中点之间线性插值
+ * @param measure 测量角度（未补偿）
+ */
+static float Lut_Lookup(AS5047P_Lut *lut, float measure) {
+  float x = measure * (AS5047P_LUT_SIZE / AS5047P_FULL) - 0.5f;
+  if (x < 0.0f)
+    x += AS5047P_LUT_SIZE;
+  uint32_t i = (uint32_t)x;
+  float frac = x - (float)i;
+  i %= AS5047P_LUT_SIZE;
+  float a = lut->table[i];
+  float b = lut->table[(i + 1) % AS5047P_LUT_SIZE];
+  return a + frac * (b - a);
+}
+
+/**
+ * @brief 补偿表学习：以过零点为界，按上一圈的周期线性推算本圈的参考角度，
+ *        补偿后的残差按测量角度分段累计，结束时叠加到补偿表并去除均值
+ * @param measure 测量角度（未补偿）
+ * @param corrected 补偿后的角度
+ */
+static void Lut_Learn(AS5047P_Lut *lut, float measure, float corrected) {
+  float delta = AngleErr_Limit(measure - lut->last);
+  float last = lut->last;
+  lut->last = measure;
+  if (lut->state == AS5047P_LUT_SYNC && lut->since == 0.0f) {
+    lut->since = 1.0f; // 第一个采样只记录
+    return;
+  }
+
+  /* 过零：测量值跳变超过半圈，按线性插值求小数时刻 */
+  uint8_t cross = (measure - last > 0.5f * AS5047P_FULL) ||
+                  (last - measure > 0.5f * AS5047P_FULL);
+  if (cross) {
+    int8_t dir = (delta > 0.0f) ? 1 : -1;
+    float frac = (dir > 0) ? (AS5047P_FULL - last) / delta : last / -delta;
+    float period = lut->since + frac;
+    lut->since = 1.0f - frac;
+
+    if (lut->state == AS5047P_LUT_SYNC) {
+      lut->dir = dir;
+      lut->state = AS5047P_LUT_PERIOD;
+      return;
+    }
+    if (dir != lut->dir || (lut->state == AS5047P_LUT_LEARN &&
+                            (period > 1.1f * lut->period ||
+                             period < 0.9f * lut->period))) {
+      lut->state = AS5047P_LUT_ERROR;
+      return;
+    }
+    lut->period = period;
+    if (lut->state == AS5047P_LUT_PERIOD) {
+      lut->state = AS5047P_LUT_LEARN;
+    } else if (++lut->rev >= lut->revolutions) {
+      float mean = 0.0f;
+      for (uint16_t i = 0; i < AS5047P_LUT_SIZE; i++) {
+        if (lut->count[i] == 0) {
+          lut->state = AS5047P_LUT_ERROR;
+          return;
+        }
+        lut->sum[i] /= lut->count[i];
+        mean += lut->sum[i];
+      }
+      mean /= AS5047P_LUT_SIZE;
+      for (uint16_t i = 0; i < AS5047P_LUT_SIZE; i++)
+        lut->table[i] += lut->sum[i] - mean;
+      lut->state = AS5047P_LUT_DONE;
+      return;
+    }
+  } else {
+    lut->since += 1.0f;
+  }
+
+  if (lut->state != AS5047P_LUT_LEARN)
+    return;
+  if (lut->since > 1.5f * lut->period) {
+    lut->state = AS5047P_LUT_ERROR;
+    return;
+  }
+  float ref = lut->since / lut->period * AS5047P_FULL;
+  if (lut->dir < 0)
+    ref = AS5047P_FULL - ref;
+  uint32_t i = (uint32_t)(measure * (AS5047P_LUT_SIZE / AS5047P_FULL)) %
+               AS5047P_LUT_SIZE;
+  lut->sum[i] += AngleErr_Limit(corrected - ref);
+  lut->count[i]++;
+}
+
 /**
  * @brief 注册 AS5047
  * @param spi SPI 句柄
@@ -98,15 +230,15 @@ AS5047P_Instance *AS5047P_Register(SPI_HandleTypeDef *spi, GPIO_TypeDef *cs_port
   if (spi == NULL || cs_port == NULL || cs_pin == 0)
     return NULL;
 
-  AS5047P_Instance *instance = (AS5047P_Instance *)malloc(sizeof(AS5047P_Instance));
+  AS5047P_Instance *instance = (AS5047P_Instance *)Pool_Alloc(&as5047p_pool);
   if (instance == NULL) 
     return NULL;
-  memset(instance, 0, sizeof(AS5047P_Instance));
 
   instance->spi = spi;
   instance->cs_port = cs_port;
   instance->cs_pin = cs_pin;
   instance->angle = 0.0f;
+  instance->filter = AS5047P_FILTER_LOWPASS;
   instance->lowpass.alpha = lowpass_alpha;
 
   return instance;
@@ -138,14 +270,78 @@ uint16_t AS5047P_Read(AS5047P_Instance *instance, uint16_t addr) {
  */
 float AS5047P_ReadAngle(AS5047P_Instance *instance) {
   uint16_t data = AS5047P_Read(instance, ANGLECOM);
-#if AS5047P_OUTPUT_FORMAT
-  instance->lowpass.measure = data * AS5047P_RAW_TO_DEG;  // 记录这次的测量值
-  instance->angle = instance->angle + DegErr_Limit(instance->lowpass.measure - instance->angle) * instance->lowpass.alpha;
-  instance->angle = Deg_Limit(instance->angle);
-#else
-  instance->lowpass.measure = data * AS5047P_RAW_TO_RAD;  // 记录这次的测量值
-  instance->angle = instance->angle + RadErr_Limit(instance->lowpass.measure - instance->angle) * instance->lowpass.alpha;
-  instance->angle = Rad_Limit(instance->angle);
-#endif
+  float measure = data * AS5047P_RAW_TO_UNIT;
+  if (instance->lut != NULL) {
+    float corrected = Angle_Limit(measure - Lut_Lookup(instance->lut, measure));
+    if (instance->lut->state >= AS5047P_LUT_SYNC &&
+        instance->lut->state <= AS5047P_LUT_LEARN)
+      Lut_Learn(instance->lut, measure, corrected);
+    measure = corrected;
+  }
+  instance->lowpass.measure = measure;  // 记录这次的测量值
+  if (instance->filter == AS5047P_FILTER_TRACKER) {
+    Tracker_Update(instance, instance->lowpass.measure);
+    return instance->angle;
+  }
+  instance->angle = instance->angle + AngleErr_Limit(instance->lowpass.measure - instance->angle) * instance->lowpass.alpha;
+  instance->angle = Angle_Limit(instance->angle);
   return instance->angle;
 }
+
+/**
+ * @brief 启用锁相环跟踪器代替一阶低通，须按固定周期调用 AS5047P_ReadAngle
+ * @param instance AS5047 实例指针
+ * @param bandwidth 跟踪带宽（rad/s），≤ 0 时恢复一阶低通
+ * @param Ts 读取周期（s）
+ */
+void AS5047P_SetTracker(AS5047P_Instance *instance, float bandwidth, float Ts) {
+  if (bandwidth <= 0.0f || Ts <= 0.0f) {
+    instance->filter = AS5047P_FILTER_LOWPASS;
+    return;
+  }
+  instance->tracker.Ts = Ts;
+  instance->tracker.kp = 2.0f * bandwidth;
+  instance->tracker.ki = bandwidth * bandwidth;
+  instance->tracker.valid = 0;
+  instance->filter = AS5047P_FILTER_TRACKER;
+}
+
+/**
+ * @brief 获取跟踪器的角速度估计，一阶低通方式下返回 0
+ */
+float AS5047P_GetSpeed(AS5047P_Instance *instance) {
+  if (instance->filter != AS5047P_FILTER_TRACKER)
+    return 0.0f;
+  return instance->tracker.speed;
+}
+
+/**
+ * @brief 获取跟踪器的角加速度估计，一阶低通方式下返回 0
+ */
+float AS5047P_GetAccel(AS5047P_Instance *instance) {
+  if (instance->filter != AS5047P_FILTER_TRACKER)
+    return 0.0f;
+  return instance->tracker.accel;
+}
+
+/**
+ * @brief 开始学习非线性补偿表，须在电机匀速旋转时按固定周期调用 AS5047P_ReadAngle，
+ *        已有补偿表时在其基础上继续修正，结果见 instance->lut->state
+ * @note 以时间为参考，与位置相关的转速波动会被当作编码器误差，转速越高、惯量越大越准确
+ * @param instance AS5047 实例指针
+ * @param revolutions 学习圈数，不含同步和测周期的两圈
+ */
+void AS5047P_StartLinearize(AS5047P_Instance *instance, uint16_t revolutions) {
+  if (instance->lut == NULL) {
+    instance->lut = (AS5047P_Lut *)Pool_Alloc(&as5047p_lut_pool);
+    if (instance->lut == NULL)
+      return;
+  }
+  AS5047P_Lut *lut = instance->lut;
+  memset(lut->sum, 0, sizeof(lut->sum));
+  memset(lut->count, 0, sizeof(lut->count));
+  lut->revolutions = (revolutions > 0) ? revolutions : 1;
+  lut->rev = 0;
+  lut->since = 0.0f;
+  lut->state = AS5047P_LUT_SYNC;
+}
@@ -1,8 +1,10 @@
 #include "vofa.h"
+#include "bsp_pool.h"
 #include "bsp_uart.h"
-#include "stdlib.h"
 #include "string.h"
 
+POOL_DEFINE(vofa_pool, VOFA_Instance, VOFA_INSTANCE_MAX);
+
 uint8_t vofa_tx_head[4] = {0x00, 0x00, 0x80, 0x7F}; // VOFA 发送数据帧头
 
 /* 数据包格式为 | 0x0A | 序号（1字节） | 数据（4字节） | 0x0B | */
@@ -47,8 +49,8 @@ VOFA_Instance *VOFA_Register(UART_HandleTypeDef *huart) {
   if (huart == NULL)
     return NULL;
 
-  /* 分配内存 */
-  VOFA_Instance *instance = (VOFA_Instance *)malloc(sizeof(VOFA_Instance));
+  /* 从对象池分配 */
+  VOFA_Instance *instance = (VOFA_Instance *)Pool_Alloc(&vofa_pool);
   if (instance == NULL)
     return NULL;
 
@@ -60,7 +62,7 @@ VOFA_Instance *VOFA_Register(UART_HandleTypeDef *huart) {
 
   instance->uart = UART_Register((void *)instance, &uart_config);
   if (instance->uart == NULL) {
-    free(instance);
+    Pool_Free(&vofa_pool, instance);
     return NULL;
   }
 
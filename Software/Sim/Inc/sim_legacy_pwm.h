@@ -0,0 +1,163 @@
+#ifndef SIM_LEGACY_PWM_H
+#define SIM_LEGACY_PWM_H
+/* 零序注入调制之前 foc.c 中的 FOC_SetSPWM 与扇区法 SetSVPWM，照原样保留，
+ * 供 Sim/Test/test_modulation.c 对比 CCR、Bench/Src/bench_foc.c 对比耗时。
+ * 须在 #include "foc.c" 之后包含（使用 FOC_Instance 和 SQRT3 等宏）。
+ *
+ * 原 SetSVPWM 的比较值为低电平时间的一半：CCR = (period - 高电平时间) / 2，
+ * 与 FOC_SetSPWM 及现在的 SetPWM（CCR = 高电平时间）不同，
+ * 对比时按 period - 2 * CCR 换算为高电平时间。 */
+
+static inline void Legacy_SetSPWM(FOC_Instance *instance) {
+  /* 计算 CCR */
+  uint32_t aCCR =
+      (uint32_t)((instance->param.Uabc.a + instance->param.powerVol_half) /
+                 instance->param.powerVol * instance->pwm.period);
+  uint32_t bCCR =
+      (uint32_t)((instance->param.Uabc.b + instance->param.powerVol_half) /
+                 instance->param.powerVol * instance->pwm.period);
+  uint32_t cCCR =
+      (uint32_t)((instance->param.Uabc.c + instance->param.powerVol_half) /
+                 instance->param.powerVol * instance->pwm.period);
+
+  /* 设置 CCR */
+  instance->pwm.tim->Instance->CCR1 = aCCR;
+  instance->pwm.tim->Instance->CCR2 = bCCR;
+  instance->pwm.tim->Instance->CCR3 = cCCR;
+}
+
+/**
+ * @brief 扇区判断
+ * @param AlphaBeta AlphaBeta轴上的电压
+ * @return 所在的扇区（1 ~ 6）
+ */
+static inline uint8_t Legacy_SecJud(AlphaBeta_Typedef AlphaBeta) {
+  float A = AlphaBeta.Beta;
+  float B = SQRT3 * AlphaBeta.Alpha - AlphaBeta.Beta;
+  float C = -SQRT3 * AlphaBeta.Alpha - AlphaBeta.Beta;
+
+  uint8_t sum = 0;
+  uint8_t sector = 0;
+
+  if (A > 0)
+    sum += 1;
+  if (B > 0)
+    sum += 2;
+  if (C > 0)
+    sum += 4;
+
+  switch (sum) {
+  case 3:
+    sector = 1;
+    break;
+  case 1:
+    sector = 2;
+    break;
+  case 5:
+    sector = 3;
+    break;
+  case 4:
+    sector = 4;
+    break;
+  case 6:
+    sector = 5;
+    break;
+  case 2:
+    sector = 6;
+    break;
+  }
+
+  return sector;
+}
+
+static inline void Legacy_SetSVPWM(FOC_Instance *instance) {
+  uint8_t sector = Legacy_SecJud(instance->param.UAlphaBeta);
+
+  float tmp = (float)instance->pwm.period * SQRT3 / instance->param.powerVol;
+  float X = tmp * (instance->param.UAlphaBeta.Beta);
+  float Y = tmp * (instance->param.UAlphaBeta.Alpha * SQRT3_DIV2 +
+                   instance->param.UAlphaBeta.Beta * 0.5f);
+  float Z = tmp * (-instance->param.UAlphaBeta.Alpha * SQRT3_DIV2 +
+                   instance->param.UAlphaBeta.Beta * 0.5f);
+
+  /* 原代码在扇区 0（零电压矢量）时 T1、T2 和 CCR 均未赋值，此处补上初值以免
+   * 未初始化告警，零矢量时的输出仍与正确结果不同 */
+  float T1 = 0.0f, T2 = 0.0f, T0;
+  switch (sector) {
+  case 1:
+    T1 = -Z;
+    T2 = X;
+    break;
+  case 2:
+    T1 = Z;
+    T2 = Y;
+    break;
+  case 3:
+    T1 = X;
+    T2 = -Y;
+    break;
+  case 4:
+    T1 = -X;
+    T2 = Z;
+    break;
+  case 5:
+    T1 = -Y;
+    T2 = -Z;
+    break;
+  case 6:
+    T1 = Y;
+    T2 = -X;
+    break;
+  }
+  if (T1 + T2 > instance->pwm.period) { // 防止 T1，T2 超过周期
+    T1 = instance->pwm.period * T1 / (T1 + T2);
+    T2 = instance->pwm.period * T2 / (T1 + T2);
+  }
+  T0 = (float)instance->pwm.period - T1 - T2;
+
+  abc_Typedef Tabc;
+  Tabc.a = T0 / 4.0f;
+  Tabc.b = Tabc.a + T1 / 2.0f;
+  Tabc.c = Tabc.b + T2 / 2.0f;
+
+  uint32_t aCCR = 0, bCCR = 0, cCCR = 0;
+  switch (sector) {
+  case 1:
+    aCCR = (uint32_t)Tabc.a;
+    bCCR = (uint32_t)Tabc.b;
+    cCCR = (uint32_t)Tabc.c;
+    break;
+  case 2:
+    aCCR = (uint32_t)Tabc.b;
+    bCCR = (uint32_t)Tabc.a;
+    cCCR = (uint32_t)Tabc.c;
+    break;
+  case 3:
+    aCCR = (uint32_t)Tabc.c;
+    bCCR = (uint32_t)Tabc.a;
+    cCCR = (uint32_t)Tabc.b;
+    break;
+  case 4:
+    aCCR = (uint32_t)Tabc.c;
+    bCCR = (uint32_t)Tabc.b;
+    cCCR = (uint32_t)Tabc.a;
+    break;
+  case 5:
+    aCCR = (uint32_t)Tabc.b;
+    bCCR = (uint32_t)Tabc.c;
+    cCCR = (uint32_t)Tabc.a;
+
+    break;
+  case 6:
+    aCCR = (uint32_t)Tabc.a;
+    bCCR = (uint32_t)Tabc.c;
+    cCCR = (uint32_t)Tabc.b;
+    break;
+  }
+
+  instance->pwm.tim->Instance->CCR1 = aCCR;
+  instance->pwm.tim->Instance->CCR2 = bCCR;
+  instance->pwm.tim->Instance->CCR3 = cCCR;
+}
+
+#endif
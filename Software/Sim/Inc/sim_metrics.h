@@ -0,0 +1,70 @@
+#ifndef SIM_METRICS_H
+#define SIM_METRICS_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* ------------------------------------------------- include
+ * ------------------------------------------------- */
+#include "stdint.h"
+
+/* ------------------------------------------------- typedef
+ * ------------------------------------------------- */
+/* 相电流谐波累加量：以转子真实电角度最小二乘拟合 i ≈ a·cosθe + b·sinθe + c，
+ * 残差即谐波和噪声，窗口不必是整数个电周期 */
+typedef struct {
+  uint32_t n;
+  double m[3][3]; // Σ x·xᵀ，x = [cosθe, sinθe, 1]
+  double r[3];    // Σ i·x
+  double sq_sum;  // Σ i^2
+} Sim_Harmonic;
+
+/* 指标累加器 */
+typedef struct {
+  double theta_start; // 开始统计时的电角度（rad）
+  double theta_last;  // 最近一次采样的电角度（rad）
+  Sim_Harmonic harmonic;
+
+  uint32_t n;
+  double torque_sum, torque_sq_sum;
+  double torque_min, torque_max;
+  double error_sq_sum, error_max;
+} Sim_Metrics;
+
+/* 指标 */
+typedef struct {
+  double current_thd;       // 相电流总谐波畸变率，不足一个电周期时为 -1
+  double current_fund;      // 相电流基波幅值（A）
+  double torque_mean;       // 平均电磁转矩（N·m）
+  double torque_ripple_pp;  // 转矩峰峰值（N·m）
+  double torque_ripple_rms; // 转矩交流分量均方根（N·m）
+  double tracking_rms;      // 跟踪误差均方根
+  double tracking_max;      // 跟踪误差最大绝对值
+} Sim_Report;
+
+/* ------------------------------------------------- functions
+ * ------------------------------------------------- */
+/**
+ * @brief 清零，从电角度 theta_e 开始统计
+ */
+void Sim_MetricsReset(Sim_Metrics *metrics, double theta_e);
+
+/**
+ * @brief 记录一个采样
+ * @param metrics 指标累加器
+ * @param current A 相电流（A）
+ * @param theta_e 转子真实电角度（rad，多圈连续）
+ * @param torque 电磁转矩（N·m）
+ * @param error 跟踪误差（目标 - 实际，单位由场景决定）
+ */
+void Sim_MetricsSample(Sim_Metrics *metrics, double current, double theta_e,
+                       double torque, double error);
+
+/**
+ * @brief 计算指标
+ */
+void Sim_MetricsReport(Sim_Metrics *metrics, Sim_Report *report);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,65 @@
+#ifndef SIM_PERIPH_H
+#define SIM_PERIPH_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* ------------------------------------------------- include
+ * ------------------------------------------------- */
+#include "stdint.h"
+#include "stm32g4xx_hal.h"
+
+/* ------------------------------------------------- define
+ * ------------------------------------------------- */
+#define SIM_PCLK2_FREQ 170000000U // 与板上 APB2 时钟一致
+#define SIM_ADC_DMA_MAX 2         // 可启动 DMA 的 ADC 个数
+
+/* ------------------------------------------------- typedef
+ * ------------------------------------------------- */
+/**
+ * @brief SPI 从设备：片选有效时每传输一个字调用一次
+ * @param device 从设备
+ * @param mosi 主机发出的字
+ * @retval 从设备同时移出的字
+ */
+typedef uint16_t (*Sim_SPI_Transfer)(void *device, uint16_t mosi);
+
+/* ------------------------------------------------- functions
+ * ------------------------------------------------- */
+/**
+ * @brief 复位所有寄存器替身
+ */
+void Sim_PeriphReset(void);
+
+/**
+ * @brief 在 SPI 总线上挂接从设备，片选为 cs_port 的 cs_pin（低有效）
+ */
+void Sim_SPI_Attach(SPI_TypeDef *spi, GPIO_TypeDef *cs_port, uint16_t cs_pin,
+                    Sim_SPI_Transfer transfer, void *device);
+
+/**
+ * @brief 注入转换完成：写入 JDR1 ~ JDRn，并置位 JEOS
+ * @param adc ADC 寄存器
+ * @param codes 各注入通道的转换结果
+ * @param n 通道数，≤ 4
+ */
+void Sim_ADC_Injected(ADC_TypeDef *adc, const uint16_t *codes, uint8_t n);
+
+/**
+ * @brief 规则序列转换完成：写入 DR，并按 HAL_ADC_Start_DMA 登记的缓冲区完成一次循环 DMA
+ * @param adc ADC 寄存器
+ * @param codes 规则序列各次转换结果
+ * @param n 转换数
+ */
+void Sim_ADC_Regular(ADC_TypeDef *adc, const uint16_t *codes, uint8_t n);
+
+/**
+ * @brief 定时器比较寄存器换算的三相占空比（中心对齐 PWM 模式 1，CCR / (ARR + 1)）
+ * @param tim 定时器寄存器
+ * @param duty 三相占空比（输出），未使能的通道为 0
+ */
+void Sim_TIM_Duty(TIM_TypeDef *tim, float duty[3]);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
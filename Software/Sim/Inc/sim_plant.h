@@ -0,0 +1,100 @@
+#ifndef SIM_PLANT_H
+#define SIM_PLANT_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* ------------------------------------------------- include
+ * ------------------------------------------------- */
+#include "stdint.h"
+
+/* ------------------------------------------------- define
+ * ------------------------------------------------- */
+#define SIM_ADC_FULL 4095 // 12 位 ADC 满量程
+#define SIM_ADC_MID 2048  // INA240 零电流输出（VCC / 2）对应的码值
+
+/* ------------------------------------------------- typedef
+ * ------------------------------------------------- */
+typedef struct {
+  /* 电机 */
+  double R;           // 相电阻（Ω）
+  double Ld;          // d 轴电感（H）
+  double Lq;          // q 轴电感（H）
+  double flux;        // 永磁磁链（Wb）
+  uint8_t pole_pairs; // 极对数
+  double J;           // 转动惯量（kg·m^2）
+  double B;           // 粘滞摩擦系数（N·m·s/rad）
+  double cogging;     // 齿槽转矩幅值（N·m）
+  uint16_t slots;     // 齿槽转矩每机械圈的周期数
+
+  /* 逆变器 */
+  double vbus;             // 母线电压标称值（V）
+  double vbus_res;         // 母线等效内阻（Ω），母线电流 Σ duty·i 造成电压跌落
+  double vbus_ripple;      // 母线电压正弦纹波幅值（V）
+  double vbus_ripple_freq; // 纹波频率（Hz）
+  double vbus_sag;         // 母线电压跌落深度（V），跌落期间从标称值中减去
+  double vbus_sag_start;   // 跌落开始时刻（s），自 Sim_PlantInit 起计时
+  double vbus_sag_time;    // 跌落持续时间（s），为 0 时不跌落
+  double dead_time;        // 死区时间（s），按相电流方向产生平均电压误差
+  double Ts;               // PWM 周期（s）
+
+  /* 传感器 */
+  double current_gain;  // 电流采样增益（A / LSB）
+  double current_noise; // 电流采样噪声（A，均方根）
+  double vbus_gain;     // 母线电压采样增益（V / LSB）
+  double encoder_zero;  // 编码器零点（rad），读数 = encoder_zero - 机械角度
+} Sim_Plant_Init_Config_s;
+
+/* PMSM + 逆变器 + 传感器模型，状态量用 double 积分 */
+typedef struct {
+  Sim_Plant_Init_Config_s config;
+
+  double id, iq;    // dq 轴电流（A），以转子 d 轴定向
+  double theta;     // 机械角度（rad，多圈）
+  double omega;     // 机械角速度（rad/s）
+  double torque;    // 电磁转矩（N·m），含齿槽转矩
+  double load;      // 负载转矩（N·m）
+  uint8_t locked;   // 1：测功机拖动，转速固定为 omega
+  double iabc[3];   // 相电流（A）
+  double vbus;      // 母线电压瞬时值（V）
+  double time;      // 自 Sim_PlantInit 起的时间（s）
+  float duty[3];    // 当前生效的三相占空比
+  uint32_t noise;   // 噪声发生器状态
+
+  uint16_t spi_addr; // AS5047P 上一帧命令的寄存器地址，本帧返回其内容
+} Sim_Plant;
+
+/* ------------------------------------------------- functions
+ * ------------------------------------------------- */
+/**
+ * @brief 初始化模型，转子静止于机械角度 0
+ */
+void Sim_PlantInit(Sim_Plant *plant, Sim_Plant_Init_Config_s *config);
+
+/**
+ * @brief 推进一段时间，占空比在此期间保持不变
+ * @param plant 模型
+ * @param t 时长（s）
+ * @param substeps 积分步数
+ */
+void Sim_PlantStep(Sim_Plant *plant, double t, uint16_t substeps);
+
+/**
+ * @brief 电流采样的 ADC 码值（A、C 相，含噪声和 12 位量化）
+ */
+void Sim_PlantCurrentCodes(Sim_Plant *plant, uint16_t codes[2]);
+
+/**
+ * @brief 母线电压采样的 ADC 码值
+ */
+uint16_t Sim_PlantVBusCode(Sim_Plant *plant);
+
+/**
+ * @brief AS5047P SPI 从设备，按 Sim_SPI_Transfer 接口挂接
+ * @note 返回上一帧命令所读寄存器的内容，角度为 14 位量化值，带偶校验位
+ */
+uint16_t Sim_PlantEncoderTransfer(void *plant, uint16_t mosi);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,125 @@
+#ifndef SIM_RIG_H
+#define SIM_RIG_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* ------------------------------------------------- include
+ * ------------------------------------------------- */
+#include "as5047.h"
+#include "cascade.h"
+#include "foc.h"
+#include "sim_plant.h"
+#include "stdint.h"
+
+/* ------------------------------------------------- define
+ * ------------------------------------------------- */
+/* 与 Core/Src/main.c 相同的板级参数 */
+#define SIM_CURRENT_AMP_GAIN 50.0f  // INA240A2 放大倍数
+#define SIM_CURRENT_SHUNT_RES 0.01f // 采样电阻（Ω）
+#define SIM_CURRENT_ADC_GAIN                                                   \
+  (3.3f / 4096.0f / SIM_CURRENT_AMP_GAIN / SIM_CURRENT_SHUNT_RES)
+#define SIM_VBUS_DIVIDER 19.0f // 母线电压分压比
+#define SIM_VBUS_ADC_GAIN (3.3f / 4096.0f * SIM_VBUS_DIVIDER)
+#define SIM_PWM_PERIOD 4249    // TIM1 ARR，中心对齐 20 kHz
+
+/* 每个 PWM 周期的默认积分步数。模型按前向欧拉积分，步长 Ts / 4 = 12.5 us 远小于
+ * 电气时间常数；与 10 步相比各项指标的差别在第三位有效数字以内 */
+#define SIM_SUBSTEPS 4
+
+/* ------------------------------------------------- typedef
+ * ------------------------------------------------- */
+typedef struct Sim_Rig Sim_Rig;
+
+/**
+ * @brief 控制中断，为 NULL 时按 main.c 的流程执行
+ */
+typedef void (*Sim_RigIsr)(Sim_Rig *rig);
+
+/* 试验台配置，Sim_RigDefaults 给出与 foc_sim 相同的默认值 */
+typedef struct {
+  Sim_Plant_Init_Config_s motor;
+  FOC_InitTypedef foc;           // tim、adc、vbus_adc 由 Sim_RigInit 填入
+  Cascade_Init_Config_s cascade; // foc 由 Sim_RigInit 填入
+  uint8_t vbus_sense;            // 1：启用 ADC2 母线电压采样；0：使用固定的 powerVol
+  uint8_t decouple;              // dq 轴解耦前馈
+  double dead_time;              // TIM1 死区时间（s），同时写入模型
+  double delay;                  // CCR 预装载生效时刻（PWM 周期的比例）
+  uint16_t substeps;             // 每个 PWM 周期的积分步数，delay 按 1 / substeps 取整
+} Sim_Rig_Init_Config_s;
+
+/* 试验台：模型 + 寄存器替身上的外设句柄 + 按 main.c 方式注册的固件实例 */
+struct Sim_Rig {
+  Sim_Plant plant;
+
+  TIM_HandleTypeDef htim1;
+  ADC_HandleTypeDef hadc1;
+  ADC_HandleTypeDef hadc2;
+  DMA_HandleTypeDef hdma_adc2;
+  SPI_HandleTypeDef hspi1;
+
+  FOC_Instance *foc;
+  Cascade_Instance *cascade;
+  AS5047P_Instance *as5047p;
+
+  Sim_RigIsr isr;
+  double delay;
+  uint16_t substeps;
+  float id_ref;    // 电流模式的 d 轴电流目标（A）
+  float iq_ref;    // 电流模式的 q 轴电流目标（A）
+  float mec_angle; // 本周期的机械角度（rad），与 main.c 相同取 2PI - 编码器读数
+  float ele_angle; // 本周期的电角度（rad）
+  uint32_t periods;
+};
+
+/* ------------------------------------------------- functions
+ * ------------------------------------------------- */
+/**
+ * @brief 默认配置：14 极对云台电机（12 槽 28 极），12 V 母线，电流环带宽约 800 Hz
+ */
+void Sim_RigDefaults(Sim_Rig_Init_Config_s *config);
+
+/**
+ * @brief 复位寄存器替身，初始化模型，注册 FOC、串级控制、AS5047P 和轨迹规划
+ * @note 各实例来自固件的静态对象池，主机构建中对象池容量见 Sim/CMakeLists.txt
+ * @retval 1：成功；0：注册失败
+ */
+uint8_t Sim_RigInit(Sim_Rig *rig, Sim_Rig_Init_Config_s *config);
+
+/**
+ * @brief 启动电流环：先完成所有配置，再由 FOC_Init 使能注入转换中断（与 main.c 相同的顺序），
+ *        然后运行到电流零偏和电角度零偏校准结束
+ * @param calib_voltage 零偏校准的锁定电压（V）
+ * @retval 1：校准完成；0：校准失败
+ */
+uint8_t Sim_RigStart(Sim_Rig *rig, float calib_voltage);
+
+/**
+ * @brief 推进一个 PWM 周期：采样 → 控制中断 → 模型积分，新的 CCR 在 delay 处生效
+ */
+void Sim_RigPeriod(Sim_Rig *rig);
+
+/**
+ * @brief 连续推进若干 PWM 周期
+ */
+void Sim_RigRun(Sim_Rig *rig, uint32_t periods);
+
+/**
+ * @brief 与 main.c 中 HAL_ADCEx_InjectedConvCpltCallback 相同的控制流程，
+ *        可在自定义中断中调用
+ */
+void Sim_RigControl(Sim_Rig *rig);
+
+/**
+ * @brief 模型的真实电角度 p·θ（rad，多圈连续），A 相轴线为 0
+ */
+double Sim_RigElectricalAngle(Sim_Rig *rig);
+
+/**
+ * @brief 电角度估计值与模型真实电角度之差（rad），回绕到 [-PI, PI)
+ */
+double Sim_RigAngleError(Sim_Rig *rig, double angle);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
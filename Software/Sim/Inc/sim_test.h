@@ -0,0 +1,33 @@
+#ifndef SIM_TEST_H
+#define SIM_TEST_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* ------------------------------------------------- include
+ * ------------------------------------------------- */
+#include "stdint.h"
+
+/* ------------------------------------------------- functions
+ * ------------------------------------------------- */
+/**
+ * @brief 检查一个判据，打印一行 "ok" 或 "FAIL" 及测量值，失败时计数
+ * @param pass 判据是否成立
+ * @param fmt 说明和测量值，printf 格式
+ */
+void Sim_Check(uint8_t pass, const char *fmt, ...)
+    __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief 打印一行测量值，不参与判定
+ */
+void Sim_Note(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief 测试结果，作为 main 的返回值：0 全部通过，1 有失败
+ */
+int Sim_TestResult(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,54 @@
+#ifndef SIM_STM32G4XX_H
+#define SIM_STM32G4XX_H
+/* ------------------------------------------------- include
+ * ------------------------------------------------- */
+/* 主机仿真：本目录排在 CMSIS 设备头文件目录之前，先包含原设备头文件，
+ * 再把仿真用到的外设从固定地址重定向到主机内存中的寄存器替身 */
+#include_next "stm32g4xx.h"
+
+/* ------------------------------------------------- variable
+ * ------------------------------------------------- */
+extern TIM_TypeDef sim_tim1;
+extern ADC_TypeDef sim_adc1;
+extern ADC_TypeDef sim_adc2;
+extern SPI_TypeDef sim_spi1;
+extern GPIO_TypeDef sim_gpioa;
+extern DMA_TypeDef sim_dma1;
+extern DMA_TypeDef sim_dma2;
+extern DMA_Channel_TypeDef sim_dma1_ch1;
+extern DMA_Channel_TypeDef sim_dma1_ch2;
+extern CORDIC_TypeDef sim_cordic;
+extern FMAC_TypeDef sim_fmac;
+extern DWT_Type sim_dwt;
+extern CoreDebug_Type sim_coredebug;
+
+/* ------------------------------------------------- define
+ * ------------------------------------------------- */
+#undef TIM1
+#define TIM1 (&sim_tim1)
+#undef ADC1
+#define ADC1 (&sim_adc1)
+#undef ADC2
+#define ADC2 (&sim_adc2)
+#undef SPI1
+#define SPI1 (&sim_spi1)
+#undef GPIOA
+#define GPIOA (&sim_gpioa)
+#undef DMA1
+#define DMA1 (&sim_dma1)
+#undef DMA2
+#define DMA2 (&sim_dma2)
+#undef DMA1_Channel1
+#define DMA1_Channel1 (&sim_dma1_ch1)
+#undef DMA1_Channel2
+#define DMA1_Channel2 (&sim_dma1_ch2)
+#undef CORDIC
+#define CORDIC (&sim_cordic)
+#undef FMAC
+#define FMAC (&sim_fmac)
+#undef DWT
+#define DWT (&sim_dwt)
+#undef CoreDebug
+#define CoreDebug (&sim_coredebug)
+
+#endif
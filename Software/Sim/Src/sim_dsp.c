@@ -0,0 +1,150 @@
+#include "arm_math.h"
+#include <math.h>
+
+/* 主机上没有 CMSIS-DSP 的 Cortex-M4 库，按其接口实现用到的函数。
+ * q15 正弦/余弦移植 CMSIS-DSP（arm_sin_q15.c、arm_cos_q15.c）的查表线性插值，
+ * 与目标板逐位一致，定点电压合成的 CCR 在主机上可与黄金向量直接比较 */
+
+float32_t arm_sin_f32(float32_t x) { return sinf(x); }
+
+float32_t arm_cos_f32(float32_t x) { return cosf(x); }
+
+/* sin(2PI * n / 512)，n = 0..512，四舍五入到 Q15，+1.0 饱和为 0x7FFF
+ * （与 CMSIS-DSP arm_common_tables.c 的 sinTable_q15 生成规则相同） */
+static const q15_t sinTable_q15[FAST_MATH_TABLE_SIZE + 1] = {
+    (q15_t)0x0000, (q15_t)0x0192, (q15_t)0x0324, (q15_t)0x04B6, (q15_t)0x0648,
+    (q15_t)0x07D9, (q15_t)0x096B, (q15_t)0x0AFB, (q15_t)0x0C8C, (q15_t)0x0E1C,
+    (q15_t)0x0FAB, (q15_t)0x113A, (q15_t)0x12C8, (q15_t)0x1455, (q15_t)0x15E2,
+    (q15_t)0x176E, (q15_t)0x18F9, (q15_t)0x1A83, (q15_t)0x1C0C, (q15_t)0x1D93,
+    (q15_t)0x1F1A, (q15_t)0x209F, (q15_t)0x2224, (q15_t)0x23A7, (q15_t)0x2528,
+    (q15_t)0x26A8, (q15_t)0x2827, (q15_t)0x29A4, (q15_t)0x2B1F, (q15_t)0x2C99,
+    (q15_t)0x2E11, (q15_t)0x2F87, (q15_t)0x30FC, (q15_t)0x326E, (q15_t)0x33DF,
+    (q15_t)0x354E, (q15_t)0x36BA, (q15_t)0x3825, (q15_t)0x398D, (q15_t)0x3AF3,
+    (q15_t)0x3C57, (q15_t)0x3DB8, (q15_t)0x3F17, (q15_t)0x4074, (q15_t)0x41CE,
+    (q15_t)0x4326, (q15_t)0x447B, (q15_t)0x45CD, (q15_t)0x471D, (q15_t)0x486A,
+    (q15_t)0x49B4, (q15_t)0x4AFB, (q15_t)0x4C40, (q15_t)0x4D81, (q15_t)0x4EC0,
+    (q15_t)0x4FFB, (q15_t)0x5134, (q15_t)0x5269, (q15_t)0x539B, (q15_t)0x54CA,
+    (q15_t)0x55F6, (q15_t)0x571E, (q15_t)0x5843, (q15_t)0x5964, (q15_t)0x5A82,
+    (q15_t)0x5B9D, (q15_t)0x5CB4, (q15_t)0x5DC8, (q15_t)0x5ED7, (q15_t)0x5FE4,
+    (q15_t)0x60EC, (q15_t)0x61F1, (q15_t)0x62F2, (q15_t)0x63EF, (q15_t)0x64E9,
+    (q15_t)0x65DE, (q15_t)0x66D0, (q15_t)0x67BD, (q15_t)0x68A7, (q15_t)0x698C,
+    (q15_t)0x6A6E, (q15_t)0x6B4B, (q15_t)0x6C24, (q15_t)0x6CF9, (q15_t)0x6DCA,
+    (q15_t)0x6E97, (q15_t)0x6F5F, (q15_t)0x7023, (q15_t)0x70E3, (q15_t)0x719E,
+    (q15_t)0x7255, (q15_t)0x7308, (q15_t)0x73B6, (q15_t)0x7460, (q15_t)0x7505,
+    (q15_t)0x75A6, (q15_t)0x7642, (q15_t)0x76D9, (q15_t)0x776C, (q15_t)0x77FB,
+    (q15_t)0x7885, (q15_t)0x790A, (q15_t)0x798A, (q15_t)0x7A06, (q15_t)0x7A7D,
+    (q15_t)0x7AEF, (q15_t)0x7B5D, (q15_t)0x7BC6, (q15_t)0x7C2A, (q15_t)0x7C89,
+    (q15_t)0x7CE4, (q15_t)0x7D3A, (q15_t)0x7D8A, (q15_t)0x7DD6, (q15_t)0x7E1E,
+    (q15_t)0x7E60, (q15_t)0x7E9D, (q15_t)0x7ED6, (q15_t)0x7F0A, (q15_t)0x7F38,
+    (q15_t)0x7F62, (q15_t)0x7F87, (q15_t)0x7FA7, (q15_t)0x7FC2, (q15_t)0x7FD9,
+    (q15_t)0x7FEA, (q15_t)0x7FF6, (q15_t)0x7FFE, (q15_t)0x7FFF, (q15_t)0x7FFE,
+    (q15_t)0x7FF6, (q15_t)0x7FEA, (q15_t)0x7FD9, (q15_t)0x7FC2, (q15_t)0x7FA7,
+    (q15_t)0x7F87, (q15_t)0x7F62, (q15_t)0x7F38, (q15_t)0x7F0A, (q15_t)0x7ED6,
+    (q15_t)0x7E9D, (q15_t)0x7E60, (q15_t)0x7E1E, (q15_t)0x7DD6, (q15_t)0x7D8A,
+    (q15_t)0x7D3A, (q15_t)0x7CE4, (q15_t)0x7C89, (q15_t)0x7C2A, (q15_t)0x7BC6,
+    (q15_t)0x7B5D, (q15_t)0x7AEF, (q15_t)0x7A7D, (q15_t)0x7A06, (q15_t)0x798A,
+    (q15_t)0x790A, (q15_t)0x7885, (q15_t)0x77FB, (q15_t)0x776C, (q15_t)0x76D9,
+    (q15_t)0x7642, (q15_t)0x75A6, (q15_t)0x7505, (q15_t)0x7460, (q15_t)0x73B6,
+    (q15_t)0x7308, (q15_t)0x7255, (q15_t)0x719E, (q15_t)0x70E3, (q15_t)0x7023,
+    (q15_t)0x6F5F, (q15_t)0x6E97, (q15_t)0x6DCA, (q15_t)0x6CF9, (q15_t)0x6C24,
+    (q15_t)0x6B4B, (q15_t)0x6A6E, (q15_t)0x698C, (q15_t)0x68A7, (q15_t)0x67BD,
+    (q15_t)0x66D0, (q15_t)0x65DE, (q15_t)0x64E9, (q15_t)0x63EF, (q15_t)0x62F2,
+    (q15_t)0x61F1, (q15_t)0x60EC, (q15_t)0x5FE4, (q15_t)0x5ED7, (q15_t)0x5DC8,
+    (q15_t)0x5CB4, (q15_t)0x5B9D, (q15_t)0x5A82, (q15_t)0x5964, (q15_t)0x5843,
+    (q15_t)0x571E, (q15_t)0x55F6, (q15_t)0x54CA, (q15_t)0x539B, (q15_t)0x5269,
+    (q15_t)0x5134, (q15_t)0x4FFB, (q15_t)0x4EC0, (q15_t)0x4D81, (q15_t)0x4C40,
+    (q15_t)0x4AFB, (q15_t)0x49B4, (q15_t)0x486A, (q15_t)0x471D, (q15_t)0x45CD,
+    (q15_t)0x447B, (q15_t)0x4326, (q15_t)0x41CE, (q15_t)0x4074, (q15_t)0x3F17,
+    (q15_t)0x3DB8, (q15_t)0x3C57, (q15_t)0x3AF3, (q15_t)0x398D, (q15_t)0x3825,
+    (q15_t)0x36BA, (q15_t)0x354E, (q15_t)0x33DF, (q15_t)0x326E, (q15_t)0x30FC,
+    (q15_t)0x2F87, (q15_t)0x2E11, (q15_t)0x2C99, (q15_t)0x2B1F, (q15_t)0x29A4,
+    (q15_t)0x2827, (q15_t)0x26A8, (q15_t)0x2528, (q15_t)0x23A7, (q15_t)0x2224,
+    (q15_t)0x209F, (q15_t)0x1F1A, (q15_t)0x1D93, (q15_t)0x1C0C, (q15_t)0x1A83,
+    (q15_t)0x18F9, (q15_t)0x176E, (q15_t)0x15E2, (q15_t)0x1455, (q15_t)0x12C8,
+    (q15_t)0x113A, (q15_t)0x0FAB, (q15_t)0x0E1C, (q15_t)0x0C8C, (q15_t)0x0AFB,
+    (q15_t)0x096B, (q15_t)0x07D9, (q15_t)0x0648, (q15_t)0x04B6, (q15_t)0x0324,
+    (q15_t)0x0192, (q15_t)0x0000, (q15_t)0xFE6E, (q15_t)0xFCDC, (q15_t)0xFB4A,
+    (q15_t)0xF9B8, (q15_t)0xF827, (q15_t)0xF695, (q15_t)0xF505, (q15_t)0xF374,
+    (q15_t)0xF1E4, (q15_t)0xF055, (q15_t)0xEEC6, (q15_t)0xED38, (q15_t)0xEBAB,
+    (q15_t)0xEA1E, (q15_t)0xE892, (q15_t)0xE707, (q15_t)0xE57D, (q15_t)0xE3F4,
+    (q15_t)0xE26D, (q15_t)0xE0E6, (q15_t)0xDF61, (q15_t)0xDDDC, (q15_t)0xDC59,
+    (q15_t)0xDAD8, (q15_t)0xD958, (q15_t)0xD7D9, (q15_t)0xD65C, (q15_t)0xD4E1,
+    (q15_t)0xD367, (q15_t)0xD1EF, (q15_t)0xD079, (q15_t)0xCF04, (q15_t)0xCD92,
+    (q15_t)0xCC21, (q15_t)0xCAB2, (q15_t)0xC946, (q15_t)0xC7DB, (q15_t)0xC673,
+    (q15_t)0xC50D, (q15_t)0xC3A9, (q15_t)0xC248, (q15_t)0xC0E9, (q15_t)0xBF8C,
+    (q15_t)0xBE32, (q15_t)0xBCDA, (q15_t)0xBB85, (q15_t)0xBA33, (q15_t)0xB8E3,
+    (q15_t)0xB796, (q15_t)0xB64C, (q15_t)0xB505, (q15_t)0xB3C0, (q15_t)0xB27F,
+    (q15_t)0xB140, (q15_t)0xB005, (q15_t)0xAECC, (q15_t)0xAD97, (q15_t)0xAC65,
+    (q15_t)0xAB36, (q15_t)0xAA0A, (q15_t)0xA8E2, (q15_t)0xA7BD, (q15_t)0xA69C,
+    (q15_t)0xA57E, (q15_t)0xA463, (q15_t)0xA34C, (q15_t)0xA238, (q15_t)0xA129,
+    (q15_t)0xA01C, (q15_t)0x9F14, (q15_t)0x9E0F, (q15_t)0x9D0E, (q15_t)0x9C11,
+    (q15_t)0x9B17, (q15_t)0x9A22, (q15_t)0x9930, (q15_t)0x9843, (q15_t)0x9759,
+    (q15_t)0x9674, (q15_t)0x9592, (q15_t)0x94B5, (q15_t)0x93DC, (q15_t)0x9307,
+    (q15_t)0x9236, (q15_t)0x9169, (q15_t)0x90A1, (q15_t)0x8FDD, (q15_t)0x8F1D,
+    (q15_t)0x8E62, (q15_t)0x8DAB, (q15_t)0x8CF8, (q15_t)0x8C4A, (q15_t)0x8BA0,
+    (q15_t)0x8AFB, (q15_t)0x8A5A, (q15_t)0x89BE, (q15_t)0x8927, (q15_t)0x8894,
+    (q15_t)0x8805, (q15_t)0x877B, (q15_t)0x86F6, (q15_t)0x8676, (q15_t)0x85FA,
+    (q15_t)0x8583, (q15_t)0x8511, (q15_t)0x84A3, (q15_t)0x843A, (q15_t)0x83D6,
+    (q15_t)0x8377, (q15_t)0x831C, (q15_t)0x82C6, (q15_t)0x8276, (q15_t)0x822A,
+    (q15_t)0x81E2, (q15_t)0x81A0, (q15_t)0x8163, (q15_t)0x812A, (q15_t)0x80F6,
+    (q15_t)0x80C8, (q15_t)0x809E, (q15_t)0x8079, (q15_t)0x8059, (q15_t)0x803E,
+    (q15_t)0x8027, (q15_t)0x8016, (q15_t)0x800A, (q15_t)0x8002, (q15_t)0x8000,
+    (q15_t)0x8002, (q15_t)0x800A, (q15_t)0x8016, (q15_t)0x8027, (q15_t)0x803E,
+    (q15_t)0x8059, (q15_t)0x8079, (q15_t)0x809E, (q15_t)0x80C8, (q15_t)0x80F6,
+    (q15_t)0x812A, (q15_t)0x8163, (q15_t)0x81A0, (q15_t)0x81E2, (q15_t)0x822A,
+    (q15_t)0x8276, (q15_t)0x82C6, (q15_t)0x831C, (q15_t)0x8377, (q15_t)0x83D6,
+    (q15_t)0x843A, (q15_t)0x84A3, (q15_t)0x8511, (q15_t)0x8583, (q15_t)0x85FA,
+    (q15_t)0x8676, (q15_t)0x86F6, (q15_t)0x877B, (q15_t)0x8805, (q15_t)0x8894,
+    (q15_t)0x8927, (q15_t)0x89BE, (q15_t)0x8A5A, (q15_t)0x8AFB, (q15_t)0x8BA0,
+    (q15_t)0x8C4A, (q15_t)0x8CF8, (q15_t)0x8DAB, (q15_t)0x8E62, (q15_t)0x8F1D,
+    (q15_t)0x8FDD, (q15_t)0x90A1, (q15_t)0x9169, (q15_t)0x9236, (q15_t)0x9307,
+    (q15_t)0x93DC, (q15_t)0x94B5, (q15_t)0x9592, (q15_t)0x9674, (q15_t)0x9759,
+    (q15_t)0x9843, (q15_t)0x9930, (q15_t)0x9A22, (q15_t)0x9B17, (q15_t)0x9C11,
+    (q15_t)0x9D0E, (q15_t)0x9E0F, (q15_t)0x9F14, (q15_t)0xA01C, (q15_t)0xA129,
+    (q15_t)0xA238, (q15_t)0xA34C, (q15_t)0xA463, (q15_t)0xA57E, (q15_t)0xA69C,
+    (q15_t)0xA7BD, (q15_t)0xA8E2, (q15_t)0xAA0A, (q15_t)0xAB36, (q15_t)0xAC65,
+    (q15_t)0xAD97, (q15_t)0xAECC, (q15_t)0xB005, (q15_t)0xB140, (q15_t)0xB27F,
+    (q15_t)0xB3C0, (q15_t)0xB505, (q15_t)0xB64C, (q15_t)0xB796, (q15_t)0xB8E3,
+    (q15_t)0xBA33, (q15_t)0xBB85, (q15_t)0xBCDA, (q15_t)0xBE32, (q15_t)0xBF8C,
+    (q15_t)0xC0E9, (q15_t)0xC248, (q15_t)0xC3A9, (q15_t)0xC50D, (q15_t)0xC673,
+    (q15_t)0xC7DB, (q15_t)0xC946, (q15_t)0xCAB2, (q15_t)0xCC21, (q15_t)0xCD92,
+    (q15_t)0xCF04, (q15_t)0xD079, (q15_t)0xD1EF, (q15_t)0xD367, (q15_t)0xD4E1,
+    (q15_t)0xD65C, (q15_t)0xD7D9, (q15_t)0xD958, (q15_t)0xDAD8, (q15_t)0xDC59,
+    (q15_t)0xDDDC, (q15_t)0xDF61, (q15_t)0xE0E6, (q15_t)0xE26D, (q15_t)0xE3F4,
+    (q15_t)0xE57D, (q15_t)0xE707, (q15_t)0xE892, (q15_t)0xEA1E, (q15_t)0xEBAB,
+    (q15_t)0xED38, (q15_t)0xEEC6, (q15_t)0xF055, (q15_t)0xF1E4, (q15_t)0xF374,
+    (q15_t)0xF505, (q15_t)0xF695, (q15_t)0xF827, (q15_t)0xF9B8, (q15_t)0xFB4A,
+    (q15_t)0xFCDC, (q15_t)0xFE6E, (q15_t)0x0000
+};
+
+/**
+ * @brief 在 sinTable_q15 上线性插值，x 为 [0, 32768) 的表内位置
+ */
+static q15_t SinTableInterp(q15_t x) {
+  /* 高 9 位为表索引，低 6 位左移 9 位作为 Q15 小数部分 */
+  int32_t index = (uint32_t)x >> FAST_MATH_Q15_SHIFT;
+  q15_t fract = (q15_t)((x - (index << FAST_MATH_Q15_SHIFT)) << 9);
+
+  q15_t a = sinTable_q15[index];
+  q15_t b = sinTable_q15[index + 1];
+
+  q15_t sinVal = (q15_t)(((q31_t)(0x8000 - fract) * a) >> 16);
+  sinVal = (q15_t)((((q31_t)sinVal << 16) + ((q31_t)fract * b)) >> 16);
+  return (q15_t)(sinVal << 1);
+}
+
+/**
+ * @brief q15 正弦，输入 [0, 32768) 对应 [0, 2PI)
+ */
+q15_t arm_sin_q15(q15_t x) { return SinTableInterp(x); }
+
+/**
+ * @brief q15 余弦，输入 [0, 32768) 对应 [0, 2PI)
+ */
+q15_t arm_cos_q15(q15_t x) {
+  /* cos(x) = sin(x + PI/2)，超出 [0, 32768) 时回绕 */
+  int32_t in = (uint16_t)x + 0x2000;
+  if (in > 0x7FFF)
+    in -= 0x8000;
+  return SinTableInterp((q15_t)in);
+}
@@ -0,0 +1,249 @@
+#include "arm_math.h"
+#include "sim_metrics.h"
+#include "sim_rig.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+#include <math.h>
+
+/* 仿真场景 */
+typedef enum {
+  SIM_CURRENT,  // 测功机拖动在固定转速，电流模式给定 Iq
+  SIM_SPEED,    // 转子自由，速度模式，带负载
+  SIM_POSITION, // 转子自由，位置模式，经 S 形轨迹规划
+} Sim_Scenario;
+
+/* 命令行参数 */
+typedef struct {
+  Sim_Scenario scenario;
+  FOC_Modulation modulation;
+  double time;      // 场景时长（s），不含校准
+  double settle;    // 开始统计前的稳定时间（s）
+  double speed;     // 转速（rad/s，机械角速度）
+  double iq;        // Iq 目标（A）
+  double position;  // 位置目标增量（rad）
+  double load;      // 负载转矩（N·m）
+  double dead_time; // 死区时间（s）
+  double delay;     // CCR 预装载生效时刻（PWM 周期的比例）
+  double noise;     // 电流采样噪声（A）
+  uint16_t substeps; // 每个 PWM 周期的积分步数，delay 按 1 / substeps 取整
+  double vbus_res;    // 母线等效内阻（Ω）
+  double ripple;      // 母线电压纹波幅值（V）
+  double ripple_freq; // 纹波频率（Hz）
+  double sag;         // 母线电压跌落深度（V）
+  double sag_start;   // 跌落开始时刻（s），自校准结束起计时
+  double sag_time;    // 跌落持续时间（s）
+  uint8_t decouple; // dq 轴解耦前馈
+  uint8_t dtc;      // 死区补偿
+  const char *trace;
+} Sim_Options;
+
+static Sim_Rig rig;
+
+/* ---------------- 驱动函数 Begin ---------------- */
+static double WallMs(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e3 + ts.tv_nsec * 1e-6;
+}
+
+static void Usage(void) {
+  fprintf(stderr,
+          "usage: foc_sim [current|speed|position] [--time s] [--settle s]\n"
+          "               [--speed rad/s] [--iq A] [--pos rad] [--load Nm]\n"
+          "               [--modulation spwm|svpwm|thipwm|dpwm1]\n"
+          "               [--dead-time ns] [--delay 0..1] [--noise A]\n"
+          "               [--substeps n] [--vbus-res ohm] [--ripple V]\n"
+          "               [--ripple-freq Hz] [--sag V] [--sag-start s]\n"
+          "               [--sag-time s]\n"
+          "               [--decouple 0|1] [--dtc 0|1] [--trace file.csv]\n");
+  exit(2);
+}
+
+static void ParseOptions(Sim_Options *opt, int argc, char **argv) {
+  for (int i = 1; i < argc; i++) {
+    const char *a = argv[i];
+    if (strcmp(a, "current") == 0)
+      opt->scenario = SIM_CURRENT;
+    else if (strcmp(a, "speed") == 0)
+      opt->scenario = SIM_SPEED;
+    else if (strcmp(a, "position") == 0)
+      opt->scenario = SIM_POSITION;
+    else if (i + 1 >= argc)
+      Usage();
+    else if (strcmp(a, "--time") == 0)
+      opt->time = atof(argv[++i]);
+    else if (strcmp(a, "--settle") == 0)
+      opt->settle = atof(argv[++i]);
+    else if (strcmp(a, "--speed") == 0)
+      opt->speed = atof(argv[++i]);
+    else if (strcmp(a, "--iq") == 0)
+      opt->iq = atof(argv[++i]);
+    else if (strcmp(a, "--pos") == 0)
+      opt->position = atof(argv[++i]);
+    else if (strcmp(a, "--load") == 0)
+      opt->load = atof(argv[++i]);
+    else if (strcmp(a, "--dead-time") == 0)
+      opt->dead_time = atof(argv[++i]) * 1e-9;
+    else if (strcmp(a, "--delay") == 0)
+      opt->delay = atof(argv[++i]);
+    else if (strcmp(a, "--noise") == 0)
+      opt->noise = atof(argv[++i]);
+    else if (strcmp(a, "--substeps") == 0)
+      opt->substeps = (uint16_t)atoi(argv[++i]);
+    else if (strcmp(a, "--vbus-res") == 0)
+      opt->vbus_res = atof(argv[++i]);
+    else if (strcmp(a, "--ripple") == 0)
+      opt->ripple = atof(argv[++i]);
+    else if (strcmp(a, "--ripple-freq") == 0)
+      opt->ripple_freq = atof(argv[++i]);
+    else if (strcmp(a, "--sag") == 0)
+      opt->sag = atof(argv[++i]);
+    else if (strcmp(a, "--sag-start") == 0)
+      opt->sag_start = atof(argv[++i]);
+    else if (strcmp(a, "--sag-time") == 0)
+      opt->sag_time = atof(argv[++i]);
+    else if (strcmp(a, "--decouple") == 0)
+      opt->decouple = (uint8_t)atoi(argv[++i]);
+    else if (strcmp(a, "--dtc") == 0)
+      opt->dtc = (uint8_t)atoi(argv[++i]);
+    else if (strcmp(a, "--trace") == 0)
+      opt->trace = argv[++i];
+    else if (strcmp(a, "--modulation") == 0) {
+      const char *m = argv[++i];
+      opt->modulation = (strcmp(m, "spwm") == 0)     ? FOC_SPWM
+                        : (strcmp(m, "thipwm") == 0) ? FOC_THIPWM
+                        : (strcmp(m, "dpwm1") == 0)  ? FOC_DPWM1
+                                                     : FOC_SVPWM;
+    } else
+      Usage();
+  }
+  if (opt->delay < 0.0 || opt->delay > 1.0 || opt->time <= opt->settle ||
+      opt->substeps == 0)
+    Usage();
+}
+/* ---------------- 驱动函数  End  ---------------- */
+
+int main(int argc, char **argv) {
+  Sim_Options opt = {
+    .scenario = SIM_SPEED,
+    .modulation = FOC_SVPWM,
+    .time = 0.6,
+    .settle = 0.3,
+    .speed = 20.0,
+    .iq = 0.5,
+    .position = 2.0 * PI,
+    .load = 0.02,
+    .dead_time = 200e-9,
+    .delay = 0.5,
+    .noise = 0.005,
+    .substeps = SIM_SUBSTEPS,
+    .ripple_freq = 300.0,
+    .decouple = 1,
+    .dtc = 1,
+  };
+  ParseOptions(&opt, argc, argv);
+
+  Sim_Rig_Init_Config_s config;
+  Sim_RigDefaults(&config);
+  config.foc.modulation = opt.modulation;
+  config.foc.dt_band = opt.dtc ? 0.1f : 0.0f;
+  config.decouple = opt.decouple;
+  config.dead_time = opt.dead_time;
+  config.delay = opt.delay;
+  config.substeps = opt.substeps;
+  Sim_Plant_Init_Config_s *motor = &config.motor;
+  motor->current_noise = opt.noise;
+  motor->vbus_res = opt.vbus_res;
+  motor->vbus_ripple = opt.ripple;
+  motor->vbus_ripple_freq = opt.ripple_freq;
+  motor->vbus_sag = opt.sag;
+  motor->vbus_sag_time = opt.sag_time;
+  if (!Sim_RigInit(&rig, &config)) {
+    fprintf(stderr, "firmware init failed\n");
+    return 1;
+  }
+  FOC_Instance *foc = rig.foc;
+  Cascade_Instance *cascade = rig.cascade;
+  Sim_Plant *plant = &rig.plant;
+
+  FILE *trace = NULL;
+  if (opt.trace != NULL && (trace = fopen(opt.trace, "w")) != NULL)
+    fprintf(trace, "t,ref,id,iq,omega,theta,torque,duty_a,duty_b,duty_c\n");
+
+  double wall_start = WallMs();
+  if (!Sim_RigStart(&rig, 1.2f)) {
+    fprintf(stderr, "calibration failed\n");
+    return 1;
+  }
+
+  /* 场景，母线电压跌落自此计时 */
+  plant->config.vbus_sag_start = plant->time + opt.sag_start;
+  plant->load = (opt.scenario == SIM_CURRENT) ? 0.0 : opt.load;
+  if (opt.scenario == SIM_CURRENT) {
+    plant->locked = 1;
+    plant->omega = opt.speed;
+  } else if (opt.scenario == SIM_SPEED) {
+    Cascade_SetMode(cascade, CASCADE_SPEED);
+    Cascade_SetSpeed(cascade, (float)opt.speed);
+  } else {
+    Cascade_SetMode(cascade, CASCADE_POSITION);
+    Cascade_SetPosition(cascade, cascade->pos + (float)opt.position);
+  }
+  /* 串级控制的多圈位置与模型机械角度之差，用于位置跟踪误差 */
+  double pos_offset = cascade->pos - plant->theta;
+
+  Sim_Metrics metrics;
+  uint32_t n_total = (uint32_t)(opt.time / foc->pwm.Ts);
+  uint32_t n_settle = (uint32_t)(opt.settle / foc->pwm.Ts);
+  for (uint32_t k = 0; k < n_total; k++) {
+    rig.iq_ref = (opt.scenario == SIM_CURRENT) ? (float)opt.iq : 0.0f;
+    Sim_RigPeriod(&rig);
+
+    double ref, error;
+    if (opt.scenario == SIM_CURRENT) {
+      ref = opt.iq;
+      error = ref - plant->iq;
+    } else if (opt.scenario == SIM_SPEED) {
+      ref = opt.speed;
+      error = ref - plant->omega;
+    } else {
+      ref = cascade->pos_ref;
+      error = ref - (plant->theta + pos_offset);
+    }
+
+    double theta_e = motor->pole_pairs * plant->theta;
+    if (k == n_settle)
+      Sim_MetricsReset(&metrics, theta_e);
+    if (k >= n_settle)
+      Sim_MetricsSample(&metrics, plant->iabc[0], theta_e, plant->torque,
+                        error);
+    if (trace != NULL)
+      fprintf(trace, "%.6f,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g,%.4f,%.4f,%.4f\n",
+              rig.periods * foc->pwm.Ts, ref, plant->id, plant->iq,
+              plant->omega, plant->theta, plant->torque, plant->duty[0],
+              plant->duty[1], plant->duty[2]);
+  }
+  double wall_ms = WallMs() - wall_start;
+  if (trace != NULL)
+    fclose(trace);
+
+  Sim_Report report;
+  Sim_MetricsReport(&metrics, &report);
+  const char *names[] = {"current", "speed", "position"};
+  printf("scenario=%s\n", names[opt.scenario]);
+  printf("periods=%u\n", rig.periods);
+  printf("sim_time_s=%.4f\n", rig.periods * foc->pwm.Ts);
+  printf("wall_ms=%.2f\n", wall_ms);
+  printf("periods_per_ms=%.1f\n", rig.periods / wall_ms);
+  printf("calib_offset_rad=%.4f\n", foc->param.angle_electrical_offset);
+  printf("current_thd=%.5f\n", report.current_thd);
+  printf("current_fund_a=%.5f\n", report.current_fund);
+  printf("torque_mean_nm=%.6f\n", report.torque_mean);
+  printf("torque_ripple_pp_nm=%.6f\n", report.torque_ripple_pp);
+  printf("torque_ripple_rms_nm=%.6f\n", report.torque_ripple_rms);
+  printf("tracking_rms=%.6g\n", report.tracking_rms);
+  printf("tracking_max=%.6g\n", report.tracking_max);
+  return 0;
+}
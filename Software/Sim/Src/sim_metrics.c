@@ -0,0 +1,99 @@
+#include "sim_metrics.h"
+#include "string.h"
+#include <math.h>
+
+/**
+ * @brief 解 3 阶对称正定方程组 m·k = r（Cholesky 分解），奇异时返回 0
+ */
+static uint8_t Solve3(double m[3][3], const double r[3], double k[3]) {
+  double l[3][3] = {{0}};
+  for (uint8_t i = 0; i < 3; i++) {
+    for (uint8_t j = 0; j <= i; j++) {
+      double sum = m[i][j];
+      for (uint8_t p = 0; p < j; p++)
+        sum -= l[i][p] * l[j][p];
+      if (i == j) {
+        if (sum <= 1e-12 * m[i][i])
+          return 0;
+        l[i][i] = sqrt(sum);
+      } else {
+        l[i][j] = sum / l[j][j];
+      }
+    }
+  }
+  double y[3];
+  for (uint8_t i = 0; i < 3; i++) {
+    y[i] = r[i];
+    for (uint8_t p = 0; p < i; p++)
+      y[i] -= l[i][p] * y[p];
+    y[i] /= l[i][i];
+  }
+  for (int8_t i = 2; i >= 0; i--) {
+    k[i] = y[i];
+    for (uint8_t p = i + 1; p < 3; p++)
+      k[i] -= l[p][i] * k[p];
+    k[i] /= l[i][i];
+  }
+  return 1;
+}
+
+void Sim_MetricsReset(Sim_Metrics *metrics, double theta_e) {
+  memset(metrics, 0, sizeof(Sim_Metrics));
+  metrics->theta_start = theta_e;
+  metrics->torque_min = INFINITY;
+  metrics->torque_max = -INFINITY;
+}
+
+void Sim_MetricsSample(Sim_Metrics *metrics, double current, double theta_e,
+                       double torque, double error) {
+  Sim_Harmonic *h = &metrics->harmonic;
+  double x[3] = {cos(theta_e), sin(theta_e), 1.0};
+  h->n++;
+  for (uint8_t i = 0; i < 3; i++) {
+    for (uint8_t j = 0; j < 3; j++)
+      h->m[i][j] += x[i] * x[j];
+    h->r[i] += current * x[i];
+  }
+  h->sq_sum += current * current;
+  metrics->theta_last = theta_e;
+
+  metrics->n++;
+  metrics->torque_sum += torque;
+  metrics->torque_sq_sum += torque * torque;
+  if (torque < metrics->torque_min)
+    metrics->torque_min = torque;
+  if (torque > metrics->torque_max)
+    metrics->torque_max = torque;
+  metrics->error_sq_sum += error * error;
+  if (fabs(error) > metrics->error_max)
+    metrics->error_max = fabs(error);
+}
+
+void Sim_MetricsReport(Sim_Metrics *metrics, Sim_Report *report) {
+  memset(report, 0, sizeof(Sim_Report));
+  report->current_thd = -1.0;
+
+  /* 不足一个电周期时基波拟合没有意义 */
+  Sim_Harmonic *h = &metrics->harmonic;
+  double k[3];
+  if (fabs(metrics->theta_last - metrics->theta_start) >= 2.0 * M_PI &&
+      Solve3(h->m, h->r, k)) {
+    double fund = sqrt(k[0] * k[0] + k[1] * k[1]);
+    double residual = (h->sq_sum - k[0] * h->r[0] - k[1] * h->r[1] -
+                       k[2] * h->r[2]) / h->n;
+    report->current_fund = fund;
+    if (fund > 0.0)
+      report->current_thd =
+          sqrt((residual > 0.0) ? residual : 0.0) / (fund / sqrt(2.0));
+  }
+
+  if (metrics->n > 0) {
+    double mean = metrics->torque_sum / metrics->n;
+    double var = metrics->torque_sq_sum / metrics->n - mean * mean;
+    report->torque_mean = mean;
+    report->torque_ripple_pp = metrics->torque_max - metrics->torque_min;
+    report->torque_ripple_rms = sqrt((var > 0.0) ? var : 0.0);
+    report->tracking_rms = sqrt(metrics->error_sq_sum / metrics->n);
+    report->tracking_max = metrics->error_max;
+  }
+}
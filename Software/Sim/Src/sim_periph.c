@@ -0,0 +1,220 @@
+#include "sim_periph.h"
+#include "string.h"
+
+/* 寄存器替身，stm32g4xx.h 中的外设宏指向这里 */
+TIM_TypeDef sim_tim1;
+ADC_TypeDef sim_adc1;
+ADC_TypeDef sim_adc2;
+SPI_TypeDef sim_spi1;
+GPIO_TypeDef sim_gpioa;
+DMA_TypeDef sim_dma1;
+DMA_TypeDef sim_dma2;
+DMA_Channel_TypeDef sim_dma1_ch1;
+DMA_Channel_TypeDef sim_dma1_ch2;
+CORDIC_TypeDef sim_cordic;
+FMAC_TypeDef sim_fmac;
+DWT_Type sim_dwt;
+CoreDebug_Type sim_coredebug;
+
+/* SPI 从设备 */
+static struct {
+  SPI_TypeDef *spi;
+  GPIO_TypeDef *cs_port;
+  uint16_t cs_pin;
+  Sim_SPI_Transfer transfer;
+  void *device;
+} sim_spi;
+
+/* HAL_ADC_Start_DMA 登记的循环 DMA 缓冲区 */
+static struct {
+  ADC_TypeDef *adc;
+  uint16_t *buf;
+  uint32_t length;
+} sim_adc_dma[SIM_ADC_DMA_MAX];
+
+/* ---------------- 驱动函数 Begin ---------------- */
+void Sim_PeriphReset(void) {
+  memset(&sim_tim1, 0, sizeof(sim_tim1));
+  memset(&sim_adc1, 0, sizeof(sim_adc1));
+  memset(&sim_adc2, 0, sizeof(sim_adc2));
+  memset(&sim_spi1, 0, sizeof(sim_spi1));
+  memset(&sim_gpioa, 0, sizeof(sim_gpioa));
+  memset(&sim_dma1, 0, sizeof(sim_dma1));
+  memset(&sim_dma2, 0, sizeof(sim_dma2));
+  memset(&sim_dma1_ch1, 0, sizeof(sim_dma1_ch1));
+  memset(&sim_dma1_ch2, 0, sizeof(sim_dma1_ch2));
+  memset(&sim_cordic, 0, sizeof(sim_cordic));
+  memset(&sim_fmac, 0, sizeof(sim_fmac));
+  memset(&sim_dwt, 0, sizeof(sim_dwt));
+  memset(&sim_coredebug, 0, sizeof(sim_coredebug));
+  memset(&sim_spi, 0, sizeof(sim_spi));
+  memset(sim_adc_dma, 0, sizeof(sim_adc_dma));
+}
+
+void Sim_SPI_Attach(SPI_TypeDef *spi, GPIO_TypeDef *cs_port, uint16_t cs_pin,
+                    Sim_SPI_Transfer transfer, void *device) {
+  sim_spi.spi = spi;
+  sim_spi.cs_port = cs_port;
+  sim_spi.cs_pin = cs_pin;
+  sim_spi.transfer = transfer;
+  sim_spi.device = device;
+}
+
+void Sim_ADC_Injected(ADC_TypeDef *adc, const uint16_t *codes, uint8_t n) {
+  volatile uint32_t *jdr[4] = {&adc->JDR1, &adc->JDR2, &adc->JDR3, &adc->JDR4};
+  for (uint8_t i = 0; i < n && i < 4; i++)
+    *jdr[i] = codes[i];
+  adc->ISR |= ADC_ISR_JEOC | ADC_ISR_JEOS;
+}
+
+void Sim_ADC_Regular(ADC_TypeDef *adc, const uint16_t *codes, uint8_t n) {
+  if (n == 0)
+    return;
+  adc->DR = codes[n - 1];
+  adc->ISR |= ADC_ISR_EOC | ADC_ISR_EOS;
+  for (uint8_t i = 0; i < SIM_ADC_DMA_MAX; i++) {
+    if (sim_adc_dma[i].adc != adc)
+      continue;
+    for (uint32_t k = 0; k < sim_adc_dma[i].length && k < n; k++)
+      sim_adc_dma[i].buf[k] = codes[k];
+  }
+}
+
+void Sim_TIM_Duty(TIM_TypeDef *tim, float duty[3]) {
+  uint32_t ccr[3] = {tim->CCR1, tim->CCR2, tim->CCR3};
+  uint32_t enable[3] = {TIM_CCER_CC1E, TIM_CCER_CC2E, TIM_CCER_CC3E};
+  float period = (float)tim->ARR + 1.0f;
+  for (uint8_t i = 0; i < 3; i++) {
+    float d = (tim->CCER & enable[i]) ? (float)ccr[i] / period : 0.0f;
+    duty[i] = (d > 1.0f) ? 1.0f : d;
+  }
+}
+/* ---------------- 驱动函数  End  ---------------- */
+
+/* ---------------- HAL 替身 Begin ---------------- */
+uint32_t HAL_RCC_GetPCLK2Freq(void) { return SIM_PCLK2_FREQ; }
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim) {
+  htim->Instance->ARR = htim->Init.Period;
+  htim->Instance->PSC = htim->Init.Prescaler;
+  htim->Instance->DIER |= TIM_DIER_UIE;
+  htim->Instance->CR1 |= TIM_CR1_CEN;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t Channel) {
+  htim->Instance->CCER |= TIM_CCER_CC1E << (Channel & 0x1FU);
+  htim->Instance->BDTR |= TIM_BDTR_MOE;
+  htim->Instance->CR1 |= TIM_CR1_CEN;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIMEx_PWMN_Start(TIM_HandleTypeDef *htim,
+                                       uint32_t Channel) {
+  htim->Instance->CCER |= TIM_CCER_CC1NE << (Channel & 0x1FU);
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADCEx_Calibration_Start(ADC_HandleTypeDef *hadc,
+                                              uint32_t SingleDiff) {
+  (void)SingleDiff;
+  hadc->Instance->CR &= ~ADC_CR_ADCAL;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADCEx_InjectedStart_IT(ADC_HandleTypeDef *hadc) {
+  hadc->Instance->IER |= ADC_IER_JEOSIE;
+  hadc->Instance->CR |= ADC_CR_ADEN | ADC_CR_JADSTART;
+  return HAL_OK;
+}
+
+uint32_t HAL_ADCEx_InjectedGetValue(const ADC_HandleTypeDef *hadc,
+                                    uint32_t InjectedRank) {
+  switch (InjectedRank) {
+  case ADC_INJECTED_RANK_1:
+    return hadc->Instance->JDR1;
+  case ADC_INJECTED_RANK_2:
+    return hadc->Instance->JDR2;
+  case ADC_INJECTED_RANK_3:
+    return hadc->Instance->JDR3;
+  default:
+    return hadc->Instance->JDR4;
+  }
+}
+
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *pData,
+                                    uint32_t Length) {
+  for (uint8_t i = 0; i < SIM_ADC_DMA_MAX; i++) {
+    if (sim_adc_dma[i].adc != NULL && sim_adc_dma[i].adc != hadc->Instance)
+      continue;
+    sim_adc_dma[i].adc = hadc->Instance;
+    sim_adc_dma[i].buf = (uint16_t *)pData; // DMA 按半字传输
+    sim_adc_dma[i].length = Length;
+    hadc->Instance->CFGR |= ADC_CFGR_DMAEN | ADC_CFGR_DMACFG;
+    hadc->Instance->CR |= ADC_CR_ADEN | ADC_CR_ADSTART;
+    if (hadc->DMA_Handle != NULL)
+      hadc->DMA_Handle->Instance->CCR |= DMA_CCR_EN | DMA_CCR_CIRC;
+    return HAL_OK;
+  }
+  return HAL_ERROR;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin,
+                       GPIO_PinState PinState) {
+  if (PinState != GPIO_PIN_RESET)
+    GPIOx->ODR |= GPIO_Pin;
+  else
+    GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi,
+                                          const uint8_t *pTxData,
+                                          uint8_t *pRxData, uint16_t Size,
+                                          uint32_t Timeout) {
+  (void)Timeout;
+  const uint16_t *tx = (const uint16_t *)pTxData;
+  uint16_t *rx = (uint16_t *)pRxData;
+  SPI_TypeDef *spi = hspi->Instance;
+
+  /* 16 位帧：写 DR 移出，从设备同时移入，读 DR 取回 */
+  for (uint16_t i = 0; i < Size; i++) {
+    spi->DR = tx[i];
+    uint8_t selected = sim_spi.spi == spi && sim_spi.transfer != NULL &&
+                       (sim_spi.cs_port->ODR & sim_spi.cs_pin) == 0;
+    spi->DR = selected ? sim_spi.transfer(sim_spi.device, tx[i]) : 0xFFFFU;
+    spi->SR |= SPI_SR_RXNE | SPI_SR_TXE;
+    rx[i] = (uint16_t)spi->DR;
+  }
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart,
+                                    const uint8_t *pData, uint16_t Size,
+                                    uint32_t Timeout) {
+  (void)huart, (void)pData, (void)Size, (void)Timeout;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart,
+                                       const uint8_t *pData, uint16_t Size) {
+  (void)huart, (void)pData, (void)Size;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart,
+                                        const uint8_t *pData, uint16_t Size) {
+  (void)huart, (void)pData, (void)Size;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart,
+                                               uint8_t *pData, uint16_t Size) {
+  (void)huart, (void)pData, (void)Size;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_DMAStop(UART_HandleTypeDef *huart) {
+  (void)huart;
+  return HAL_OK;
+}
+/* ---------------- HAL 替身  End  ---------------- */
@@ -0,0 +1,204 @@
+#include "sim_plant.h"
+#include "string.h"
+#include <math.h>
+
+#define SQRT3 1.7320508075688772
+
+/* AS5047P 寄存器地址 */
+#define SIM_AS5047P_ERRFL 0x0001
+#define SIM_AS5047P_DIAAGC 0x3FFC
+#define SIM_AS5047P_MAG 0x3FFD
+#define SIM_AS5047P_ANGLEUNC 0x3FFE
+#define SIM_AS5047P_ANGLECOM 0x3FFF
+
+/* ---------------- 驱动函数 Begin ---------------- */
+/**
+ * @brief 均匀分布随机数 [0, 1)，xorshift32
+ */
+static double Uniform(Sim_Plant *plant) {
+  uint32_t x = plant->noise;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  plant->noise = x;
+  return (double)x / 4294967296.0;
+}
+
+/**
+ * @brief 近似标准正态分布随机数（12 个均匀分布之和）
+ */
+static double Gauss(Sim_Plant *plant) {
+  double sum = 0.0;
+  for (uint8_t i = 0; i < 12; i++)
+    sum += Uniform(plant);
+  return sum - 6.0;
+}
+
+/**
+ * @brief 死区期间相电压由电流方向决定，小电流时电流在死区内过零，误差按比例减小
+ */
+static double DeadTimeSign(double current) {
+  double s = current * (1.0 / 0.02);
+  return (s > 1.0) ? 1.0 : (s < -1.0) ? -1.0 : s;
+}
+
+/**
+ * @brief 由 dq 电流和电角度的正余弦计算相电流
+ */
+static void PhaseCurrents(Sim_Plant *plant, double c, double s) {
+  double alpha = plant->id * c - plant->iq * s;
+  double beta = plant->id * s + plant->iq * c;
+  plant->iabc[0] = alpha;
+  plant->iabc[1] = -0.5 * alpha + 0.5 * SQRT3 * beta;
+  plant->iabc[2] = -0.5 * alpha - 0.5 * SQRT3 * beta;
+}
+
+/**
+ * @brief 单位向量 (c, s) 旋转一个小角度 delta，以泰勒展开代替 sin/cos
+ * @note 截断误差约 delta^5 / 120，每次 Sim_PlantStep 开始时重新由 sin/cos 校正
+ */
+static void Rotate(double *c, double *s, double delta) {
+  double d2 = delta * delta;
+  double cd = 1.0 - d2 * (0.5 - d2 * (1.0 / 24.0));
+  double sd = delta * (1.0 - d2 * (1.0 / 6.0 - d2 * (1.0 / 120.0)));
+  double c0 = *c;
+  *c = c0 * cd - *s * sd;
+  *s = c0 * sd + *s * cd;
+}
+
+/**
+ * @brief 电源侧母线电压：标称值 + 正弦纹波 - 定时跌落，不含内阻压降
+ * @param ripple_s 纹波相位的正弦值
+ */
+static double SourceVoltage(Sim_Plant *plant, double ripple_s) {
+  Sim_Plant_Init_Config_s *cfg = &plant->config;
+  double v = cfg->vbus + cfg->vbus_ripple * ripple_s;
+  if (plant->time >= cfg->vbus_sag_start &&
+      plant->time < cfg->vbus_sag_start + cfg->vbus_sag_time)
+    v -= cfg->vbus_sag;
+  return v;
+}
+
+/**
+ * @brief 偶校验：16 位中 1 的个数为偶数时返回 0
+ */
+static uint16_t Parity(uint16_t x) {
+  x ^= x >> 8;
+  x ^= x >> 4;
+  x ^= x >> 2;
+  x ^= x >> 1;
+  return x & 1U;
+}
+/* ---------------- 驱动函数  End  ---------------- */
+
+/* ---------------- 用户函数 Begin ---------------- */
+void Sim_PlantInit(Sim_Plant *plant, Sim_Plant_Init_Config_s *config) {
+  memset(plant, 0, sizeof(Sim_Plant));
+  plant->config = *config;
+  plant->noise = 0x12345678U;
+  plant->vbus = config->vbus;
+}
+
+void Sim_PlantStep(Sim_Plant *plant, double t, uint16_t substeps) {
+  Sim_Plant_Init_Config_s *cfg = &plant->config;
+  double dt = t / substeps;
+  double p = cfg->pole_pairs;
+  double dead = cfg->dead_time / cfg->Ts;
+  double Ld_inv = 1.0 / cfg->Ld, Lq_inv = 1.0 / cfg->Lq, J_inv = 1.0 / cfg->J;
+
+  /* 电角度、齿槽角度和纹波相位的正余弦每次调用只计算一次，积分步之间按增量旋转 */
+  double theta_e = p * plant->theta;
+  double c = cos(theta_e), s = sin(theta_e);
+  double cog = cfg->slots * plant->theta;
+  double cog_c = cos(cog), cog_s = sin(cog);
+  double ripple = 2.0 * M_PI * cfg->vbus_ripple_freq;
+  double ripple_c = cos(ripple * plant->time), ripple_s = sin(ripple * plant->time);
+
+  for (uint16_t k = 0; k < substeps; k++) {
+    PhaseCurrents(plant, c, s);
+
+    /* 母线：电源电压减去内阻上的压降，母线电流为各桥臂上管导通期间的相电流之和 */
+    double idc = plant->duty[0] * plant->iabc[0] +
+                 plant->duty[1] * plant->iabc[1] +
+                 plant->duty[2] * plant->iabc[2];
+    plant->vbus = SourceVoltage(plant, ripple_s) - cfg->vbus_res * idc;
+
+    /* 逆变器：桥臂平均电压，死区误差与相电流方向相反；中性点悬空，减去零序 */
+    double v[3];
+    for (uint8_t i = 0; i < 3; i++)
+      v[i] = (plant->duty[i] - dead * DeadTimeSign(plant->iabc[i])) *
+             plant->vbus;
+    double v0 = (v[0] + v[1] + v[2]) * (1.0 / 3.0);
+    double alpha = v[0] - v0;
+    double beta = (v[1] - v[2]) * (1.0 / SQRT3);
+
+    /* 电机：转子 dq 坐标系下的电压方程 */
+    double vd = alpha * c + beta * s;
+    double vq = -alpha * s + beta * c;
+    double we = p * plant->omega;
+    double did = (vd - cfg->R * plant->id + we * cfg->Lq * plant->iq) * Ld_inv;
+    double diq =
+        (vq - cfg->R * plant->iq - we * (cfg->Ld * plant->id + cfg->flux)) *
+        Lq_inv;
+    plant->id += did * dt;
+    plant->iq += diq * dt;
+
+    /* 机械：电磁转矩 + 齿槽转矩 - 摩擦 - 负载 */
+    plant->torque =
+        1.5 * p * (cfg->flux + (cfg->Ld - cfg->Lq) * plant->id) * plant->iq -
+        cfg->cogging * cog_s;
+    if (!plant->locked)
+      plant->omega +=
+          (plant->torque - cfg->B * plant->omega - plant->load) * J_inv * dt;
+    double dtheta = plant->omega * dt;
+    plant->theta += dtheta;
+    plant->time += dt;
+    Rotate(&c, &s, p * dtheta);
+    Rotate(&cog_c, &cog_s, cfg->slots * dtheta);
+    Rotate(&ripple_c, &ripple_s, ripple * dt);
+  }
+  PhaseCurrents(plant, c, s);
+}
+
+void Sim_PlantCurrentCodes(Sim_Plant *plant, uint16_t codes[2]) {
+  double current[2] = {plant->iabc[0], plant->iabc[2]};
+  for (uint8_t i = 0; i < 2; i++) {
+    double i_meas = current[i] + plant->config.current_noise * Gauss(plant);
+    long code = lround(SIM_ADC_MID + i_meas / plant->config.current_gain);
+    codes[i] = (uint16_t)((code < 0) ? 0 : (code > SIM_ADC_FULL) ? SIM_ADC_FULL : code);
+  }
+}
+
+uint16_t Sim_PlantVBusCode(Sim_Plant *plant) {
+  long code = lround(plant->vbus / plant->config.vbus_gain);
+  return (uint16_t)((code > SIM_ADC_FULL) ? SIM_ADC_FULL : code);
+}
+
+uint16_t Sim_PlantEncoderTransfer(void *device, uint16_t mosi) {
+  Sim_Plant *plant = (Sim_Plant *)device;
+  uint16_t data = 0;
+  switch (plant->spi_addr) {
+  case SIM_AS5047P_ANGLECOM:
+  case SIM_AS5047P_ANGLEUNC: {
+    double turn = (plant->config.encoder_zero - plant->theta) / (2.0 * M_PI);
+    turn -= floor(turn);
+    data = (uint16_t)(turn * 16384.0) & 0x3FFFU;
+    break;
+  }
+  case SIM_AS5047P_DIAAGC:
+    data = 0x0100; // LF：内部偏移补偿完成
+    break;
+  case SIM_AS5047P_MAG:
+    data = 0x0800;
+    break;
+  default:
+    break;
+  }
+
+  /* 命令校验错误时置位错误标志 EF（bit14） */
+  if (Parity(mosi) != 0)
+    data |= 0x4000U;
+  plant->spi_addr = mosi & 0x3FFFU;
+  return data | (uint16_t)(Parity(data) << 15);
+}
+/* ---------------- 用户函数  End  ---------------- */
@@ -0,0 +1,193 @@
+#include "sim_rig.h"
+#include "arm_math.h"
+#include "sim_periph.h"
+#include "string.h"
+#include <math.h>
+
+/* ---------------- 用户函数 Begin ---------------- */
+void Sim_RigDefaults(Sim_Rig_Init_Config_s *config) {
+  memset(config, 0, sizeof(Sim_Rig_Init_Config_s));
+  config->dead_time = 200e-9;
+  config->delay = 0.5;
+  config->substeps = SIM_SUBSTEPS;
+  config->decouple = 1;
+  config->vbus_sense = 1;
+
+  /* 14 极对云台电机（12 槽 28 极，齿槽转矩每圈 84 个周期） */
+  Sim_Plant_Init_Config_s *motor = &config->motor;
+  motor->R = 2.0;
+  motor->Ld = 1.0e-3;
+  motor->Lq = 1.2e-3;
+  motor->flux = 6.0e-3;
+  motor->pole_pairs = 14;
+  motor->J = 3e-5;
+  motor->B = 2e-5;
+  motor->cogging = 2e-3;
+  motor->slots = 84;
+  motor->vbus = 12.0;
+  motor->vbus_ripple_freq = 300.0;
+  motor->Ts = 2.0 * (SIM_PWM_PERIOD + 1) / SIM_PCLK2_FREQ;
+  motor->current_gain = SIM_CURRENT_ADC_GAIN;
+  motor->current_noise = 0.005;
+  motor->vbus_gain = SIM_VBUS_ADC_GAIN;
+  motor->encoder_zero = 1.0;
+
+  /* 电流环带宽约 800 Hz：kp = ωc·L，ki = ωc·R */
+  float wc = 2.0f * PI * 800.0f;
+  FOC_InitTypedef *foc = &config->foc;
+  foc->powerVol = (float)motor->vbus;
+  foc->pole_pairs = motor->pole_pairs;
+  foc->modulation = FOC_SVPWM;
+  foc->current_gain = SIM_CURRENT_ADC_GAIN;
+  foc->current_kp = wc * (float)motor->Lq;
+  foc->current_ki = wc * (float)motor->R;
+  foc->limit_priority = FOC_VLIMIT_D_PRIORITY;
+  foc->vbus_rank = 0;
+  foc->vbus_gain = SIM_VBUS_ADC_GAIN;
+  foc->vbus_alpha = 0.05f;
+  foc->vbus_uv = 6.0f;
+  foc->vbus_ov = 28.0f;
+  foc->dt_band = 0.1f;
+  foc->current_max = 2.0f;
+  foc->Ld = (float)motor->Ld;
+  foc->Lq = (float)motor->Lq;
+  foc->flux = (float)motor->flux;
+
+  Cascade_Init_Config_s *cascade = &config->cascade;
+  cascade->speed_div = 10;
+  cascade->speed_phase = 0;
+  cascade->pos_div = 20;
+  cascade->pos_phase = 5;
+  cascade->speed_kp = 0.02f;
+  cascade->speed_ki = 0.2f;
+  cascade->iq_max = 1.5f;
+  cascade->speed_alpha = 0.2f;
+  cascade->speed_range = 200.0f;
+  cascade->pos_kp = 20.0f;
+  cascade->speed_max = 50.0f;
+  cascade->acc_gain =
+      (float)(motor->J / (1.5 * motor->pole_pairs * motor->flux));
+}
+
+uint8_t Sim_RigInit(Sim_Rig *rig, Sim_Rig_Init_Config_s *config) {
+  memset(rig, 0, sizeof(Sim_Rig));
+  Sim_PeriphReset();
+  rig->delay = config->delay;
+  rig->substeps = config->substeps ? config->substeps : SIM_SUBSTEPS;
+
+  Sim_Plant_Init_Config_s motor = config->motor;
+  motor.dead_time = config->dead_time;
+  Sim_PlantInit(&rig->plant, &motor);
+
+  rig->htim1.Instance = TIM1;
+  rig->htim1.Init.Prescaler = 0;
+  rig->htim1.Init.CounterMode = TIM_COUNTERMODE_CENTERALIGNED1;
+  rig->htim1.Init.Period = SIM_PWM_PERIOD;
+  rig->htim1.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+  TIM1->BDTR =
+      (uint32_t)lround(config->dead_time * SIM_PCLK2_FREQ) & TIM_BDTR_DTG;
+  rig->hadc1.Instance = ADC1;
+  rig->hadc2.Instance = ADC2;
+  rig->hadc2.Init.NbrOfConversion = 1;
+  rig->hdma_adc2.Instance = DMA1_Channel1;
+  rig->hadc2.DMA_Handle = &rig->hdma_adc2;
+  rig->hspi1.Instance = SPI1;
+  rig->hspi1.Init.DataSize = SPI_DATASIZE_16BIT;
+
+  FOC_InitTypedef init = config->foc;
+  init.tim = &rig->htim1;
+  init.adc = &rig->hadc1;
+  init.vbus_adc = config->vbus_sense ? &rig->hadc2 : NULL;
+  rig->foc = FOC_Register(&init);
+  if (rig->foc == NULL)
+    return 0;
+  FOC_SetDecoupling(rig->foc, config->decouple);
+
+  Cascade_Init_Config_s cascade_config = config->cascade;
+  cascade_config.foc = rig->foc;
+  rig->cascade = Cascade_Register(&cascade_config);
+  if (rig->cascade == NULL)
+    return 0;
+  Traj_Init_Config_s traj_config = {
+    .profile = TRAJ_SCURVE,
+    .Ts = rig->foc->pwm.Ts * cascade_config.pos_div,
+    .vel_max = 30.0f,
+    .acc_max = 300.0f,
+    .jerk_max = 10000.0f,
+  };
+  Traj_Instance *traj = Traj_Register(&traj_config);
+  if (traj == NULL)
+    return 0;
+  Cascade_SetTrajectory(rig->cascade, traj);
+
+  rig->as5047p = AS5047P_Register(&rig->hspi1, GPIOA, GPIO_PIN_15, 0.15f);
+  if (rig->as5047p == NULL)
+    return 0;
+  AS5047P_SetTracker(rig->as5047p, 1000.0f, rig->foc->pwm.Ts);
+  Sim_SPI_Attach(SPI1, GPIOA, GPIO_PIN_15, Sim_PlantEncoderTransfer,
+                 &rig->plant);
+  return 1;
+}
+
+uint8_t Sim_RigStart(Sim_Rig *rig, float calib_voltage) {
+  FOC_StartCalibrate(rig->foc, calib_voltage);
+  FOC_SetMode(rig->foc, FOC_CurrentLoopMode);
+  FOC_Init(rig->foc, 0.0f);
+
+  /* 电流零偏 + 电角度零偏校准，转子空载；参数辨识已启动时先于校准执行 */
+  while (rig->foc->calib.state == FOC_CALIB_RUNNING)
+    Sim_RigPeriod(rig);
+  return rig->foc->calib.state == FOC_CALIB_DONE;
+}
+
+void Sim_RigControl(Sim_Rig *rig) {
+  rig->mec_angle = 2 * PI - AS5047P_ReadAngle(rig->as5047p);
+  rig->ele_angle = FOC_ElectricalAngle(rig->foc, rig->mec_angle);
+  if (FOC_Identify(rig->foc, rig->mec_angle))
+    return;
+  if (FOC_CalibrateOffset(rig->foc, rig->mec_angle))
+    return;
+  Cascade_SetCurrent(rig->cascade, rig->id_ref, rig->iq_ref);
+  Cascade_Update(rig->cascade, rig->mec_angle, rig->ele_angle);
+}
+
+void Sim_RigPeriod(Sim_Rig *rig) {
+  Sim_Plant *plant = &rig->plant;
+  uint16_t codes[2];
+  Sim_PlantCurrentCodes(plant, codes);
+  Sim_ADC_Injected(ADC1, codes, 2);
+  uint16_t vbus = Sim_PlantVBusCode(plant);
+  Sim_ADC_Regular(ADC2, &vbus, 1);
+
+  if (rig->isr != NULL)
+    rig->isr(rig);
+  else
+    Sim_RigControl(rig);
+
+  double Ts = plant->config.Ts;
+  uint16_t n1 = (uint16_t)lround(rig->substeps * rig->delay);
+  if (n1 > 0)
+    Sim_PlantStep(plant, Ts * n1 / rig->substeps, n1);
+  Sim_TIM_Duty(TIM1, plant->duty);
+  if (n1 < rig->substeps)
+    Sim_PlantStep(plant, Ts * (rig->substeps - n1) / rig->substeps,
+                  rig->substeps - n1);
+  rig->periods++;
+}
+
+void Sim_RigRun(Sim_Rig *rig, uint32_t periods) {
+  for (uint32_t k = 0; k < periods; k++)
+    Sim_RigPeriod(rig);
+}
+
+double Sim_RigElectricalAngle(Sim_Rig *rig) {
+  return rig->plant.config.pole_pairs * rig->plant.theta;
+}
+
+double Sim_RigAngleError(Sim_Rig *rig, double angle) {
+  double err = fmod(angle - Sim_RigElectricalAngle(rig) + M_PI, 2.0 * M_PI);
+  if (err < 0.0)
+    err += 2.0 * M_PI;
+  return err - M_PI;
+}
+/* ---------------- 用户函数  End  ---------------- */
@@ -0,0 +1,35 @@
+#include "sim_test.h"
+#include "stdarg.h"
+#include "stdio.h"
+
+static uint32_t checks;
+static uint32_t failures;
+
+/* ---------------- 用户函数 Begin ---------------- */
+void Sim_Check(uint8_t pass, const char *fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  printf("%-4s ", pass ? "ok" : "FAIL");
+  vprintf(fmt, args);
+  printf("\n");
+  va_end(args);
+  checks++;
+  if (!pass)
+    failures++;
+}
+
+void Sim_Note(const char *fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  printf("     ");
+  vprintf(fmt, args);
+  printf("\n");
+  va_end(args);
+}
+
+int Sim_TestResult(void) {
+  printf("%lu/%lu checks passed\n", (unsigned long)(checks - failures),
+         (unsigned long)checks);
+  return (failures == 0 && checks > 0) ? 0 : 1;
+}
+/* ---------------- 用户函数  End  ---------------- */
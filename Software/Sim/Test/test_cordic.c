@@ -0,0 +1,41 @@
+/* CORDIC 软件模型的 sin/cos 误差：全角度范围扫描，与 libm 双精度结果比较 */
+#include "bsp_cordic.h"
+#include "sim_test.h"
+#include <math.h>
+
+#define TEST_N 1000000
+
+int main(void) {
+  CORDIC_Init();
+
+  double err_max = 0.0, angle_max = 0.0;
+  for (uint32_t i = 0; i < TEST_N; i++) {
+    /* [-1, 1) 均匀取点，再加上收敛域边界 ±1/2 附近和两端 */
+    int32_t angle = (int32_t)(INT32_MIN + (int64_t)i * 4294.967296 + 1);
+    if (i < 8) {
+      int32_t edges[] = {INT32_MIN, INT32_MAX, INT32_MAX >> 1,
+                         (INT32_MAX >> 1) + 1, INT32_MIN >> 1,
+                         (INT32_MIN >> 1) - 1, 0, -1};
+      angle = edges[i];
+    }
+    int32_t s, c;
+    CORDIC_SinCosStart(angle);
+    CORDIC_SinCosRead(&s, &c);
+
+    double theta = angle / 2147483648.0 * M_PI;
+    double es = fabs(s / 2147483648.0 - sin(theta));
+    double ec = fabs(c / 2147483648.0 - cos(theta));
+    double e = fmax(es, ec);
+    if (e > err_max) {
+      err_max = e;
+      angle_max = theta;
+    }
+  }
+  /* bsp_cordic.h 中标注的误差上限 */
+  Sim_Check(err_max < ldexp(1.0, -CORDIC_MODEL_ERROR_LOG2),
+            "precision %d model max |err| %.3e = 2^%.2f (at %.4f rad), "
+            "bound 2^-%d",
+            CORDIC_PRECISION, err_max, log2(err_max), angle_max,
+            CORDIC_MODEL_ERROR_LOG2);
+  return Sim_TestResult();
+}
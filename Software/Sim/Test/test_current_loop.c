@@ -0,0 +1,86 @@
+/* 电流环：锁定转子（RL 负载）上的阶跃响应和每次迭代的耗时 */
+#include "sim_rig.h"
+#include "sim_test.h"
+#include <math.h>
+
+#define TEST_STEP 1.0f // 阶跃幅值（A）
+#define TEST_N 400     // 阶跃后记录的 PWM 周期数（20 ms）
+
+typedef struct {
+  double rise;      // 10% ~ 90% 上升时间（s）
+  double overshoot; // 超调量（相对阶跃幅值）
+  double error;     // 最后 5 ms 的平均稳态误差（相对阶跃幅值）
+} Step_Result;
+
+/**
+ * @brief 对 d 轴或 q 轴施加电流阶跃，由模型的真实电流计算指标
+ */
+static void StepResponse(Sim_Rig *rig, uint8_t axis_q, Step_Result *result) {
+  static double trace[TEST_N];
+  rig->id_ref = 0.0f;
+  rig->iq_ref = 0.0f;
+  Sim_RigRun(rig, 400);
+
+  if (axis_q)
+    rig->iq_ref = TEST_STEP;
+  else
+    rig->id_ref = TEST_STEP;
+  for (uint32_t k = 0; k < TEST_N; k++) {
+    Sim_RigPeriod(rig);
+    trace[k] = axis_q ? rig->plant.iq : rig->plant.id;
+  }
+
+  double Ts = rig->foc->pwm.Ts;
+  double t10 = -1.0, t90 = -1.0, peak = 0.0, tail = 0.0;
+  for (uint32_t k = 0; k < TEST_N; k++) {
+    if (t10 < 0.0 && trace[k] >= 0.1 * TEST_STEP)
+      t10 = k * Ts;
+    if (t90 < 0.0 && trace[k] >= 0.9 * TEST_STEP)
+      t90 = k * Ts;
+    peak = fmax(peak, trace[k]);
+    if (k >= TEST_N - 100)
+      tail += trace[k] / 100.0;
+  }
+  result->rise = (t10 >= 0.0 && t90 >= 0.0) ? t90 - t10 : INFINITY;
+  result->overshoot = peak / TEST_STEP - 1.0;
+  result->error = fabs(tail - TEST_STEP) / TEST_STEP;
+}
+
+int main(void) {
+  Sim_Rig_Init_Config_s config;
+  Sim_RigDefaults(&config);
+  Sim_Rig rig;
+  if (!Sim_RigInit(&rig, &config) || !Sim_RigStart(&rig, 1.2f)) {
+    Sim_Check(0, "rig start");
+    return Sim_TestResult();
+  }
+
+  /* 锁定转子：电机退化为 RL 负载 */
+  rig.plant.locked = 1;
+  rig.plant.omega = 0.0;
+
+  /* 判据：带宽 800 Hz 的一阶响应上升时间为 0.44 ms，再加约 1.5 个 PWM 周期的延迟 */
+  const char *axis[] = {"d", "q"};
+  for (uint8_t q = 0; q <= 1; q++) {
+    Step_Result result;
+    StepResponse(&rig, q, &result);
+    Sim_Check(result.rise < 0.55e-3, "%s-axis 1 A step: rise time %.3f ms",
+              axis[q], result.rise * 1e3);
+    Sim_Check(result.overshoot < 0.15, "%s-axis 1 A step: overshoot %.1f %%",
+              axis[q], result.overshoot * 100.0);
+    Sim_Check(result.error < 0.02, "%s-axis 1 A step: steady error %.2f %%",
+              axis[q], result.error * 100.0);
+  }
+
+  /* 每次迭代的耗时：电流环（FOC_CurrentLoop）在主机上的执行时间 */
+  uint64_t sum = 0;
+  uint32_t n = 2000;
+  for (uint32_t k = 0; k < n; k++) {
+    Sim_RigPeriod(&rig);
+    sum += rig.cascade->loop_current.cycles_last;
+  }
+  Sim_Note("current loop per iteration: mean %.0f ns, max %lu ns (host)",
+           (double)sum / n, (unsigned long)rig.cascade->loop_current.cycles_max);
+  Sim_Check(sum > 0, "current loop timing recorded");
+  return Sim_TestResult();
+}
@@ -0,0 +1,59 @@
+/* 死区补偿：测功机拖动、电流模式下，补偿开关前后的相电流 THD 和转矩纹波 */
+#include "sim_metrics.h"
+#include "sim_rig.h"
+#include "sim_test.h"
+#include <math.h>
+
+#define TEST_SPEED 20.0 // 测功机转速（rad/s，机械角速度），电频率约 45 Hz
+#define TEST_IQ 0.5f    // Iq 目标（A），低于死区影响明显的电流范围
+#define TEST_N 8000     // 统计的 PWM 周期数（0.4 s，约 18 个电周期）
+
+/**
+ * @brief 运行电流模式场景，返回相电流 THD 与转矩纹波
+ * @param dt_band 死区补偿过零平滑区间（A），0 为关闭补偿
+ */
+static void Run(float dt_band, Sim_Report *report) {
+  Sim_Rig_Init_Config_s config;
+  Sim_RigDefaults(&config);
+  config.foc.dt_band = dt_band;
+  config.motor.current_noise = 0.0;
+  config.motor.cogging = 0.0;
+  Sim_Rig rig;
+  report->current_thd = INFINITY;
+  if (!Sim_RigInit(&rig, &config) || !Sim_RigStart(&rig, 1.2f))
+    return;
+
+  rig.plant.locked = 1;
+  rig.plant.omega = TEST_SPEED;
+  rig.iq_ref = TEST_IQ;
+  Sim_RigRun(&rig, 2000);
+
+  Sim_Metrics metrics;
+  Sim_MetricsReset(&metrics, Sim_RigElectricalAngle(&rig));
+  for (uint32_t k = 0; k < TEST_N; k++) {
+    Sim_RigPeriod(&rig);
+    Sim_MetricsSample(&metrics, rig.plant.iabc[0], Sim_RigElectricalAngle(&rig),
+                      rig.plant.torque, TEST_IQ - rig.plant.iq);
+  }
+  Sim_MetricsReport(&metrics, report);
+}
+
+int main(void) {
+  /* 死区 200 ns / 50 us，约 0.4% 占空比，即 48 mV 的相电压误差。
+   * 无采样噪声时过零平滑区间取 0.02 A；默认的 0.1 A 按 5 mA 噪声选取，
+   * 0.5 A 电流下约 13% 的电周期处在线性过渡区，补偿不完全，只作记录 */
+  Sim_Report off, on, wide;
+  Run(0.0f, &off);
+  Run(0.02f, &on);
+  Run(0.1f, &wide);
+  Sim_Check(on.current_thd < 0.5 * off.current_thd,
+            "200 ns dead time, Iq %.1f A at %.0f rad/s: THD %.2f %% off, "
+            "%.2f %% on (band 0.02 A)",
+            TEST_IQ, TEST_SPEED, off.current_thd * 100.0,
+            on.current_thd * 100.0);
+  Sim_Note("band 0.1 A: THD %.2f %%", wide.current_thd * 100.0);
+  Sim_Check(on.torque_ripple_rms < off.torque_ripple_rms,
+            "torque ripple rms: %.3f mNm off, %.3f mNm on",
+            off.torque_ripple_rms * 1e3, on.torque_ripple_rms * 1e3);
+  return Sim_TestResult();
+}
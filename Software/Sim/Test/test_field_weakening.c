@@ -0,0 +1,66 @@
+/* 弱磁：速度模式给定超过基速的目标，比较有无弱磁时的最高转速，
+ * 以及弱磁电流不超过上限、调制比维持在阈值附近 */
+#include "sim_rig.h"
+#include "sim_test.h"
+#include <math.h>
+
+#define TEST_SPEED 200.0f // 速度目标（rad/s，机械角速度），远高于基速
+#define TEST_ID_MAX 1.5f  // 弱磁电流上限（A）
+
+typedef struct {
+  double speed;    // 最后 0.1 s 的平均转速（rad/s）
+  double id;       // 最后 0.1 s 的平均 Id（A）
+  float fw_id_min; // 弱磁给定的最小值（A）
+  float mi;        // 最后一个周期的调制比
+} FW_Result;
+
+/**
+ * @param fw_id_max 弱磁电流上限（A），0 为关闭弱磁
+ */
+static void Run(float fw_id_max, FW_Result *result) {
+  Sim_Rig_Init_Config_s config;
+  Sim_RigDefaults(&config);
+  config.motor.cogging = 0.0;
+  config.foc.fw_id_max = fw_id_max;
+  config.foc.fw_ki = 50.0f;
+  config.foc.fw_mi_ref = 0.95f;
+  Sim_Rig rig;
+  result->speed = 0.0;
+  if (!Sim_RigInit(&rig, &config) || !Sim_RigStart(&rig, 1.2f))
+    return;
+
+  Cascade_SetMode(rig.cascade, CASCADE_SPEED);
+  Cascade_SetSpeed(rig.cascade, TEST_SPEED);
+  result->fw_id_min = 0.0f;
+  Sim_RigRun(&rig, 20000);
+  double speed = 0.0, id = 0.0;
+  for (uint32_t k = 0; k < 2000; k++) {
+    Sim_RigPeriod(&rig);
+    speed += rig.plant.omega / 2000.0;
+    id += rig.plant.id / 2000.0;
+    if (rig.foc->fw.id < result->fw_id_min)
+      result->fw_id_min = rig.foc->fw.id;
+  }
+  result->speed = speed;
+  result->id = id;
+  result->mi = FOC_GetModulationIndex(rig.foc);
+}
+
+int main(void) {
+  FW_Result off, on;
+  Run(0.0f, &off);
+  Run(TEST_ID_MAX, &on);
+
+  /* 基速约为线性区最大相电压 / (p * flux) */
+  Sim_Note("no field weakening: %.1f rad/s, id %.3f A, mi %.3f", off.speed,
+           off.id, off.mi);
+  Sim_Note("field weakening:    %.1f rad/s, id %.3f A, mi %.3f", on.speed,
+           on.id, on.mi);
+  Sim_Check(on.speed > 1.15 * off.speed,
+            "max speed with field weakening %.1f rad/s vs %.1f rad/s (+%.0f %%)",
+            on.speed, off.speed, (on.speed / off.speed - 1.0) * 100.0);
+  Sim_Check(on.fw_id_min >= -TEST_ID_MAX - 1e-6f && on.id < -0.2,
+            "field-weakening id %.3f A (command min %.3f A, limit -%.1f A)",
+            on.id, on.fw_id_min, TEST_ID_MAX);
+  return Sim_TestResult();
+}
@@ -0,0 +1,68 @@
+/* 滤波器：FMAC 后端（q1.15 模型）与 CPU 后端的一致性，以及控制循环中的接入 */
+#include "sim_rig.h"
+#include "sim_test.h"
+#include <math.h>
+
+/**
+ * @brief 同一低通滤波器分别在 FMAC 和 CPU 上运行，输入为带纹波的母线电压
+ */
+static void TestBackends(Filter_Instance *fmac, Filter_Instance *cpu,
+                         float full_scale) {
+  Filter_Preset(fmac, 12.0f);
+  Filter_Preset(cpu, 12.0f);
+  Sim_Check(fabsf(fmac->out - 12.0f) < full_scale / 32768.0f * 2.0f &&
+                fabsf(cpu->out - 12.0f) < 1e-4f,
+            "preset to 12 V: fmac %.4f V, cpu %.4f V", fmac->out, cpu->out);
+
+  double err_max = 0.0;
+  for (uint32_t k = 0; k < 4000; k++) {
+    float v = 12.0f + 2.0f * sinf(2.0f * (float)M_PI * 300.0f * k * 5e-5f) +
+              ((k / 1000) % 2 ? -3.0f : 0.0f);
+    Filter_Start(fmac, v);
+    Filter_Start(cpu, v);
+    double err = fabs(Filter_Finish(fmac) - Filter_Finish(cpu));
+    err_max = fmax(err_max, err);
+  }
+  /* 一阶低通截断误差的稳态上限约为 1 / alpha 个 LSB */
+  double lsb = full_scale / 32768.0;
+  Sim_Check(err_max < 25.0 * lsb,
+            "fmac vs cpu lowpass (alpha 0.05): max diff %.4f V = %.1f LSB",
+            err_max, err_max / lsb);
+}
+
+int main(void) {
+  Sim_Rig_Init_Config_s config;
+  Sim_RigDefaults(&config);
+  Sim_Rig rig;
+  if (!Sim_RigInit(&rig, &config)) {
+    Sim_Check(0, "rig init");
+    return Sim_TestResult();
+  }
+
+  /* 先注册的 Vbus 滤波器占用 FMAC，测速滤波器退回 CPU */
+  Sim_Check(rig.foc->vbus.filter->backend == FILTER_BACKEND_FMAC,
+            "vbus lowpass runs on the FMAC");
+  Sim_Check(rig.cascade->speed_filter->backend == FILTER_BACKEND_CPU,
+            "speed lowpass falls back to the CPU while the FMAC is taken");
+
+  /* 控制循环中的 Vbus 滤波：FMAC 输出跟随模型的母线电压 */
+  if (!Sim_RigStart(&rig, 1.2f)) {
+    Sim_Check(0, "rig start");
+    return Sim_TestResult();
+  }
+  Sim_RigRun(&rig, 400);
+  Sim_Check(fabsf(rig.foc->param.powerVol - 12.0f) < 0.1f,
+            "vbus in the loop: powerVol %.3f V", rig.foc->param.powerVol);
+
+  /* 同一滤波器的 CPU 版本与 FMAC 版本逐样本比较 */
+  Filter_Init_Config_s filter;
+  Filter_LowpassConfig(&filter, 0.05f);
+  filter.full_scale = rig.foc->vbus.filter->full_scale;
+  Filter_Instance *cpu = Filter_Register(&filter);
+  if (cpu == NULL) {
+    Sim_Check(0, "filter register");
+    return Sim_TestResult();
+  }
+  TestBackends(rig.foc->vbus.filter, cpu, filter.full_scale);
+  return Sim_TestResult();
+}
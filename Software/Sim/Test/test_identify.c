@@ -0,0 +1,53 @@
+/* 参数辨识：默认电机上辨识 Rs、Ld、Lq、磁链和极对数，与模型参数对比；
+ * 控制器的初值故意给错，结果须由辨识写入 */
+#include "sim_rig.h"
+#include "sim_test.h"
+#include <math.h>
+
+/**
+ * @brief 相对误差检查
+ */
+static void CheckParam(const char *name, double identified, double actual,
+                       double tol) {
+  double err = (identified - actual) / actual;
+  Sim_Check(fabs(err) < tol, "%-4s identified %.4g, actual %.4g, error %+.1f %%",
+            name, identified, actual, err * 100.0);
+}
+
+int main(void) {
+  Sim_Rig_Init_Config_s config;
+  Sim_RigDefaults(&config);
+  config.foc.pole_pairs = 7;
+  config.foc.Ld = 0.5e-3f;
+  config.foc.Lq = 0.5e-3f;
+  config.foc.flux = 3e-3f;
+  Sim_Rig rig;
+  if (!Sim_RigInit(&rig, &config)) {
+    Sim_Check(0, "rig init");
+    return Sim_TestResult();
+  }
+
+  /* 与 main.c 的辨识配置相同 */
+  FOC_IdentTypedef ident_config = {
+    .current = 1.5f,
+    .voltage = 2.0f,
+    .speed = 300.0f,
+    .accel = 600.0f,
+  };
+  FOC_StartIdentify(rig.foc, &ident_config);
+  uint8_t calibrated = Sim_RigStart(&rig, 1.2f);
+  Sim_Check(rig.foc->ident.state == FOC_IDENT_DONE,
+            "identification finished (state %d)", rig.foc->ident.state);
+  Sim_Check(calibrated, "offset calibration with identified pole pairs");
+
+  FOC_MotorParam *param = &rig.foc->param;
+  Sim_Plant_Init_Config_s *motor = &config.motor;
+  CheckParam("Rs", param->Rs, motor->R, 0.1);
+  CheckParam("Ld", param->Ld, motor->Ld, 0.1);
+  CheckParam("Lq", param->Lq, motor->Lq, 0.1);
+  CheckParam("flux", param->flux, motor->flux, 0.1);
+  Sim_Check(param->pole_pairs == motor->pole_pairs,
+            "pole pairs identified %u, actual %u", param->pole_pairs,
+            motor->pole_pairs);
+  return Sim_TestResult();
+}
@@ -0,0 +1,215 @@
+/* AS5047P 非线性补偿表学习：SPI 上接偏心安装的 14 位编码器，
+ * 读数含一次、二次谐波误差，
+ * 1. 匀速运行 SYNC → PERIOD → LEARN → DONE，补偿后的残差为注入误差的一小部分；
+ * 2. 学习中反向、某圈周期超出 ±10%、分段未覆盖时进入 AS5047P_LUT_ERROR，补偿表不变 */
+#include "as5047.h"
+#include "sim_periph.h"
+#include "sim_test.h"
+#include <math.h>
+
+#define TEST_LSB (2.0 * M_PI / 16384.0)
+#define TEST_SAMPLES 2000 // 每圈读取次数
+#define TEST_H1 0.02      // 一次谐波幅值（rad），偏心
+#define TEST_H2 0.008     // 二次谐波幅值（rad），磁铁不对称
+#define TEST_REVOLUTIONS 4
+
+/* 编码器：读数为真实角度加谐波误差后向下取整的 14 位码值 */
+typedef struct {
+  double angle; // 真实角度（rad，多圈）
+} Test_Encoder;
+
+static double EncoderError(double angle) {
+  return TEST_H1 * sin(angle + 0.7) + TEST_H2 * sin(2.0 * angle - 1.9);
+}
+
+static uint16_t EncoderTransfer(void *device, uint16_t mosi) {
+  (void)mosi;
+  Test_Encoder *encoder = (Test_Encoder *)device;
+  double turn = (encoder->angle + EncoderError(encoder->angle)) / (2.0 * M_PI);
+  turn -= floor(turn);
+  return (uint16_t)(turn * 16384.0) & 0x3FFFU;
+}
+
+static Test_Encoder encoder;
+static SPI_HandleTypeDef hspi;
+
+/**
+ * @brief 读数与真实角度之差，回绕到 [-PI, PI)
+ */
+static double AngleError(float angle, double truth) {
+  double err = fmod(angle - truth + M_PI, 2.0 * M_PI);
+  if (err < 0.0)
+    err += 2.0 * M_PI;
+  return err - M_PI;
+}
+
+/**
+ * @brief 注册编码器并开始学习；低通系数为 1，读数即补偿后的角度
+ * @param revolutions 学习圈数，0 时不学习（无补偿表）
+ */
+static AS5047P_Instance *NewEncoder(uint16_t revolutions) {
+  Sim_PeriphReset();
+  hspi.Instance = SPI1;
+  hspi.Init.DataSize = SPI_DATASIZE_16BIT;
+  Sim_SPI_Attach(SPI1, GPIOA, GPIO_PIN_15, EncoderTransfer, &encoder);
+  AS5047P_Instance *as5047p = AS5047P_Register(&hspi, GPIOA, GPIO_PIN_15, 1.0f);
+  if (as5047p == NULL)
+    return NULL;
+  if (revolutions == 0)
+    return as5047p;
+  AS5047P_StartLinearize(as5047p, revolutions);
+  return (as5047p->lut != NULL) ? as5047p : NULL;
+}
+
+/**
+ * @brief 以 step（rad / 次）读取 n 次，学习结束即停止
+ */
+static void Rotate(AS5047P_Instance *as5047p, double step, uint32_t n) {
+  for (uint32_t k = 0; k < n; k++) {
+    AS5047P_ReadAngle(as5047p);
+    if (as5047p->lut->state == AS5047P_LUT_DONE ||
+        as5047p->lut->state == AS5047P_LUT_ERROR)
+      return;
+    encoder.angle += step;
+  }
+}
+
+/**
+ * @brief 再转一圈，统计去除常值偏移后的角度误差峰值
+ */
+static double Residual(AS5047P_Instance *as5047p, double step) {
+  static double err[2 * TEST_SAMPLES];
+  uint32_t n = (uint32_t)(2.0 * M_PI / fabs(step));
+  if (n > 2 * TEST_SAMPLES)
+    n = 2 * TEST_SAMPLES;
+  double mean = 0.0, peak = 0.0;
+  for (uint32_t k = 0; k < n; k++) {
+    err[k] = AngleError(AS5047P_ReadAngle(as5047p), encoder.angle);
+    mean += err[k] / n;
+    encoder.angle += step;
+  }
+  for (uint32_t k = 0; k < n; k++)
+    peak = fmax(peak, fabs(err[k] - mean));
+  return peak;
+}
+
+static uint8_t TableUntouched(const AS5047P_Lut *lut) {
+  for (uint16_t i = 0; i < AS5047P_LUT_SIZE; i++)
+    if (lut->table[i] != 0.0f)
+      return 0;
+  return 1;
+}
+
+/**
+ * @brief 匀速学习，残差与注入误差比较
+ * @param step 每次读取转过的角度（rad），负数为反转
+ */
+static void Learn(double step, const char *name) {
+  AS5047P_Instance *as5047p = NewEncoder(0);
+  if (as5047p == NULL) {
+    Sim_Check(0, "as5047p register");
+    return;
+  }
+  encoder.angle = 0.4;
+  double before = Residual(as5047p, step);
+
+  /* 同步、测周期各约一圈，另留一圈余量 */
+  AS5047P_StartLinearize(as5047p, TEST_REVOLUTIONS);
+  if (as5047p->lut == NULL) {
+    Sim_Check(0, "%s: lut allocation", name);
+    return;
+  }
+  uint8_t seen[AS5047P_LUT_ERROR + 1] = {0};
+  uint32_t n = (uint32_t)((TEST_REVOLUTIONS + 3) * 2.0 * M_PI / fabs(step));
+  for (uint32_t k = 0; k < n; k++) {
+    seen[as5047p->lut->state] = 1;
+    if (as5047p->lut->state == AS5047P_LUT_DONE ||
+        as5047p->lut->state == AS5047P_LUT_ERROR)
+      break;
+    AS5047P_ReadAngle(as5047p);
+    encoder.angle += step;
+  }
+  AS5047P_LutState state = as5047p->lut->state;
+  Sim_Check(seen[AS5047P_LUT_SYNC] && seen[AS5047P_LUT_PERIOD] &&
+                seen[AS5047P_LUT_LEARN] && state == AS5047P_LUT_DONE,
+            "%s: SYNC -> PERIOD -> LEARN -> DONE (state %d)", name, state);
+
+  double after = Residual(as5047p, step);
+  Sim_Check(before > TEST_H1 && after < 0.05 * before,
+            "%s: residual %.2e rad of injected %.2e rad (%.1f%%, %.1f LSB)",
+            name, after, before, 100.0 * after / before, after / TEST_LSB);
+}
+
+/**
+ * @brief 学习出错：补偿表保持学习前的值（全 0）
+ */
+static void CheckError(AS5047P_Instance *as5047p, const char *name) {
+  AS5047P_LutState state = as5047p->lut->state;
+  Sim_Check(state == AS5047P_LUT_ERROR && TableUntouched(as5047p->lut),
+            "%s: state %d (ERROR %d), table unchanged", name, state,
+            AS5047P_LUT_ERROR);
+}
+
+/**
+ * @brief 进入 LEARN 后刚转过零点即反向，下一次过零方向不同
+ */
+static void Reverse(void) {
+  AS5047P_Instance *as5047p = NewEncoder(TEST_REVOLUTIONS);
+  if (as5047p == NULL) {
+    Sim_Check(0, "as5047p register");
+    return;
+  }
+  double step = 2.0 * M_PI / TEST_SAMPLES;
+  encoder.angle = 0.4;
+  while (as5047p->lut->state != AS5047P_LUT_LEARN &&
+         as5047p->lut->state != AS5047P_LUT_ERROR &&
+         encoder.angle < 4.0 * M_PI)
+    Rotate(as5047p, step, 1);
+  /* 反向后约 0.05 圈回到零点，远在 1.5 倍周期的超时之前 */
+  Rotate(as5047p, step, TEST_SAMPLES / 20);
+  Rotate(as5047p, -step, TEST_SAMPLES);
+  CheckError(as5047p, "direction change");
+}
+
+/**
+ * @brief 学习中转速变为 scale 倍，该圈周期超出上一圈的 ±10%
+ */
+static void SpeedChange(double scale, const char *name) {
+  AS5047P_Instance *as5047p = NewEncoder(TEST_REVOLUTIONS);
+  if (as5047p == NULL) {
+    Sim_Check(0, "as5047p register");
+    return;
+  }
+  double step = 2.0 * M_PI / TEST_SAMPLES;
+  encoder.angle = 0.4;
+  Rotate(as5047p, step, 3 * TEST_SAMPLES);
+  uint8_t learning = as5047p->lut->state == AS5047P_LUT_LEARN;
+  Rotate(as5047p, step * scale, 2 * TEST_SAMPLES);
+  Sim_Check(learning, "%s: still learning before the speed change", name);
+  CheckError(as5047p, name);
+}
+
+/**
+ * @brief 每圈读取次数少于分段数，学习一圈后必有分段没有采样
+ */
+static void EmptyBin(void) {
+  AS5047P_Instance *as5047p = NewEncoder(1);
+  if (as5047p == NULL) {
+    Sim_Check(0, "as5047p register");
+    return;
+  }
+  uint32_t n = AS5047P_LUT_SIZE * 3 / 4;
+  encoder.angle = 0.4;
+  Rotate(as5047p, 2.0 * M_PI / n, 5 * n);
+  CheckError(as5047p, "empty bin");
+}
+
+int main(void) {
+  Learn(2.0 * M_PI / TEST_SAMPLES, "forward");
+  Learn(-2.0 * M_PI / (TEST_SAMPLES * 1.37), "reverse");
+  Reverse();
+  SpeedChange(1.15, "period -13%");
+  SpeedChange(0.85, "period +18%");
+  EmptyBin();
+  return Sim_TestResult();
+}
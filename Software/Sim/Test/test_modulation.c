@@ -0,0 +1,201 @@
+/* 调制：零序注入实现的 CCR 与零序注入之前的 FOC_SetSPWM、SetSVPWM（原样保留在
+ * sim_legacy_pwm.h）以及按作用时间独立计算的扇区法 SVPWM 对比，THIPWM 与解析式对比，
+ * 以及不连续调制的线电压和钳位。直接包含 foc.c 以调用其 static 函数 */
+#include "foc.c"
+
+#include "sim_legacy_pwm.h"
+#include "sim_periph.h"
+#include "sim_test.h"
+#include <math.h>
+
+#define TEST_N 20000
+#define TEST_VDC 12.0f
+#define TEST_PERIOD 4250
+
+static TIM_HandleTypeDef htim;
+static FOC_Instance foc;
+static uint32_t rand_state = 0x5005;
+
+static double Uniform(double lo, double hi) {
+  uint32_t x = rand_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  rand_state = x;
+  return lo + (hi - lo) * (double)x / 4294967296.0;
+}
+
+/**
+ * @brief 按调制方式输出 αβ 电压，读回 CCR
+ */
+static void Modulate(FOC_Modulation modulation, double alpha, double beta,
+                     uint32_t ccr[3]) {
+  foc.pwm.modulation = modulation;
+  foc.param.UAlphaBeta.Alpha = (float)alpha;
+  foc.param.UAlphaBeta.Beta = (float)beta;
+  InClarke(&foc.param.UAlphaBeta, &foc.param.Uabc);
+  SetPWM(&foc);
+  ccr[0] = TIM1->CCR1;
+  ccr[1] = TIM1->CCR2;
+  ccr[2] = TIM1->CCR3;
+}
+
+/**
+ * @brief 扇区法七段式 SVPWM：两个相邻有效矢量的作用时间 T1、T2，
+ *        零矢量时间在 000 与 111 之间均分，返回各相高电平时间（计数）
+ */
+static void SectorSVPWM(double alpha, double beta, double high[3]) {
+  /* 有效矢量 V0 ~ V5 依次相差 60°，开关状态 (a, b, c) */
+  static const uint8_t state[6][3] = {{1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+                                      {0, 1, 1}, {0, 0, 1}, {1, 0, 1}};
+  double theta = atan2(beta, alpha);
+  if (theta < 0.0)
+    theta += 2.0 * M_PI;
+  int s = (int)(theta / (M_PI / 3.0)) % 6;
+  double phi = theta - s * (M_PI / 3.0);
+  double m = sqrt(3.0) * hypot(alpha, beta) / TEST_VDC;
+  double t1 = m * sin(M_PI / 3.0 - phi) * TEST_PERIOD;
+  double t2 = m * sin(phi) * TEST_PERIOD;
+  double t0 = TEST_PERIOD - t1 - t2;
+  for (uint8_t p = 0; p < 3; p++)
+    high[p] = 0.5 * t0 + t1 * state[s][p] + t2 * state[(s + 1) % 6][p];
+}
+
+/**
+ * @brief 调用零序注入之前的实现，读回 CCR
+ */
+static void LegacyModulate(void (*set)(FOC_Instance *), uint32_t ccr[3]) {
+  set(&foc);
+  ccr[0] = TIM1->CCR1;
+  ccr[1] = TIM1->CCR2;
+  ccr[2] = TIM1->CCR3;
+}
+
+/**
+ * @brief 线性区内随机电压矢量的幅值与角度
+ */
+static void RandomVector(float mi_max, double *alpha, double *beta) {
+  double mag = Uniform(0.0, 0.999 * mi_max * (2.0 / M_PI) * TEST_VDC);
+  double phi = Uniform(0.0, 2.0 * M_PI);
+  *alpha = mag * cos(phi);
+  *beta = mag * sin(phi);
+}
+
+static uint32_t Diff(double a, double b) { return (uint32_t)ceil(fabs(a - b)); }
+
+/**
+ * @brief SVPWM：与按作用时间计算的扇区法相差不超过 1 个计数（截断）；
+ *        原 SetSVPWM 的 CCR 换算为高电平时间 period - 2 * CCR 后含两倍截断，
+ *        相差不超过 2 个计数
+ */
+static void TestSVPWM(void) {
+  uint32_t max = 0, max_legacy = 0;
+  for (uint32_t i = 0; i < TEST_N; i++) {
+    double alpha, beta, high[3];
+    uint32_t ccr[3], legacy[3];
+    RandomVector(FOC_MI_LINEAR, &alpha, &beta);
+    Modulate(FOC_SVPWM, alpha, beta, ccr);
+    LegacyModulate(Legacy_SetSVPWM, legacy);
+    SectorSVPWM(alpha, beta, high);
+    for (uint8_t p = 0; p < 3; p++) {
+      uint32_t d = Diff(ccr[p], high[p]);
+      max = (d > max) ? d : max;
+      d = Diff(ccr[p], (double)TEST_PERIOD - 2.0 * legacy[p]);
+      max_legacy = (d > max_legacy) ? d : max_legacy;
+    }
+  }
+  Sim_Check(max <= 1, "SVPWM vs sector-based dwell times: max %lu counts",
+            (unsigned long)max);
+  Sim_Check(max_legacy <= 2,
+            "SVPWM vs legacy SetSVPWM (period - 2 * CCR): max %lu counts",
+            (unsigned long)max_legacy);
+}
+
+static void TestSPWM(void) {
+  uint32_t max = 0;
+  for (uint32_t i = 0; i < TEST_N; i++) {
+    double alpha, beta;
+    uint32_t ccr[3];
+    RandomVector(FOC_MI_SPWM, &alpha, &beta);
+    Modulate(FOC_SPWM, alpha, beta, ccr);
+    uint32_t ref[3];
+    LegacyModulate(Legacy_SetSPWM, ref);
+    for (uint8_t p = 0; p < 3; p++) {
+      uint32_t d = Diff(ccr[p], ref[p]);
+      max = (d > max) ? d : max;
+    }
+  }
+  Sim_Check(max <= 1, "SPWM vs legacy FOC_SetSPWM: max %lu counts",
+            (unsigned long)max);
+}
+
+/**
+ * @brief THIPWM：相电压叠加 u0 = -(V / 6) * cos3θ，θ 为 a 相电压的相位
+ */
+static void TestTHIPWM(void) {
+  uint32_t max = 0;
+  for (uint32_t i = 0; i < TEST_N; i++) {
+    double alpha, beta;
+    uint32_t ccr[3];
+    RandomVector(FOC_MI_LINEAR, &alpha, &beta);
+    Modulate(FOC_THIPWM, alpha, beta, ccr);
+    double mag = hypot(alpha, beta), theta = atan2(beta, alpha);
+    double u0 = -mag / 6.0 * cos(3.0 * theta);
+    for (uint8_t p = 0; p < 3; p++) {
+      double u = mag * cos(theta - p * (2.0 * M_PI / 3.0)) + u0;
+      double high = (u / TEST_VDC + 0.5) * TEST_PERIOD;
+      uint32_t d = Diff(ccr[p], high);
+      max = (d > max) ? d : max;
+    }
+  }
+  Sim_Check(max <= 1, "THIPWM vs u + (-V / 6) cos3θ: max %lu counts",
+            (unsigned long)max);
+}
+
+/**
+ * @brief 不连续调制：线电压（相间 CCR 差）与 SVPWM 相同，且每次有一相钳位
+ */
+static void TestDPWM(FOC_Modulation modulation, const char *name) {
+  uint32_t max = 0, unclamped = 0;
+  for (uint32_t i = 0; i < TEST_N; i++) {
+    double alpha, beta;
+    uint32_t sv[3], dp[3];
+    RandomVector(FOC_MI_LINEAR, &alpha, &beta);
+    Modulate(FOC_SVPWM, alpha, beta, sv);
+    Modulate(modulation, alpha, beta, dp);
+    for (uint8_t p = 0; p < 3; p++) {
+      uint8_t q = (p + 1) % 3;
+      uint32_t d = Diff((double)dp[p] - dp[q], (double)sv[p] - sv[q]);
+      max = (d > max) ? d : max;
+    }
+    uint8_t clamped = 0;
+    for (uint8_t p = 0; p < 3; p++)
+      clamped |= (dp[p] <= 1 || dp[p] >= TEST_PERIOD - 1);
+    unclamped += !clamped;
+  }
+  Sim_Check(max <= 2 && unclamped == 0,
+            "%s line voltages vs SVPWM: max %lu counts, unclamped %lu/%u",
+            name, (unsigned long)max, (unsigned long)unclamped, TEST_N);
+}
+
+int main(void) {
+  Sim_PeriphReset();
+  htim.Instance = TIM1;
+  htim.Init.Period = TEST_PERIOD - 1;
+  foc.pwm.tim = &htim;
+  foc.pwm.period = TEST_PERIOD;
+  foc.pwm.om_gain = 1.0f;
+  foc.pwm.mi_max = FOC_MI_LINEAR;
+  foc.param.powerVol = TEST_VDC;
+  foc.param.powerVol_half = 0.5f * TEST_VDC;
+  foc.param.powerVol_inv = 1.0f / TEST_VDC;
+
+  TestSPWM();
+  TestSVPWM();
+  TestTHIPWM();
+  TestDPWM(FOC_DPWM0, "DPWM0");
+  TestDPWM(FOC_DPWM1, "DPWM1");
+  TestDPWM(FOC_DPWM2, "DPWM2");
+  TestDPWM(FOC_DPWM3, "DPWM3");
+  return Sim_TestResult();
+}
@@ -0,0 +1,196 @@
+/* MTPA：
+ * 1. 查表扫描：转矩在 ±1.2 倍表范围内扫描，MTPA_Calculate 的 (Id, Iq) 与
+ *    双精度解析解之差不超过线性插值误差界，超出表范围时饱和在电流上限的工作点；
+ * 2. 凸极电机速度模式带载，速度环输出经 MTPA 分配后，
+ *    同样负载下的电流幅值小于 Id = 0 控制 */
+#include "sim_rig.h"
+#include "sim_test.h"
+#include <math.h>
+
+#define TEST_LOAD 0.08 // 负载转矩（N·m）
+#define TEST_SPEED 10.0f
+#define TEST_SWEEP 4001 // 扫描点数
+
+typedef struct {
+  double id, iq, current; // 最后 0.1 s 的平均值（A）
+  double speed;           // 最后 0.1 s 的平均转速（rad/s）
+} MTPA_Result;
+
+/**
+ * @brief 凸极电机参数：Lq / Ld = 3，磁阻转矩明显
+ */
+static void SalientMotor(Sim_Rig_Init_Config_s *config) {
+  Sim_RigDefaults(config);
+  config->motor.Ld = 0.6e-3;
+  config->motor.Lq = 1.8e-3;
+  config->motor.flux = 4e-3;
+  config->motor.cogging = 0.0;
+  config->foc.Ld = (float)config->motor.Ld;
+  config->foc.Lq = (float)config->motor.Lq;
+  config->foc.flux = (float)config->motor.flux;
+  config->foc.current_kp = 2.0f * (float)M_PI * 800.0f * (float)config->motor.Lq;
+}
+
+/**
+ * @brief 双精度解析解：给定电流幅值时的 MTPA 工作点，返回转矩
+ */
+static double AnalyticPoint(const MTPA_Init_Config_s *config, double current,
+                            double *id, double *iq) {
+  double flux = config->flux, delta = (double)config->Lq - config->Ld;
+  *id = (flux - sqrt(flux * flux + 8.0 * delta * delta * current * current)) /
+        (4.0 * delta);
+  *iq = sqrt(current * current - *id * *id);
+  return 1.5 * config->pole_pairs * *iq * (flux - delta * *id);
+}
+
+/**
+ * @brief 双精度解析解：由转矩二分求电流幅值，超出上限时取电流上限的工作点
+ */
+static void AnalyticTorque(const MTPA_Init_Config_s *config, double torque,
+                           double *id, double *iq) {
+  double lo = 0.0, hi = config->current_max, t = fabs(torque);
+  for (uint8_t n = 0; n < 100; n++) {
+    double mid = 0.5 * (lo + hi);
+    if (AnalyticPoint(config, mid, id, iq) < t)
+      lo = mid;
+    else
+      hi = mid;
+  }
+  AnalyticPoint(config, 0.5 * (lo + hi), id, iq);
+  if (torque < 0.0)
+    *iq = -*iq;
+}
+
+/**
+ * @brief 查表扫描：第 k 段上的线性插值误差不超过 h^2 / 8 * max|f''|，
+ *        h 为表的转矩间隔，二阶导数在该段内由解析解差分求得；另加单精度计算的余量
+ */
+static void Sweep(const char *name, MTPA_Init_Config_s *config) {
+  MTPA_Instance *mtpa = MTPA_Register(config);
+  if (mtpa == NULL) {
+    Sim_Check(0, "%s: MTPA register", name);
+    return;
+  }
+  double id, iq, id_end, iq_end;
+  double torque_max = AnalyticPoint(config, config->current_max, &id_end,
+                                    &iq_end);
+  double h = torque_max / (MTPA_TABLE_SIZE - 1);
+  double slack = 1e-5 * config->current_max;
+
+  double bound_id[MTPA_TABLE_SIZE - 1], bound_iq[MTPA_TABLE_SIZE - 1];
+  for (uint16_t k = 0; k < MTPA_TABLE_SIZE - 1; k++) {
+    double d2_id = 0.0, d2_iq = 0.0, e = h / 32.0;
+    for (double t = k * h; t <= (k + 1) * h + 1e-12; t += e) {
+      double c = fmin(fmax(t, e), torque_max - e); // 端点处取单侧差分
+      double id0, iq0, id1, iq1, id2, iq2;
+      AnalyticTorque(config, c - e, &id0, &iq0);
+      AnalyticTorque(config, c, &id1, &iq1);
+      AnalyticTorque(config, c + e, &id2, &iq2);
+      d2_id = fmax(d2_id, fabs(id0 - 2.0 * id1 + id2) / (e * e));
+      d2_iq = fmax(d2_iq, fabs(iq0 - 2.0 * iq1 + iq2) / (e * e));
+    }
+    bound_id[k] = h * h / 8.0 * d2_id + slack;
+    bound_iq[k] = h * h / 8.0 * d2_iq + slack;
+  }
+
+  /* 以误差与该段误差界之比的最大值判断，1 以内为通过 */
+  double ratio_id = 0.0, ratio_iq = 0.0, err_id = 0.0, err_iq = 0.0;
+  double err_sat = 0.0;
+  for (uint32_t n = 0; n < TEST_SWEEP; n++) {
+    double t = torque_max * (-1.2 + 2.4 * n / (TEST_SWEEP - 1));
+    float id_table, iq_table;
+    MTPA_Calculate(mtpa, (float)t, &id_table, &iq_table);
+    if (fabs(t) >= torque_max) {
+      double sign = (t < 0.0) ? -1.0 : 1.0;
+      err_sat = fmax(err_sat, fmax(fabs(id_table - id_end),
+                                   fabs(iq_table - sign * iq_end)));
+      continue;
+    }
+    AnalyticTorque(config, t, &id, &iq);
+    uint16_t k = (uint16_t)(fabs(t) / h);
+    if (k > MTPA_TABLE_SIZE - 2)
+      k = MTPA_TABLE_SIZE - 2;
+    err_id = fmax(err_id, fabs(id_table - id));
+    err_iq = fmax(err_iq, fabs(iq_table - iq));
+    ratio_id = fmax(ratio_id, fabs(id_table - id) / bound_id[k]);
+    ratio_iq = fmax(ratio_iq, fabs(iq_table - iq) / bound_iq[k]);
+  }
+
+  Sim_Check(fabs(mtpa->torque_max - torque_max) < 1e-5 * torque_max,
+            "%s: table range %.5f Nm (analytic %.5f Nm)", name,
+            mtpa->torque_max, torque_max);
+  Sim_Check(ratio_id <= 1.0 && ratio_iq <= 1.0,
+            "%s: max |id - analytic| %.2e A (%.2f of bound), "
+            "max |iq - analytic| %.2e A (%.2f of bound)",
+            name, err_id, ratio_id, err_iq, ratio_iq);
+  Sim_Check(err_sat <= slack,
+            "%s: beyond the table saturates at (%.4f, ±%.4f) A: error %.1e A",
+            name, id_end, iq_end, err_sat);
+}
+
+static void Run(uint8_t use_mtpa, MTPA_Result *result) {
+  Sim_Rig_Init_Config_s config;
+  SalientMotor(&config);
+  Sim_Rig rig;
+  result->current = INFINITY;
+  if (!Sim_RigInit(&rig, &config) || !Sim_RigStart(&rig, 1.2f))
+    return;
+
+  if (use_mtpa) {
+    MTPA_Init_Config_s mtpa_config = {
+      .pole_pairs = config.foc.pole_pairs,
+      .Ld = config.foc.Ld,
+      .Lq = config.foc.Lq,
+      .flux = config.foc.flux,
+      .current_max = config.foc.current_max,
+    };
+    Cascade_SetMTPA(rig.cascade, MTPA_Register(&mtpa_config));
+  }
+  Cascade_SetMode(rig.cascade, CASCADE_SPEED);
+  Cascade_SetSpeed(rig.cascade, TEST_SPEED);
+  rig.plant.load = TEST_LOAD;
+  Sim_RigRun(&rig, 10000);
+
+  double id = 0.0, iq = 0.0, speed = 0.0;
+  for (uint32_t k = 0; k < 2000; k++) {
+    Sim_RigPeriod(&rig);
+    id += rig.plant.id / 2000.0;
+    iq += rig.plant.iq / 2000.0;
+    speed += rig.plant.omega / 2000.0;
+  }
+  result->id = id;
+  result->iq = iq;
+  result->current = hypot(id, iq);
+  result->speed = speed;
+}
+
+int main(void) {
+  MTPA_Init_Config_s salient = {
+    .pole_pairs = 14,
+    .Ld = 0.6e-3f,
+    .Lq = 1.8e-3f,
+    .flux = 4e-3f,
+    .current_max = 2.0f,
+  };
+  Sweep("Lq/Ld 3", &salient);
+  /* 磁链小、电流大：磁阻转矩为主，曲线弯曲最明显 */
+  MTPA_Init_Config_s reluctance = salient;
+  reluctance.flux = 1e-3f;
+  reluctance.current_max = 20.0f;
+  Sweep("reluctance", &reluctance);
+
+  MTPA_Result off, on;
+  Run(0, &off);
+  Run(1, &on);
+
+  Sim_Check(fabs(off.speed - TEST_SPEED) < 0.5 && fabs(on.speed - TEST_SPEED) < 0.5,
+            "speed held at %.0f rad/s under %.2f Nm: %.2f / %.2f rad/s",
+            TEST_SPEED, TEST_LOAD, off.speed, on.speed);
+  Sim_Check(on.id < -0.05,
+            "MTPA id %.3f A, iq %.3f A (id = 0: iq %.3f A)", on.id, on.iq,
+            off.iq);
+  Sim_Check(on.current < off.current,
+            "current magnitude %.3f A with MTPA vs %.3f A with id = 0 (-%.1f %%)",
+            on.current, off.current, (1.0 - on.current / off.current) * 100.0);
+  return Sim_TestResult();
+}
@@ -0,0 +1,216 @@
+/* 静态对象池：
+ * 1. 容量耗尽返回 NULL，Pool_GetStats 的峰值和失败次数；
+ * 2. 归还后复用同一对象并清零，非法指针和重复归还被忽略；
+ * 3. 按 main.c 注册全部实例不调用堆分配：malloc/calloc/realloc 经链接器 --wrap
+ *    重定向到本文件的计数函数（Sim/CMakeLists.txt），与固件 POOL_NO_MALLOC 相同的机制；
+ * 4. 按目标板容量估算对象池总大小，与链接脚本的 _Pool_Budget 比较 */
+#include "bsp_pool.h"
+#include "bsp_uart.h"
+#include "cogging.h"
+#include "hfi.h"
+#include "sim_rig.h"
+#include "sim_test.h"
+#include "smo.h"
+#include "vofa.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_CAPACITY 4
+#define POOL_BUDGET 0x1800 // STM32G431XX_FLASH.ld 中的 _Pool_Budget
+
+/* ---------------- 堆分配计数 ---------------- */
+/* volatile：编译器认为 malloc 不修改用户全局变量，否则会沿用调用前的值 */
+static volatile uint32_t heap_calls;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+  heap_calls++;
+  return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t n, size_t size) {
+  heap_calls++;
+  return __real_calloc(n, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+  heap_calls++;
+  return __real_realloc(ptr, size);
+}
+
+/* ---------------- 分配与归还 ---------------- */
+typedef struct {
+  uint32_t word[3];
+} Test_Object;
+
+POOL_DEFINE(test_pool, Test_Object, TEST_CAPACITY);
+
+static void AllocFree(void) {
+  Test_Object *object[TEST_CAPACITY];
+  uint8_t ok = 1;
+  for (uint8_t i = 0; i < TEST_CAPACITY; i++) {
+    object[i] = (Test_Object *)Pool_Alloc(&test_pool);
+    ok = ok && object[i] == &test_pool_storage[i];
+    if (object[i] != NULL)
+      memset(object[i], 0xA5, sizeof(Test_Object));
+  }
+  Test_Object *extra = (Test_Object *)Pool_Alloc(&test_pool);
+  Sim_Check(ok && extra == NULL && test_pool.fail == 1,
+            "exhaust: %u objects in order, then NULL (fail %u)",
+            TEST_CAPACITY, test_pool.fail);
+
+  Pool_Stats stats;
+  Pool_GetStats(&stats);
+  Sim_Check(test_pool.peak == TEST_CAPACITY && stats.fail >= 1 &&
+                stats.bytes_peak >= TEST_CAPACITY * sizeof(Test_Object),
+            "stats: high-water %u of %u, total peak %lu bytes, fail %u",
+            test_pool.peak, test_pool.capacity,
+            (unsigned long)stats.bytes_peak, stats.fail);
+
+  /* 归还第 1 个对象后再分配：得到同一对象且已清零，峰值不变 */
+  Pool_Free(&test_pool, object[1]);
+  Test_Object *again = (Test_Object *)Pool_Alloc(&test_pool);
+  Sim_Check(again == object[1] && again->word[0] == 0 &&
+                again->word[2] == 0 && test_pool.used == TEST_CAPACITY &&
+                test_pool.peak == TEST_CAPACITY,
+            "free + alloc reuses slot 1, zeroed, used %u, peak %u",
+            test_pool.used, test_pool.peak);
+
+  /* 非对象起始地址、池外指针、重复归还均不改变占用 */
+  Test_Object outside;
+  Pool_Free(&test_pool, (uint8_t *)object[2] + 4);
+  Pool_Free(&test_pool, &outside);
+  Pool_Free(&test_pool, object[3]);
+  Pool_Free(&test_pool, object[3]);
+  Sim_Check(test_pool.used == TEST_CAPACITY - 1 &&
+                (test_pool.mask & (1UL << 2)) &&
+                !(test_pool.mask & (1UL << 3)),
+            "invalid and double frees ignored: used %u, mask 0x%lX",
+            test_pool.used, (unsigned long)test_pool.mask);
+}
+
+/* ---------------- 注册全部实例 ---------------- */
+/**
+ * @brief 注册 Core/Src/main.c 中的全部实例：FOC、串级控制、轨迹规划、AS5047P
+ *        （Sim_RigInit）、VOFA、观测器、HFI、齿槽补偿，另启动一次编码器线性化分配校正表
+ */
+static uint8_t RegisterAll(Sim_Rig *rig, UART_HandleTypeDef *huart) {
+  Sim_Rig_Init_Config_s config;
+  Sim_RigDefaults(&config);
+  if (!Sim_RigInit(rig, &config))
+    return 0;
+  /* Sim_RigInit 复位寄存器替身，串口在其后注册 */
+  if (VOFA_Register(huart) == NULL)
+    return 0;
+
+  SMO_Init_Config_s smo_config = {
+    .Rs = 2.0f,
+    .Ls = 1.1e-3f,
+    .Ts = rig->foc->pwm.Ts,
+    .k_slide = 10.0f,
+    .boundary = 2.5f,
+    .lpf_cutoff = 2000.0f,
+    .pll_bandwidth = 300.0f,
+    .speed_min = 200.0f,
+  };
+  SMO_Instance *smo = SMO_Register(&smo_config);
+  HFI_Init_Config_s hfi_config = {
+    .Ts = rig->foc->pwm.Ts,
+    .Ld = 1e-3f,
+    .Lq = 1.2e-3f,
+    .voltage = 1.0f,
+    .pll_bandwidth = 200.0f,
+    .speed_low = 300.0f,
+    .speed_high = 600.0f,
+    .polarity_current = 1.0f,
+    .converge_cycles = 2000,
+    .polarity_cycles = 400,
+    .demod_delay = 1,
+  };
+  HFI_Instance *hfi = HFI_Register(&hfi_config);
+  Cogging_Init_Config_s cogging_config = {
+    .iq_max = 0.5f,
+    .gain = 0.05f,
+    .mean_alpha = 0.001f,
+  };
+  Cogging_Instance *cogging = Cogging_Register(&cogging_config);
+  if (smo == NULL || hfi == NULL || cogging == NULL)
+    return 0;
+  FOC_SetObserver(rig->foc, smo);
+  FOC_SetHFI(rig->foc, hfi);
+  Cascade_SetCogging(rig->cascade, cogging);
+
+  AS5047P_StartLinearize(rig->as5047p, 1);
+  return rig->as5047p->lut != NULL;
+}
+
+/* 目标板上的对象池容量，即各头文件中的默认值（主机构建在 Sim/CMakeLists.txt 中放大） */
+static const struct {
+  const char *name;
+  uint8_t capacity;
+} target_capacity[] = {
+    {"foc_pool", 1},         {"cascade_pool", 1},
+    {"traj_pool", 1},        {"smo_pool", 1},
+    {"hfi_pool", 1},         {"cogging_pool", 1},
+    {"filter_pool", 4},      {"vofa_pool", 1},
+    {"as5047p_pool", 1},     {"as5047p_lut_pool", 1},
+    {"uart_pool", DEVICE_UART_CNT},
+};
+
+/**
+ * @brief 按目标板容量累计已使用的固件对象池。主机为 64 位指针，对象不小于
+ *        目标板上的大小，结果为上界
+ */
+static void Footprint(void) {
+  uint32_t total = 0, unknown = 0;
+  for (Pool_Instance *pool = Pool_List(); pool != NULL; pool = pool->next) {
+    if (pool == &test_pool)
+      continue;
+    uint32_t n = sizeof(target_capacity) / sizeof(target_capacity[0]);
+    int32_t found = -1;
+    for (uint32_t i = 0; i < n; i++)
+      if (strcmp(pool->name, target_capacity[i].name) == 0)
+        found = (int32_t)i;
+    if (found < 0) {
+      Sim_Note("%-17s not in the target capacity table", pool->name);
+      unknown++;
+      continue;
+    }
+    uint32_t bytes = (uint32_t)pool->size * target_capacity[found].capacity;
+    Sim_Note("%-17s %5u B x %u = %5lu B (host peak %u)", pool->name,
+             pool->size, target_capacity[found].capacity,
+             (unsigned long)bytes, pool->peak);
+    total += bytes;
+  }
+  Sim_Check(unknown == 0 && total <= POOL_BUDGET,
+            "pool footprint at target capacity: %lu of %u bytes (_Pool_Budget)",
+            (unsigned long)total, POOL_BUDGET);
+}
+
+int main(void) {
+  AllocFree();
+
+  /* 计数函数本身须生效：本文件直接调用 malloc 应被计入 */
+  heap_calls = 0;
+  void *volatile block = malloc(16); // volatile：避免编译器消去成对的 malloc/free
+  free(block);
+  Sim_Check(heap_calls == 1, "malloc hook active: %lu call(s) seen",
+            (unsigned long)heap_calls);
+
+  static Sim_Rig rig;
+  static UART_HandleTypeDef huart;
+  static DMA_HandleTypeDef hdma_rx;
+  hdma_rx.Instance = DMA1_Channel2;
+  huart.hdmarx = &hdma_rx;
+  heap_calls = 0;
+  uint8_t ok = RegisterAll(&rig, &huart);
+  Sim_Check(ok && heap_calls == 0,
+            "register the full object graph: %lu heap call(s)",
+            (unsigned long)heap_calls);
+
+  Footprint();
+  return Sim_TestResult();
+}
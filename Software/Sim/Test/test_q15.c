@@ -0,0 +1,324 @@
+/* Q15 电压合成：
+ * 1. arm_sin_q15/arm_cos_q15（Sim/Src/sim_dsp.c 移植的 CMSIS 查表插值）与黄金值、
+ *    全定义域校验和逐位一致；
+ * 2. 定点路径 SetVoltage_q15 写入的 CCR 与黄金向量逐位一致。黄金值由 CMSIS
+ *    算法和本文件定点流水线的独立整数实现离线生成，入口的浮点乘法按 IEEE 单精度
+ *    舍入，覆盖全部调制方式、死区补偿、过调制回落和 Q15/CCR 饱和；
+ * 3. 与浮点路径的 CCR 差，以及每次调用的主机耗时。
+ * 内核为 foc.c 中的 static 函数，直接包含源文件 */
+#define FOC_FIXED_POINT 1
+#include "foc.c"
+
+#include "sim_periph.h"
+#include "sim_test.h"
+#include <math.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define TEST_N 20000
+#define TEST_VDC 12.0f
+#define TEST_PERIOD 4250
+
+/* 黄金向量使用的母线电压，1 / 16 为精确值 */
+#define GOLDEN_VDC 16.0f
+#define GOLDEN_DTC_DUTY_Q15 655 // 约 2% 的死区补偿占空比
+#define GOLDEN_DTC_BAND_INV 0.5f
+
+typedef struct {
+  q15_t x;
+  q15_t sin;
+  q15_t cos;
+} GoldenSinCos;
+
+/* 取样覆盖表格节点、节点间插值、象限边界和定义域两端 */
+static const GoldenSinCos golden_sincos[] = {
+    {0x0000, 0, 32766},       {0x0001, 6, 32764},
+    {0x003F, 394, 32764},     {0x0040, 402, 32766},
+    {0x0064, 626, 32760},     {0x1000, 23170, 23170},
+    {0x2000, 32766, 0},       {0x2001, 32764, -8},
+    {0x3FFF, 6, -32768},      {0x4000, 0, -32768},
+    {0x5555, -28378, -16386}, {0x6000, -32768, 0},
+    {0x7FC0, -402, 32766},    {0x7FFF, -8, 32764},
+};
+
+/* x = 0..32767 依次累积 h = h * 31 + (uint16_t)y */
+#define GOLDEN_SIN_HASH 0xD160003EU
+#define GOLDEN_COS_HASH 0xE2E8003EU
+
+typedef struct {
+  FOC_Modulation modulation;
+  float mi;
+  dq_Typedef Udq; // V
+  float theta;    // 电角度（rad）
+  abc_Typedef Iabc;
+  uint8_t dtc;
+  uint32_t ccr[3];
+} GoldenCCR;
+
+static const GoldenCCR golden_ccr[] = {
+    {FOC_SPWM, 0.5f, {.d = 3.25f, .q = 1.5f}, 0.4375f,
+     {0.375f, -1.25f, 0.875f}, 0, {2738, 2447, 1189}},
+    {FOC_SPWM, 0.5f, {.d = -2.0f, .q = 4.75f}, 2.6875f,
+     {1.5f, 0.25f, -1.75f}, 1, {2112, 989, 3272}},
+    {FOC_SPWM, 0.5f, {.d = 0.5f, .q = -5.0f}, 4.125f,
+     {-0.625f, 2.5f, -1.875f}, 0, {945, 3256, 2172}},
+    {FOC_SPWM, 0.5f, {.d = -4.25f, .q = -3.5f}, 5.9375f,
+     {0.0625f, -0.3125f, 0.25f}, 1, {750, 2374, 3250}},
+    {FOC_SVPWM, 0.5f, {.d = 3.25f, .q = 1.5f}, 0.4375f,
+     {0.375f, -1.25f, 0.875f}, 0, {2899, 2608, 1350}},
+    {FOC_SVPWM, 0.5f, {.d = -2.0f, .q = 4.75f}, 2.6875f,
+     {1.5f, 0.25f, -1.75f}, 1, {2074, 951, 3234}},
+    {FOC_SVPWM, 0.5f, {.d = 0.5f, .q = -5.0f}, 4.125f,
+     {-0.625f, 2.5f, -1.875f}, 0, {969, 3280, 2196}},
+    {FOC_SVPWM, 0.5f, {.d = -4.25f, .q = -3.5f}, 5.9375f,
+     {0.0625f, -0.3125f, 0.25f}, 1, {881, 2505, 3381}},
+    {FOC_THIPWM, 0.5f, {.d = 3.25f, .q = 1.5f}, 0.4375f,
+     {0.375f, -1.25f, 0.875f}, 0, {2899, 2608, 1350}},
+    {FOC_THIPWM, 0.5f, {.d = -2.0f, .q = 4.75f}, 2.6875f,
+     {1.5f, 0.25f, -1.75f}, 1, {2074, 951, 3234}},
+    {FOC_THIPWM, 0.5f, {.d = 0.5f, .q = -5.0f}, 4.125f,
+     {-0.625f, 2.5f, -1.875f}, 0, {969, 3280, 2196}},
+    {FOC_THIPWM, 0.5f, {.d = -4.25f, .q = -3.5f}, 5.9375f,
+     {0.0625f, -0.3125f, 0.25f}, 1, {881, 2505, 3381}},
+    {FOC_DPWM0, 0.5f, {.d = 3.25f, .q = 1.5f}, 0.4375f,
+     {0.375f, -1.25f, 0.875f}, 0, {1549, 1258, 0}},
+    {FOC_DPWM0, 0.5f, {.d = -2.0f, .q = 4.75f}, 2.6875f,
+     {1.5f, 0.25f, -1.75f}, 1, {1133, 10, 2293}},
+    {FOC_DPWM0, 0.5f, {.d = 0.5f, .q = -5.0f}, 4.125f,
+     {-0.625f, 2.5f, -1.875f}, 0, {0, 2310, 1227}},
+    {FOC_DPWM0, 0.5f, {.d = -4.25f, .q = -3.5f}, 5.9375f,
+     {0.0625f, -0.3125f, 0.25f}, 1, {1760, 3384, 4250}},
+    {FOC_DPWM1, 0.5f, {.d = 3.25f, .q = 1.5f}, 0.4375f,
+     {0.375f, -1.25f, 0.875f}, 0, {1549, 1258, 0}},
+    {FOC_DPWM1, 0.5f, {.d = -2.0f, .q = 4.75f}, 2.6875f,
+     {1.5f, 0.25f, -1.75f}, 1, {3015, 1892, 4175}},
+    {FOC_DPWM1, 0.5f, {.d = 0.5f, .q = -5.0f}, 4.125f,
+     {-0.625f, 2.5f, -1.875f}, 0, {0, 2310, 1227}},
+    {FOC_DPWM1, 0.5f, {.d = -4.25f, .q = -3.5f}, 5.9375f,
+     {0.0625f, -0.3125f, 0.25f}, 1, {2, 1626, 2502}},
+    {FOC_DPWM2, 0.5f, {.d = 3.25f, .q = 1.5f}, 0.4375f,
+     {0.375f, -1.25f, 0.875f}, 0, {4250, 3959, 2700}},
+    {FOC_DPWM2, 0.5f, {.d = -2.0f, .q = 4.75f}, 2.6875f,
+     {1.5f, 0.25f, -1.75f}, 1, {3015, 1892, 4175}},
+    {FOC_DPWM2, 0.5f, {.d = 0.5f, .q = -5.0f}, 4.125f,
+     {-0.625f, 2.5f, -1.875f}, 0, {1939, 4250, 3166}},
+    {FOC_DPWM2, 0.5f, {.d = -4.25f, .q = -3.5f}, 5.9375f,
+     {0.0625f, -0.3125f, 0.25f}, 1, {2, 1626, 2502}},
+    {FOC_DPWM3, 0.5f, {.d = 3.25f, .q = 1.5f}, 0.4375f,
+     {0.375f, -1.25f, 0.875f}, 0, {4250, 3959, 2700}},
+    {FOC_DPWM3, 0.5f, {.d = -2.0f, .q = 4.75f}, 2.6875f,
+     {1.5f, 0.25f, -1.75f}, 1, {1133, 10, 2293}},
+    {FOC_DPWM3, 0.5f, {.d = 0.5f, .q = -5.0f}, 4.125f,
+     {-0.625f, 2.5f, -1.875f}, 0, {1939, 4250, 3166}},
+    {FOC_DPWM3, 0.5f, {.d = -4.25f, .q = -3.5f}, 5.9375f,
+     {0.0625f, -0.3125f, 0.25f}, 1, {1760, 3384, 4250}},
+    {FOC_DPWM1, 0.95f, {.d = 6.5f, .q = 5.0f}, 1.0f,
+     {0.5f, 0.5f, -1.0f}, 0, {1847, 4004, 245}},
+    {FOC_SPWM, 0.5f, {.d = 20.0f, .q = -20.0f}, 3.0f,
+     {0.5f, 0.5f, -1.0f}, 1, {0, 4250, 205}},
+    {FOC_DPWM0, 0.5f, {.d = 0.0f, .q = 0.0f}, 0.0f,
+     {4.0f, -4.0f, 0.0f}, 1, {4250, 4165, 4250}},
+};
+
+static TIM_HandleTypeDef htim;
+static FOC_Instance foc;
+static uint32_t rand_state = 0x2002;
+
+static float Uniform(float lo, float hi) {
+  uint32_t x = rand_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  rand_state = x;
+  return lo + (hi - lo) * (float)(x >> 8) * (1.0f / 16777216.0f);
+}
+
+static double NowNs(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * @brief 浮点路径：与 SetVoltage 的浮点分支相同
+ */
+static void VoltageFloat(dq_Typedef *Udq, float theta, uint32_t ccr[3]) {
+  SinCos_Typedef sc = {arm_sin_f32(theta), arm_cos_f32(theta)};
+  foc.param.Udq = *Udq;
+  InPark(&foc.param.Udq, &foc.param.UAlphaBeta, &sc);
+  InClarke(&foc.param.UAlphaBeta, &foc.param.Uabc);
+  SetPWM(&foc);
+  ccr[0] = TIM1->CCR1;
+  ccr[1] = TIM1->CCR2;
+  ccr[2] = TIM1->CCR3;
+}
+
+/**
+ * @brief 定点路径：SetVoltage 的定点分支
+ */
+static void VoltageQ15(dq_Typedef *Udq, float theta, uint32_t ccr[3]) {
+  foc.param.Udq = *Udq;
+  foc.param.angle_electrical = theta;
+  SetVoltage_q15(&foc);
+  ccr[0] = TIM1->CCR1;
+  ccr[1] = TIM1->CCR2;
+  ccr[2] = TIM1->CCR3;
+}
+
+/**
+ * @brief 线性区内随机 Udq、电角度，统计两条路径的 CCR 差
+ * @param max_tol 允许的最大差值（计数）
+ * @param flip_tol 不连续调制在钳位切换边界上判断相反的比例上限
+ */
+static void Compare(FOC_Modulation modulation, const char *name,
+                    uint32_t max_tol, double flip_tol) {
+  static dq_Typedef in_dq[TEST_N];
+  static float in_theta[TEST_N];
+  static uint32_t out_f[TEST_N][3], out_q[TEST_N][3];
+
+  foc.pwm.modulation = modulation;
+  float mi_max = (modulation == FOC_SPWM) ? FOC_MI_SPWM : FOC_MI_LINEAR;
+  float v_max = 0.999f * mi_max * (2.0f / PI) * TEST_VDC;
+  for (uint32_t i = 0; i < TEST_N; i++) {
+    float mag = Uniform(0.0f, v_max), phi = Uniform(0.0f, 2.0f * PI);
+    in_dq[i].d = mag * cosf(phi);
+    in_dq[i].q = mag * sinf(phi);
+    in_theta[i] = Uniform(0.0f, 2.0f * PI);
+  }
+
+  /* 计时：同一组输入各跑一遍，取单次调用的平均耗时。主机上 SMLAD 等内建函数
+   * 为软件模拟，耗时不代表目标板 */
+  double t0 = NowNs();
+  for (uint32_t i = 0; i < TEST_N; i++)
+    VoltageFloat(&in_dq[i], in_theta[i], out_f[i]);
+  double t_float = (NowNs() - t0) / TEST_N;
+  t0 = NowNs();
+  for (uint32_t i = 0; i < TEST_N; i++)
+    VoltageQ15(&in_dq[i], in_theta[i], out_q[i]);
+  double t_q15 = (NowNs() - t0) / TEST_N;
+
+  uint32_t max = 0, flips = 0;
+  double sum = 0.0;
+  for (uint32_t i = 0; i < TEST_N; i++) {
+    uint32_t worst = 0;
+    for (uint8_t p = 0; p < 3; p++) {
+      uint32_t diff = (out_f[i][p] > out_q[i][p]) ? out_f[i][p] - out_q[i][p]
+                                                  : out_q[i][p] - out_f[i][p];
+      worst = (diff > worst) ? diff : worst;
+      sum += diff;
+    }
+    /* 不连续调制在钳位方向切换处，两条路径的舍入可能选择不同的钳位方向 */
+    if (worst > max_tol) {
+      flips++;
+      continue;
+    }
+    max = (worst > max) ? worst : max;
+  }
+  Sim_Check(max <= max_tol && flips <= flip_tol * TEST_N,
+            "%-6s CCR q15 vs float: max %lu counts, mean %.3f, "
+            "boundary flips %lu/%u",
+            name, (unsigned long)max, sum / (3.0 * TEST_N),
+            (unsigned long)flips, TEST_N);
+  Sim_Note("%-6s host time per call: float %.1f ns, q15 %.1f ns", name,
+           t_float, t_q15);
+}
+
+/**
+ * @brief arm_sin_q15/arm_cos_q15 与黄金值、全定义域校验和比较，并给出与 libm 的误差
+ */
+static void CheckSinCos(void) {
+  uint32_t n = sizeof(golden_sincos) / sizeof(golden_sincos[0]), bad = 0;
+  for (uint32_t i = 0; i < n; i++) {
+    const GoldenSinCos *g = &golden_sincos[i];
+    q15_t s = arm_sin_q15(g->x), c = arm_cos_q15(g->x);
+    if (s != g->sin || c != g->cos) {
+      Sim_Note("x 0x%04X: sin %d (golden %d), cos %d (golden %d)", g->x, s,
+               g->sin, c, g->cos);
+      bad++;
+    }
+  }
+  Sim_Check(bad == 0, "sin/cos q15 golden samples: %lu mismatches of %lu",
+            (unsigned long)bad, (unsigned long)n);
+
+  uint32_t hs = 0, hc = 0;
+  int32_t err = 0;
+  for (int32_t x = 0; x < 32768; x++) {
+    q15_t s = arm_sin_q15((q15_t)x), c = arm_cos_q15((q15_t)x);
+    hs = hs * 31U + (uint16_t)s;
+    hc = hc * 31U + (uint16_t)c;
+    double ref = 32768.0 * sin(x * (2.0 * M_PI / 32768.0));
+    int32_t e = abs(s - (int32_t)lround(ref));
+    err = (e > err) ? e : err;
+  }
+  Sim_Check(hs == GOLDEN_SIN_HASH && hc == GOLDEN_COS_HASH,
+            "sin/cos q15 over [0, 32768): hash 0x%08lX/0x%08lX "
+            "(golden 0x%08lX/0x%08lX)",
+            (unsigned long)hs, (unsigned long)hc,
+            (unsigned long)GOLDEN_SIN_HASH, (unsigned long)GOLDEN_COS_HASH);
+  /* 512 点表线性插值误差约 0.6 LSB，另有表值舍入，插值中两次移位截断各至多 2 LSB */
+  Sim_Check(err <= 6, "sin q15 vs libm: max %ld LSB", (long)err);
+}
+
+/**
+ * @brief SetVoltage_q15 写入的 CCR 与黄金向量逐位比较
+ */
+static void CheckGoldenCCR(void) {
+  foc.param.powerVol = GOLDEN_VDC;
+  foc.param.powerVol_half = 0.5f * GOLDEN_VDC;
+  foc.param.powerVol_inv = 1.0f / GOLDEN_VDC;
+  foc.dtc.duty_q15 = GOLDEN_DTC_DUTY_Q15;
+  foc.dtc.band_inv = GOLDEN_DTC_BAND_INV;
+
+  uint32_t n = sizeof(golden_ccr) / sizeof(golden_ccr[0]), bad = 0;
+  for (uint32_t i = 0; i < n; i++) {
+    const GoldenCCR *g = &golden_ccr[i];
+    foc.pwm.modulation = g->modulation;
+    foc.pwm.mi = g->mi;
+    foc.dtc.enable = g->dtc;
+    foc.param.Iabc = g->Iabc;
+    foc.param.Udq = g->Udq;
+    foc.param.angle_electrical = g->theta;
+    SetVoltage_q15(&foc);
+    uint32_t ccr[3] = {TIM1->CCR1, TIM1->CCR2, TIM1->CCR3};
+    if (ccr[0] != g->ccr[0] || ccr[1] != g->ccr[1] || ccr[2] != g->ccr[2]) {
+      Sim_Note("case %lu: CCR %lu %lu %lu, golden %lu %lu %lu",
+               (unsigned long)i, (unsigned long)ccr[0], (unsigned long)ccr[1],
+               (unsigned long)ccr[2], (unsigned long)g->ccr[0],
+               (unsigned long)g->ccr[1], (unsigned long)g->ccr[2]);
+      bad++;
+    }
+  }
+  Sim_Check(bad == 0, "CCR q15 golden vectors: %lu mismatches of %lu",
+            (unsigned long)bad, (unsigned long)n);
+
+  foc.dtc.enable = 0;
+  foc.pwm.mi = 0.0f;
+}
+
+int main(void) {
+  Sim_PeriphReset();
+  htim.Instance = TIM1;
+  htim.Init.Period = TEST_PERIOD - 1;
+  foc.pwm.tim = &htim;
+  foc.pwm.period = TEST_PERIOD;
+  foc.pwm.om_gain = 1.0f;
+  foc.pwm.mi_max = FOC_MI_LINEAR;
+
+  CheckSinCos();
+  CheckGoldenCCR();
+
+  foc.param.powerVol = TEST_VDC;
+  foc.param.powerVol_half = 0.5f * TEST_VDC;
+  foc.param.powerVol_inv = 1.0f / TEST_VDC;
+
+  /* Q15 电压分辨率为 Vdc / 32768，约 0.13 个计数；sin/cos 的 Q15 量化和两条路径
+   * 各自的截断再各带来不到 1 个计数 */
+  Compare(FOC_SPWM, "SPWM", 2, 0.0);
+  Compare(FOC_SVPWM, "SVPWM", 2, 0.0);
+  Compare(FOC_DPWM0, "DPWM0", 2, 0.002);
+  Compare(FOC_DPWM1, "DPWM1", 2, 0.002);
+  Compare(FOC_DPWM2, "DPWM2", 2, 0.002);
+  Compare(FOC_DPWM3, "DPWM3", 2, 0.002);
+  Sim_Note("THIPWM is not compared: the q15 path runs it as SVPWM");
+  return Sim_TestResult();
+}
@@ -0,0 +1,81 @@
+/* 多速率调度：速度环、位置环按分频和相位执行，二者永不在同一 PWM 周期执行 */
+#include "sim_rig.h"
+#include "sim_test.h"
+
+#define TEST_N 2000 // 检查的 PWM 周期数
+
+/* 未执行的环保持探针值，执行后 RateRecord 写入实际耗时 */
+#define TEST_PROBE UINT32_MAX
+
+int main(void) {
+  Sim_Rig_Init_Config_s config;
+  Sim_RigDefaults(&config);
+  Sim_Rig rig;
+  if (!Sim_RigInit(&rig, &config) || !Sim_RigStart(&rig, 1.2f)) {
+    Sim_Check(0, "rig start");
+    return Sim_TestResult();
+  }
+  Cascade_Instance *cascade = rig.cascade;
+  Cascade_SetMode(cascade, CASCADE_POSITION);
+  Cascade_SetPosition(cascade, cascade->pos + 1.0f);
+
+  /* 电流零偏校准期间已调用过 Cascade_Update，按每周期开始时的分频计数判断 */
+  uint16_t speed_div = config.cascade.speed_div;
+  uint16_t pos_div = config.cascade.pos_div;
+  uint32_t speed_runs = 0, pos_runs = 0, current_runs = 0;
+  uint32_t speed_wrong = 0, pos_wrong = 0, overlap = 0;
+  uint32_t speed_last = UINT32_MAX, pos_last = UINT32_MAX;
+  for (uint32_t k = 0; k < TEST_N; k++) {
+    cascade->loop_current.cycles_last = TEST_PROBE;
+    cascade->loop_speed.cycles_last = TEST_PROBE;
+    cascade->loop_position.cycles_last = TEST_PROBE;
+    uint16_t speed_count = cascade->loop_speed.count;
+    uint16_t pos_count = cascade->loop_position.count;
+    Sim_RigPeriod(&rig);
+    uint8_t current = cascade->loop_current.cycles_last != TEST_PROBE;
+    uint8_t speed = cascade->loop_speed.cycles_last != TEST_PROBE;
+    uint8_t pos = cascade->loop_position.cycles_last != TEST_PROBE;
+    current_runs += current;
+    speed_runs += speed;
+    pos_runs += pos;
+    speed_wrong += speed != (speed_count == config.cascade.speed_phase);
+    pos_wrong += pos != (pos_count == config.cascade.pos_phase);
+    /* 两次执行间隔为分频系数 */
+    if (speed) {
+      speed_wrong += speed_last != UINT32_MAX && k - speed_last != speed_div;
+      speed_last = k;
+    }
+    if (pos) {
+      pos_wrong += pos_last != UINT32_MAX && k - pos_last != pos_div;
+      pos_last = k;
+    }
+    overlap += speed && pos;
+  }
+
+  Sim_Check(current_runs == TEST_N, "current loop ran %lu/%u periods",
+            (unsigned long)current_runs, TEST_N);
+  Sim_Check(speed_runs == TEST_N / speed_div && speed_wrong == 0,
+            "speed loop ran %lu times, every %u periods at phase %u",
+            (unsigned long)speed_runs, speed_div, config.cascade.speed_phase);
+  Sim_Check(pos_runs == TEST_N / pos_div && pos_wrong == 0,
+            "position loop ran %lu times, every %u periods at phase %u",
+            (unsigned long)pos_runs, pos_div, config.cascade.pos_phase);
+  Sim_Check(overlap == 0, "speed and position loops never share a period");
+
+  /* 执行预算报告：频率由分频得出 */
+  Cascade_Report report;
+  Cascade_GetReport(cascade, &report);
+  Sim_Check(report.rate_current > 19999.0f && report.rate_current < 20001.0f &&
+                report.rate_speed > 1999.0f && report.rate_speed < 2001.0f &&
+                report.rate_position > 999.0f && report.rate_position < 1001.0f,
+            "report rates %.0f / %.0f / %.0f Hz", report.rate_current,
+            report.rate_speed, report.rate_position);
+
+  /* 相位对 gcd(speed_div, pos_div) 同余的配置会让两环重叠，注册时拒绝 */
+  Cascade_Init_Config_s bad = config.cascade;
+  bad.foc = rig.foc;
+  bad.pos_phase = 10;
+  Sim_Check(Cascade_Register(&bad) == NULL,
+            "overlapping phases (speed 0/10, position 10/20) rejected");
+  return Sim_TestResult();
+}
@@ -0,0 +1,101 @@
+/* 滑模观测器：编码器闭环下各转速的角度估计误差，以及切换为观测器角度后
+ * 速度环由观测器测速维持转速（编码器冻结） */
+#include "sim_rig.h"
+#include "sim_test.h"
+#include <math.h>
+
+#define TEST_N 4000 // 每个转速统计的 PWM 周期数（0.2 s）
+
+/**
+ * @brief 建立带滑模观测器的仿真台
+ */
+static uint8_t Setup(Sim_Rig *rig) {
+  Sim_Rig_Init_Config_s config;
+  Sim_RigDefaults(&config);
+  if (!Sim_RigInit(rig, &config))
+    return 0;
+  SMO_Init_Config_s smo_config = {
+    .Rs = (float)config.motor.R,
+    .Ls = (float)config.motor.Lq,
+    .Ts = rig->foc->pwm.Ts,
+    .k_slide = 10.0f,
+    .boundary = 0.5f,
+    .lpf_cutoff = 2000.0f,
+    .pll_bandwidth = 300.0f,
+    .speed_min = 200.0f,
+  };
+  SMO_Instance *smo = SMO_Register(&smo_config);
+  if (smo == NULL)
+    return 0;
+  FOC_SetObserver(rig->foc, smo);
+  return Sim_RigStart(rig, 1.2f);
+}
+
+static double Wrap(double x) {
+  x = fmod(x + M_PI, 2.0 * M_PI);
+  return ((x < 0.0) ? x + 2.0 * M_PI : x) - M_PI;
+}
+
+/**
+ * @brief 观测器角度（已外推到下一采样时刻）与下一周期编码器电角度之差
+ */
+static void AngleError(Sim_Rig *rig, double *mean, double *rms) {
+  SMO_Instance *smo = rig->foc->observer;
+  double sum = 0.0, sq = 0.0, predicted = smo->angle;
+  for (uint32_t k = 0; k < TEST_N; k++) {
+    Sim_RigPeriod(rig);
+    double err = Wrap(predicted - rig->ele_angle);
+    sum += err;
+    sq += err * err;
+    predicted = smo->angle;
+  }
+  *mean = sum / TEST_N;
+  *rms = sqrt(sq / TEST_N);
+}
+
+/* 编码器失效：机械角度保持不变，电流环角度由观测器给出 */
+static void FrozenEncoderIsr(Sim_Rig *rig) {
+  Cascade_SetCurrent(rig->cascade, 0.0f, 0.0f);
+  Cascade_Update(rig->cascade, rig->mec_angle, 0.0f);
+}
+
+int main(void) {
+  Sim_Rig rig;
+  if (!Setup(&rig)) {
+    Sim_Check(0, "rig start");
+    return Sim_TestResult();
+  }
+  Cascade_SetMode(rig.cascade, CASCADE_SPEED);
+  rig.plant.load = 0.01;
+
+  /* 电角速度 = 14 * 机械角速度；低于 speed_min（200 rad/s）时估计无效 */
+  const float speed[] = {20.0f, 40.0f, 60.0f};
+  for (uint8_t i = 0; i < 3; i++) {
+    Cascade_SetSpeed(rig.cascade, speed[i]);
+    Sim_RigRun(&rig, 6000);
+    double mean, rms;
+    AngleError(&rig, &mean, &rms);
+    Sim_Check(fabs(mean) < 0.1 && rms < 0.15,
+              "%2.0f rad/s (%3.0f rad/s electrical): angle error mean %+.3f "
+              "rad, rms %.3f rad",
+              speed[i], speed[i] * 14.0f, mean, rms);
+  }
+
+  /* 切换为观测器角度，冻结编码器：速度环须用观测器测速 */
+  Cascade_SetSpeed(rig.cascade, 40.0f);
+  Sim_RigRun(&rig, 6000);
+  FOC_SetAngleSource(rig.foc, FOC_ANGLE_OBSERVER);
+  rig.isr = FrozenEncoderIsr;
+  Sim_RigRun(&rig, 6000);
+  double omega = 0.0, measured = 0.0;
+  for (uint32_t k = 0; k < TEST_N; k++) {
+    Sim_RigPeriod(&rig);
+    omega += rig.plant.omega / TEST_N;
+    measured += rig.cascade->speed / TEST_N;
+  }
+  Sim_Check(fabs(omega - 40.0) < 2.0 && fabs(measured - omega) < 1.0,
+            "sensorless, encoder frozen: rotor %.2f rad/s, speed loop sees "
+            "%.2f rad/s",
+            omega, measured);
+  return Sim_TestResult();
+}
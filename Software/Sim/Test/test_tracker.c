@@ -0,0 +1,158 @@
+/* AS5047P 锁相环跟踪器：SPI 上接 14 位量化的理想编码器，
+ * 1. 匀速时角度无静差（一阶低通对比），速度噪声不超过量化噪声经环路的放大；
+ * 2. 匀加速时预测误差为 a / ki（加速度估计 ki * err 等于 a），
+ *    修正后的角度滞后为 (1 - kp * Ts) * a / ki */
+#include "as5047.h"
+#include "sim_periph.h"
+#include "sim_test.h"
+#include <math.h>
+
+#define TEST_TS 5e-5          // 读取周期（s），与电流环相同
+#define TEST_BANDWIDTH 1000.0 // 跟踪带宽（rad/s）
+#define TEST_LSB (2.0 * M_PI / 16384.0)
+#define TEST_SETTLE 4000 // 丢弃的起始采样数，约 200 / bandwidth
+#define TEST_N 40000
+
+/* 理想编码器：读数为真实角度向下取整的 14 位码值 */
+typedef struct {
+  double angle; // 真实角度（rad，多圈）
+} Test_Encoder;
+
+static uint16_t EncoderTransfer(void *device, uint16_t mosi) {
+  (void)mosi;
+  Test_Encoder *encoder = (Test_Encoder *)device;
+  double turn = encoder->angle / (2.0 * M_PI);
+  turn -= floor(turn);
+  return (uint16_t)(turn * 16384.0) & 0x3FFFU;
+}
+
+static Test_Encoder encoder;
+static SPI_HandleTypeDef hspi;
+
+/**
+ * @brief 跟踪值与真实角度之差，回绕到 [-PI, PI)
+ */
+static double AngleError(float tracked, double truth) {
+  double err = fmod(tracked - truth + M_PI, 2.0 * M_PI);
+  if (err < 0.0)
+    err += 2.0 * M_PI;
+  return err - M_PI;
+}
+
+static AS5047P_Instance *NewEncoder(float lowpass_alpha, double bandwidth) {
+  Sim_PeriphReset();
+  hspi.Instance = SPI1;
+  hspi.Init.DataSize = SPI_DATASIZE_16BIT;
+  Sim_SPI_Attach(SPI1, GPIOA, GPIO_PIN_15, EncoderTransfer, &encoder);
+  AS5047P_Instance *as5047p =
+      AS5047P_Register(&hspi, GPIOA, GPIO_PIN_15, lowpass_alpha);
+  if (as5047p != NULL && bandwidth > 0.0)
+    AS5047P_SetTracker(as5047p, (float)bandwidth, (float)TEST_TS);
+  return as5047p;
+}
+
+/**
+ * @brief 独立按跟踪器的差分方程求速度对测量噪声的冲激响应 h：
+ *        量化误差按方差 LSB^2 / 12 的白噪声，速度噪声均方根为 LSB / √12 * ‖h‖2；
+ *        量化误差在 [0, LSB) 内，速度误差峰值不超过 LSB * ‖h‖1
+ */
+static double SpeedNoiseBound(double *peak) {
+  double kp = 2.0 * TEST_BANDWIDTH, ki = TEST_BANDWIDTH * TEST_BANDWIDTH;
+  double angle = 0.0, speed = 0.0, sum = 0.0, l1 = 0.0;
+  for (uint32_t k = 0; k < 100000; k++) {
+    double measure = (k == 0) ? 1.0 : 0.0;
+    double predict = angle + speed * TEST_TS;
+    double err = measure - predict;
+    speed += ki * err * TEST_TS;
+    angle = predict + kp * TEST_TS * err;
+    sum += speed * speed;
+    l1 += fabs(speed);
+  }
+  *peak = TEST_LSB * l1;
+  return TEST_LSB / sqrt(12.0) * sqrt(sum);
+}
+
+/**
+ * @brief 匀速：比较跟踪器与一阶低通的角度静差，统计速度噪声
+ */
+static void ConstantSpeed(double omega) {
+  AS5047P_Instance *tracker = NewEncoder(0.15f, TEST_BANDWIDTH);
+  AS5047P_Instance *lowpass = NewEncoder(0.15f, 0.0);
+  if (tracker == NULL || lowpass == NULL) {
+    Sim_Check(0, "as5047p register");
+    return;
+  }
+
+  /* 码值为向下取整，测量的平均值比真实角度小半个 LSB */
+  double lag = 0.0, lag_lp = 0.0, speed_sq = 0.0, speed_peak = 0.0;
+  encoder.angle = 0.3;
+  for (uint32_t k = 0; k < TEST_SETTLE + TEST_N; k++) {
+    float a = AS5047P_ReadAngle(tracker);
+    float b = AS5047P_ReadAngle(lowpass);
+    if (k >= TEST_SETTLE) {
+      double truth = encoder.angle - 0.5 * TEST_LSB;
+      lag += AngleError(a, truth) / TEST_N;
+      lag_lp += AngleError(b, truth) / TEST_N;
+      double e = AS5047P_GetSpeed(tracker) - omega;
+      speed_sq += e * e / TEST_N;
+      speed_peak = fmax(speed_peak, fabs(e));
+    }
+    encoder.angle += omega * TEST_TS;
+  }
+
+  double peak;
+  double rms = SpeedNoiseBound(&peak);
+  Sim_Check(fabs(lag) < 0.05 * TEST_LSB,
+            "%5.1f rad/s: tracker lag %+.3f LSB (lowpass %+.1f LSB)", omega,
+            lag / TEST_LSB, lag_lp / TEST_LSB);
+  /* 低速时量化误差随角度缓慢变化，并非白噪声，均方根留 1.5 倍余量；峰值为硬上界 */
+  Sim_Check(sqrt(speed_sq) < 1.5 * rms && speed_peak <= peak,
+            "%5.1f rad/s: speed noise rms %.3f rad/s (white %.3f), "
+            "peak %.3f rad/s (bound %.3f)",
+            omega, sqrt(speed_sq), rms, speed_peak, peak);
+}
+
+/**
+ * @brief 匀加速：加速度估计 ki * err 为 a，即预测误差为 a / ki；
+ *        修正后的角度滞后为 (1 - kp * Ts) * a / ki
+ */
+static void Ramp(double accel) {
+  AS5047P_Instance *tracker = NewEncoder(0.15f, TEST_BANDWIDTH);
+  if (tracker == NULL) {
+    Sim_Check(0, "as5047p register");
+    return;
+  }
+
+  double omega = 0.0, lag = 0.0, est = 0.0;
+  encoder.angle = 1.0;
+  for (uint32_t k = 0; k < TEST_SETTLE + TEST_N; k++) {
+    float a = AS5047P_ReadAngle(tracker);
+    if (k >= TEST_SETTLE) {
+      lag += AngleError(a, encoder.angle - 0.5 * TEST_LSB) / TEST_N;
+      est += AS5047P_GetAccel(tracker) / TEST_N;
+    }
+    encoder.angle += omega * TEST_TS + 0.5 * accel * TEST_TS * TEST_TS;
+    omega += accel * TEST_TS;
+  }
+
+  double ki = TEST_BANDWIDTH * TEST_BANDWIDTH;
+  double innovation = est / ki;
+  double expect = -(1.0 - 2.0 * TEST_BANDWIDTH * TEST_TS) * accel / ki;
+  Sim_Check(fabs(est - accel) < 0.01 * fabs(accel),
+            "%5.0f rad/s^2: accel estimate %.1f rad/s^2, prediction error "
+            "%+.3f LSB = a / ki %+.3f LSB",
+            accel, est, innovation / TEST_LSB, accel / ki / TEST_LSB);
+  Sim_Check(fabs(lag - expect) < 0.01 * fabs(expect) + 0.05 * TEST_LSB,
+            "%5.0f rad/s^2: lag %+.3f LSB, (1 - kp Ts) a / ki %+.3f LSB "
+            "(end speed %.0f rad/s)",
+            accel, lag / TEST_LSB, expect / TEST_LSB, omega);
+}
+
+int main(void) {
+  ConstantSpeed(31.7);
+  ConstantSpeed(-7.3);
+  ConstantSpeed(250.3);
+  Ramp(500.0);
+  Ramp(-2000.0);
+  return Sim_TestResult();
+}
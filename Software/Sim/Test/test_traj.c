@@ -0,0 +1,147 @@
+/* 轨迹规划：梯形、S 形曲线的速度、加速度、加加速度限制，到达时间与解析值对比，
+ * 运动中修改目标后重新规划 */
+#include "sim_test.h"
+#include "traj.h"
+#include <math.h>
+#include <stddef.h>
+
+#define TEST_TS 1e-3f // 更新周期（s），与仿真台位置环相同
+#define TEST_VEL 30.0f
+#define TEST_ACC 300.0f
+#define TEST_JERK 10000.0f
+#define TEST_TOL 1e-3f // 限制的相对裕量，覆盖 float 舍入
+
+typedef struct {
+  float vel, acc, jerk; // 各量绝对值的最大值
+  float overshoot;      // 沿运动方向越过目标的最大距离（rad）
+  float time;           // 到达目标所用时间（s），未到达为 INFINITY
+} Traj_Result;
+
+/**
+ * @brief 从当前状态向 target 推进，最多 steps 个周期或到达为止
+ */
+static void Run(Traj_Instance *traj, float target, uint32_t steps,
+                Traj_Result *result) {
+  float sign = (target >= traj->pos) ? 1.0f : -1.0f;
+  float acc_last = traj->acc;
+  result->vel = result->acc = result->jerk = 0.0f;
+  result->overshoot = 0.0f;
+  result->time = INFINITY;
+  Traj_SetTarget(traj, target);
+  for (uint32_t k = 1; k <= steps; k++) {
+    Traj_Update(traj);
+    result->vel = fmaxf(result->vel, fabsf(traj->vel));
+    result->acc = fmaxf(result->acc, fabsf(traj->acc));
+    result->jerk = fmaxf(result->jerk, fabsf(traj->acc - acc_last) / TEST_TS);
+    result->overshoot = fmaxf(result->overshoot, sign * (traj->pos - target));
+    acc_last = traj->acc;
+    if (traj->done) {
+      result->time = k * TEST_TS;
+      return;
+    }
+  }
+}
+
+/**
+ * @brief 速度、加速度限制和越过量检查；S 形曲线另查加加速度
+ */
+static void CheckLimits(const char *name, Traj_Instance *traj,
+                        Traj_Result *result) {
+  uint8_t scurve = traj->profile == TRAJ_SCURVE;
+  Sim_Check(result->vel <= TEST_VEL * (1.0f + TEST_TOL) &&
+                result->acc <= TEST_ACC * (1.0f + TEST_TOL) &&
+                (!scurve || result->jerk <= TEST_JERK * (1.0f + TEST_TOL)),
+            "%-22s max vel %.3f, acc %.2f, jerk %.0f", name, result->vel,
+            result->acc, scurve ? result->jerk : 0.0f);
+  Sim_Check(result->overshoot < 1e-4f && traj->done &&
+                traj->vel == 0.0f,
+            "%-22s overshoot %.2e rad, stopped at target", name,
+            result->overshoot);
+}
+
+/**
+ * @brief 单次运动：限制检查，到达时间与解析值之差不超过 2 个周期
+ */
+static void Move(Traj_Instance *traj, const char *name, float distance,
+                 double expect) {
+  Traj_Reset(traj, 0.0f, 0.0f);
+  Traj_Result result;
+  Run(traj, distance, 10000, &result);
+  CheckLimits(name, traj, &result);
+  Sim_Check(fabs(result.time - expect) <= 2.0 * TEST_TS,
+            "%-22s time %.4f s, analytic %.4f s", name, result.time, expect);
+}
+
+/**
+ * @brief 单向运动的解析时间：梯形曲线为 d / v + v / a，速度达不到上限时为 2√(d / a)；
+ *        S 形曲线先求加速段（含加加速度段）的时间和位移，不足时缩减
+ */
+static double Analytic(Traj_Profile profile, double d) {
+  double v = TEST_VEL, a = TEST_ACC, j = TEST_JERK;
+  if (profile == TRAJ_TRAPEZOID) {
+    if (d >= v * v / a)
+      return d / v + v / a;
+    return 2.0 * sqrt(d / a);
+  }
+  /* 加速段达到 vel_max 时，加速度达到 acc_max */
+  double t_acc = v / a + a / j;
+  if (d >= v * t_acc)
+    return d / v + t_acc;
+  /* 速度达不到上限、加速度能达到上限：加速段位移 d / 2，按 v_peak 求解 */
+  double lo = 0.0, hi = v;
+  for (int i = 0; i < 60; i++) {
+    double vp = 0.5 * (lo + hi);
+    double ta = (vp >= a * a / j) ? vp / a + a / j : 2.0 * sqrt(vp / j);
+    if (vp * ta > d)
+      hi = vp;
+    else
+      lo = vp;
+  }
+  double vp = lo;
+  double ta = (vp >= a * a / j) ? vp / a + a / j : 2.0 * sqrt(vp / j);
+  return 2.0 * ta;
+}
+
+int main(void) {
+  Traj_Init_Config_s config = {
+    .profile = TRAJ_TRAPEZOID,
+    .Ts = TEST_TS,
+    .vel_max = TEST_VEL,
+    .acc_max = TEST_ACC,
+    .jerk_max = TEST_JERK,
+  };
+  Traj_Instance *trap = Traj_Register(&config);
+  config.profile = TRAJ_SCURVE;
+  Traj_Instance *scurve = Traj_Register(&config);
+  if (trap == NULL || scurve == NULL) {
+    Sim_Check(0, "traj register");
+    return Sim_TestResult();
+  }
+
+  Move(trap, "trapezoid 10 rad", 10.0f, Analytic(TRAJ_TRAPEZOID, 10.0));
+  Move(trap, "trapezoid 1 rad", 1.0f, Analytic(TRAJ_TRAPEZOID, 1.0));
+  Move(trap, "trapezoid -6 rad", -6.0f, Analytic(TRAJ_TRAPEZOID, 6.0));
+  Move(scurve, "s-curve 10 rad", 10.0f, Analytic(TRAJ_SCURVE, 10.0));
+  Move(scurve, "s-curve 1 rad", 1.0f, Analytic(TRAJ_SCURVE, 1.0));
+  Move(scurve, "s-curve -6 rad", -6.0f, Analytic(TRAJ_SCURVE, 6.0));
+
+  /* 匀速段中把目标改到身后：减速、反向，回到新目标 */
+  Traj_Instance *traj[] = {trap, scurve};
+  const char *reverse[] = {"trapezoid reverse", "s-curve reverse"};
+  const char *extend[] = {"trapezoid extend", "s-curve extend"};
+  for (uint8_t i = 0; i < 2; i++) {
+    Traj_Result result;
+    Traj_Reset(traj[i], 0.0f, 0.0f);
+    Run(traj[i], 10.0f, 200, &result);
+    Run(traj[i], 2.0f, 10000, &result);
+    CheckLimits(reverse[i], traj[i], &result);
+
+    /* 减速段中把目标延后：不停顿，重新加速 */
+    Traj_Reset(traj[i], 0.0f, 0.0f);
+    Run(traj[i], 5.0f, 220, &result);
+    Traj_Result tail;
+    Run(traj[i], 12.0f, 10000, &tail);
+    CheckLimits(extend[i], traj[i], &tail);
+  }
+  return Sim_TestResult();
+}
@@ -0,0 +1,88 @@
+/* 母线电压前馈：母线纹波下有无 Vbus 实测时的电流纹波，以及跌落时的欠压判断 */
+#include "sim_rig.h"
+#include "sim_test.h"
+#include <math.h>
+
+#define TEST_IQ 1.0f      // Iq 目标（A）
+#define TEST_SPEED 30.0   // 测功机转速（rad/s，机械角速度），反电势约 2.5 V
+#define TEST_RIPPLE 2.0   // 纹波幅值（V）
+#define TEST_N 8000       // 统计的 PWM 周期数（0.4 s）
+
+/**
+ * @brief 测功机拖动、电流模式给定 Iq，返回 Iq 的均方根纹波
+ * @param vbus_sense 1：使用 ADC2 实测母线电压；0：固定 powerVol
+ */
+static double IqRipple(uint8_t vbus_sense, double freq) {
+  Sim_Rig_Init_Config_s config;
+  Sim_RigDefaults(&config);
+  config.vbus_sense = vbus_sense;
+  config.motor.current_noise = 0.0;
+  config.motor.cogging = 0.0;
+  config.motor.vbus_ripple = TEST_RIPPLE;
+  config.motor.vbus_ripple_freq = freq;
+  Sim_Rig rig;
+  if (!Sim_RigInit(&rig, &config) || !Sim_RigStart(&rig, 1.2f))
+    return INFINITY;
+
+  rig.plant.locked = 1;
+  rig.plant.omega = TEST_SPEED;
+  rig.iq_ref = TEST_IQ;
+  Sim_RigRun(&rig, 2000);
+
+  double sum = 0.0, sq = 0.0;
+  for (uint32_t k = 0; k < TEST_N; k++) {
+    Sim_RigPeriod(&rig);
+    sum += rig.plant.iq;
+    sq += rig.plant.iq * rig.plant.iq;
+  }
+  double mean = sum / TEST_N;
+  return sqrt(fmax(sq / TEST_N - mean * mean, 0.0));
+}
+
+/**
+ * @brief 母线电压跌落到欠压阈值以下时状态为 FOC_VBUS_UNDER，恢复后回到正常
+ */
+static void TestUndervoltage(void) {
+  Sim_Rig_Init_Config_s config;
+  Sim_RigDefaults(&config);
+  Sim_Rig rig;
+  if (!Sim_RigInit(&rig, &config) || !Sim_RigStart(&rig, 1.2f)) {
+    Sim_Check(0, "rig start");
+    return;
+  }
+  rig.plant.locked = 1;
+  rig.plant.config.vbus_sag = 7.0;
+  rig.plant.config.vbus_sag_start = rig.plant.time + 0.01;
+  rig.plant.config.vbus_sag_time = 0.02;
+
+  uint8_t under = 0;
+  for (uint32_t k = 0; k < 1000; k++) {
+    Sim_RigPeriod(&rig);
+    under |= (rig.foc->vbus.status == FOC_VBUS_UNDER);
+  }
+  Sim_Check(under, "12 V -> 5 V sag: undervoltage flagged");
+  Sim_Check(rig.foc->vbus.status == FOC_VBUS_NORMAL,
+            "after the sag: status normal, powerVol %.2f V",
+            rig.foc->param.powerVol);
+}
+
+int main(void) {
+  /* 纹波须在 Vbus 低通（alpha 0.05，约 160 Hz）通带内才能被前馈抵消，
+   * 100 Hz 时滤波器相位滞后已使抑制比接近 0.5，只作记录 */
+  const double freq[] = {50.0, 100.0};
+  for (uint8_t i = 0; i < 2; i++) {
+    double off = IqRipple(0, freq[i]);
+    double on = IqRipple(1, freq[i]);
+    if (i == 0)
+      Sim_Check(on < 0.5 * off,
+                "%.0f Hz %.0f V ripple: iq rms ripple %.2f mA fixed Vbus, "
+                "%.2f mA sensed (ratio %.2f)",
+                freq[i], TEST_RIPPLE, off * 1e3, on * 1e3, on / off);
+    else
+      Sim_Note("%.0f Hz %.0f V ripple: iq rms ripple %.2f mA fixed Vbus, "
+               "%.2f mA sensed (ratio %.2f)",
+               freq[i], TEST_RIPPLE, off * 1e3, on * 1e3, on / off);
+  }
+  TestUndervoltage();
+  return Sim_TestResult();
+}